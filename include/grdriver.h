@@ -149,6 +149,10 @@ typedef void     (*_GR_blitFunc)(GrFrame *dst,int dx,int dy,
                  int w,int h,GrColor op);
 typedef GrColor *(*_GR_getScanline)(GrFrame *c,int x,int y,int w);
 typedef void     (*_GR_putScanline)(int x,int y,int w,const GrColor *scl,GrColor op);
+typedef void     (*_GR_stretchFunc)(GrFrame *dst,int dx,int dy,int w,int h,
+                 GrFrame *src,const int *xsrc,const int *ysrc,GrColor op);
+typedef void     (*_GR_coverageFunc)(int x,int y,int w,int h,
+                 const unsigned char *cov,int pitch,GrColor fg,GrColor bg);
 
 /*
  * Frame driver utility functions
@@ -168,6 +172,11 @@ GrColor *_GrFrDrvGenericGetIndexedScanline(GrFrame *c,int x,int y,int w,int *ind
 
 void _GrFrDrvGenericStretchBlt(GrFrame *dst,int dx,int dy,int dw,int dh,
                                GrFrame *src,int sx,int sy,int sw,int sh,GrColor op);
+void _GrFrDrvGenericStretchMap(int *map,int dn,int s,int sn);
+void _GrFrDrvGenericStretchBltMap(GrFrame *dst,int dx,int dy,int w,int h,
+                                  GrFrame *src,const int *xsrc,const int *ysrc,GrColor op);
+void _GrFrDrvGenericDrawCoverage(int x,int y,int w,int h,const unsigned char *cov,
+                                 int pitch,GrColor fg,GrColor bg);
 
 /*
  * Video driver utility functions
@@ -196,6 +205,9 @@ int  _GrViDrvVESAvirtualScroll(GrVideoMode *md,int x,int y,int result[2]);
 */
 void _GrViDrvSetDACshift(int shift);
 
+/* hardware cursors: cursor image as ARGB32, transparent pixels alpha 0 */
+int  _GrViDrvCursorARGB(GrCursor *cursor,unsigned int *argb,int w,int h);
+
 /*
  * Commonly used video driver data structures
  */
@@ -43,6 +43,9 @@ typedef struct _GR_fontDriver {
     int  (*charwdt)(int chr);
     int  (*bitmap)(int chr,int w,int h,char *buffer);
     void (*cleanup)(void);
+    int  (*coverage)(int chr,int w,int h,unsigned char *buffer); /* or NULL */
+    GrFont *(*mapfont)(void);           /* font without conversion or NULL */
+    int  (*strokes)(int chr,GrFontStroke *buffer); /* vectors or NULL */
 } GrFontDriver;
 
 extern GrFontDriver
@@ -56,7 +59,9 @@ _GrFontDriverXWIN,                      /* X font driver */
 #endif
 _GrFontDriverRAW,                       /* RAW data/linux PSF font driver */
 _GrFontDriverFNA,                       /* ASCII font driver */
+_GrFontDriverMFN,                       /* MGRX mappable font driver */
 _GrFontDriverWIN,                       /* MS Windows font resource driver */
+_GrFontDriverBDF,                       /* X11 BDF ascii font driver */
 /*
  * This is a NULL-terminated table of font driver descriptor pointers. Users
  * can provide their own table with only the desired (or additional) drivers.
@@ -87,6 +92,37 @@ GrFont *_GrBuildFont(
     int  (*bitmap)(int chr,int w,int h,char *buffer),
     int  canscale
 );
+int _GrBuildFontCoverage(
+    GrFont *f,
+    int  (*coverage)(int chr,int w,int h,unsigned char *buffer)
+);
+GrStrokeFont *_GrBuildStrokeFont(
+    const GrFontHeader *hdr,
+    int  (*charwdt)(int chr),
+    int  (*strokes)(int chr,GrFontStroke *buffer)
+);
+void _GrFontFree(GrFont *f);
+
+/*
+ * two level char to glyph map of sparse fonts
+ */
+int  _GrFontUseGlyphMap(unsigned int numchars,unsigned int nglyphs);
+int  _GrFontNewGlyphMap(GrFont *f);
+int  _GrFontSetGlyph(GrFont *f,unsigned int idx,unsigned int glyph);
+void _GrFontFreeGlyphMap(GrFont *f);
+
+/*
+ * loaded fonts cache and font dirs index
+ */
+GrFont *_GrFontCacheFind(const char *name,const char *path,
+                         int cvt,int w,int h,int minc,int maxc);
+void _GrFontCacheAdd(GrFont *f,const char *name,const char *path,
+                     int cvt,int w,int h,int minc,int maxc);
+int  _GrFontCacheRelease(GrFont *f);
+void _GrFontCacheDetach(GrFont *f);
+void _GrFontCacheNewPath(void);
+int  _GrFontDirMayHave(const char *dir,const char *fname);
+int  _GrFontUnmap(GrFont *f);
 
 #endif /* USE_GRX_INTERNAL_DEFINITIONS */
 
@@ -99,6 +99,7 @@ typedef struct _GR_videoMode    GrVideoMode;
 typedef struct _GR_videoModeExt GrVideoModeExt;
 typedef struct _GR_frame        GrFrame;
 typedef struct _GR_context      GrContext;
+struct _GR_cursor;
 
 /* ================================================================== */
 /*                        SYSTEM TYPE DEF's                           */
@@ -252,6 +253,8 @@ struct _GR_videoDriver {
         int   (*genexpose)(int);            /* generate GREV_EXPOSE events */
         int   (*genwmend)(int);             /* generate GREV_WMEND events */
         int   (*genframe)(int);             /* generate GREV_FRAME events */
+        int   (*setcursor)(struct _GR_cursor *); /* set hardware cursor (NULL hides it) */
+        void  (*movecursor)(int,int);       /* move hardware cursor hot point */
 };
 /* bits in the drvflags field: */
 #define GR_DRIVERF_USER_RESOLUTION 1
@@ -322,6 +325,8 @@ struct _GR_frameDriver {
     void     (*bltr2v)(GrFrame *dst,int dx,int dy,GrFrame *src,int x,int y,int w,int h,GrColor op);
     GrColor *(*getscanline)(GrFrame *c,int x, int y, int w);
     void     (*putscanline)(int x, int y, int w,const GrColor *scl, GrColor op);
+    void     (*stretchblt)(GrFrame *dst,int dx,int dy,int w,int h,GrFrame *src,const int *xsrc,const int *ysrc,GrColor op);
+    void     (*drawcoverage)(int x,int y,int w,int h,const unsigned char *cov,int pitch,GrColor fg,GrColor bg);
 };
 
 /*
@@ -742,6 +747,9 @@ typedef GrColor *GrColorTableP;
 #define GR_ARC_STYLE_OPEN       0
 #define GR_ARC_STYLE_CLOSE1     1
 #define GR_ARC_STYLE_CLOSE2     2
+#define GR_STRETCH_NEAREST      0       /* GrStretchBltFilter filters */
+#define GR_STRETCH_BILINEAR     1
+#define GR_STRETCH_AREA         2
 
 typedef struct {                        /* framed box colors */
         GrColor fbx_intcolor;
@@ -785,6 +793,7 @@ void GrFloodSpill2(int x1, int y1, int x2, int y2, GrColor old_c1, GrColor new_c
 void GrFloodSpillC(GrContext *ctx, int x1, int y1, int x2, int y2, GrColor old_c, GrColor new_c);
 void GrFloodSpillC2(GrContext *ctx, int x1, int y1, int x2, int y2, GrColor old_c1, GrColor new_c1, GrColor old_c2, GrColor new_c2);
 void GrStretchBlt(GrContext *dst,int dx1,int dy1,int dx2,int dy2,GrContext *src,int x1,int y1,int x2,int y2,GrColor oper);
+void GrStretchBltFilter(GrContext *dst,int dx1,int dy1,int dx2,int dy2,GrContext *src,int x1,int y1,int x2,int y2,GrColor oper,int filter);
 
 GrColor GrPixel(int x,int y);
 GrColor GrPixelC(GrContext *c,int x,int y);
@@ -876,6 +885,7 @@ GrColor GrPixelCNC(GrContext *c,int x,int y);
 #define GR_UCS2_TEXT            7   /* 2 bpc restricted Unicode, only BMP range */
 #define GR_CP1251_TEXT          8   /* 1 bpc standard Cyrillic Win encoding */
 #define GR_CP1253_TEXT          9   /* 1 bpc standard Greek Win encoding */
+#define GR_UCS4_TEXT           10   /* 4 bpc full Unicode */
 
 /*
  * OR this to the foreground color value for underlined text
@@ -892,6 +902,7 @@ GrColor GrPixelCNC(GrContext *c,int x,int y);
 #define GR_FONTCVT_BOLDIFY      8       /* make a "bold"(er) font  */
 #define GR_FONTCVT_FIXIFY       16      /* convert prop. font to fixed wdt */
 #define GR_FONTCVT_PROPORTION   32      /* convert fixed font to prop. wdt */
+#define GR_FONTCVT_ANTIALIAS    64      /* anti-aliased (only scalable fonts) */
 
 /*
  * Font encoding, to recode from user encoding to display
@@ -949,6 +960,9 @@ typedef struct _GR_font {               /* the complete font */
         unsigned int  auxsize;              /* allocated size of auxiliary map */
         unsigned int  auxnext;              /* next free byte in auxiliary map */
         unsigned int  *auxoffs[7];          /* offsets to completed aux chars */
+        unsigned char *covmap;              /* 8 bit coverage glyphs or NULL */
+        unsigned int  numglyphs;            /* chrinfo entries if glyphmap */
+        unsigned int  **glyphmap;           /* two level char -> glyph map or NULL */
         struct   _GR_fontChrInfo chrinfo[1]; /* character info (not act. size) */
 } GrFont;
 
@@ -973,14 +987,26 @@ GrFont *GrBuildConvertedFont(const GrFont *from,int cvt,int w,int h,int minch,in
 GrFont *GrLoadFontFile(char *name, char *driver);
 
 void GrUnloadFont(GrFont *font);
+void GrFlushFontCache(void);
 int GrDumpFont(const GrFont *font,char *CsymbolName,char *fileName);
 int GrDumpFnaFont(const GrFont *font,char *fileName);
 int GrDumpGrxFont(const GrFont *font,char *fileName);
+int GrDumpMfnFont(const GrFont *font,char *fileName);
+
+/*
+ * Anti-aliased fonts have a 8 bit coverage map (0 to 255 per pixel) for
+ * every glyph, besides the normal bitmap. The coverage map of a glyph
+ * has the font height rows of (width + 7) & ~7 bytes, so its offset is
+ * the bitmap offset * 8. GrBuildCoverageFont makes an anti-aliased font
+ * from a font scale times bigger (averaging scale x scale pixels)
+ */
+GrFont *GrBuildCoverageFont(const GrFont *from,int scale);
 
 /*
  * In these functions chr is a font glyph index, not a real char
  * recode it before use if you want to work with real chars
  */
+int  GrFontCharGlyph(const GrFont *font,unsigned int chr);
 int  GrFontCharPresent(const GrFont *font,unsigned int chr);
 int  GrFontCharWidth(const GrFont *font,unsigned int chr);
 int  GrFontCharHeight(const GrFont *font,unsigned int chr);
@@ -990,6 +1016,7 @@ int  GrFontCharBitmapSize(const GrFont *font,unsigned int chr);
 char *GrBuildAuxiliaryBitmap(GrFont *font,unsigned int chr,int dir,int ul);
 char *GrFontCharBitmap(const GrFont *font,unsigned int chr);
 char *GrFontCharAuxBmp(GrFont *font,unsigned int chr,int dir,int ul);
+unsigned char *GrFontCharCoverage(const GrFont *font,unsigned int chr);
 
 typedef struct _GR_textOption {      /* text drawing option structure */
         struct _GR_font *txo_font;   /* font to be used */
@@ -1031,15 +1058,103 @@ void GrDrawChar(long chr,int x,int y,const GrTextOption *opt);
 void GrDrawString(void *text,int length,int x,int y,const GrTextOption *opt);
 void GrTextXY(int x,int y,char *text,GrColor fg,GrColor bg);
 
+/*
+ * Draw many strings with one call (tables, grids, terminals)
+ */
+typedef struct _GR_textItem {
+        const void *text;            /* string */
+        int     length;              /* chars, 0 if zero terminated */
+        int     x, y;                /* position */
+        const GrTextOption *opt;     /* NULL to use the common one */
+} GrTextItem;
+
+void GrDrawStrings(const GrTextItem *items,int nitems,const GrTextOption *opt);
+
+/*
+ * Text at any angle (tenths of degree counterclockwise, rounded to whole
+ * degrees, added to the opt direction) around the aligned point
+ */
+void GrDrawRotatedString(const void *text,int length,int x,int y,int angle,
+                         const GrTextOption *opt);
+
+/*
+ * Text runs: a string recoded, measured and broken in lines once, to be
+ * drawn many times. Fonts have no kerning, pairs can be given.
+ */
+typedef struct _GR_kernPair {
+        unsigned int left, right;    /* chars in the font encoding */
+        int     adjust;              /* added to the left char advance */
+} GrKernPair;
+
+typedef struct _GR_textLine {
+        int     first;               /* index of the first char */
+        int     length;              /* number of chars */
+        int     width;               /* in pixels */
+} GrTextLine;
+
+typedef struct _GR_textRun {
+        GrTextOption opt;            /* drawing options (font not owned) */
+        int     nchars;              /* number of chars */
+        unsigned int *chars;         /* chars in the font encoding */
+        int     *advance;            /* char advances, kerning included */
+        int     kerned;              /* some advance isn't the char width */
+        int     nlines;              /* number of lines */
+        GrTextLine *lines;           /* the lines */
+        int     width, height;       /* size of the run */
+} GrTextRun;
+
+GrTextRun *GrCreateTextRun(const void *text,int length,const GrTextOption *opt,
+                           int maxwidth,const GrKernPair *kern,int nkern);
+void GrDestroyTextRun(GrTextRun *run);
+void GrDrawTextRun(const GrTextRun *run,int x,int y);
+
+/*
+ * Stroke fonts (BGI .chr) drawn as lines at any size and angle, without
+ * building bitmaps. Sizes in the font header are in font units.
+ */
+typedef struct _GR_fontStroke {      /* a stroke font vector */
+        short   x, y;                /* end point, from the cell top left */
+        short   draw;                /* line to the point, else move to it */
+} GrFontStroke;
+
+typedef struct _GR_strokeFont {      /* the complete stroke font */
+        struct _GR_fontHeader h;     /* the font info structure */
+        GrFontStroke *strokes;       /* vectors of all the characters */
+        struct _GR_fontChrInfo chrinfo[1]; /* width and first vector, */
+                                     /* numchars + 1 entries (not act. size) */
+} GrStrokeFont;
+
+typedef struct _GR_strokeTextOption { /* stroke text drawing options */
+        GrStrokeFont *sto_font;      /* font to be used */
+        int     sto_height;          /* height of the font cell in pixels */
+        int     sto_angle;           /* counterclockwise, in tenths of degree */
+        GrColor sto_color;           /* line color */
+        char    sto_chrtype;         /* character type (see above) */
+        char    sto_xalign;          /* X alignment (see above) */
+        char    sto_yalign;          /* Y alignment (see above) */
+} GrStrokeTextOption;
+
+GrStrokeFont *GrLoadStrokeFont(char *name);
+void GrUnloadStrokeFont(GrStrokeFont *font);
+int  GrStrokeStringWidth(const void *text,int length,const GrStrokeTextOption *opt);
+void GrDrawStrokeString(const void *text,int length,int x,int y,const GrStrokeTextOption *opt);
+
 #ifndef GRX_SKIP_INLINES
+#define GrFontCharGlyph(f,ch) (                                                \
+        (((unsigned int)(ch) - (f)->h.minchar) >= (f)->h.numchars) ? -1 : (    \
+        ((f)->glyphmap == NULL) ? (int)((unsigned int)(ch) - (f)->h.minchar) : \
+        ((f)->glyphmap[((unsigned int)(ch) - (f)->h.minchar) >> 8] == NULL) ?  \
+        -1 :                                                                   \
+        (int)(f)->glyphmap[((unsigned int)(ch) - (f)->h.minchar) >> 8]         \
+                          [((unsigned int)(ch) - (f)->h.minchar) & 0xff] - 1 ) \
+)
 #define GrFontCharPresent(f,ch) (                                              \
-        ((unsigned int)(ch) < (f)->h.minchar) ? 0 : (                          \
-        (((unsigned int)(ch) - (f)->h.minchar) >= (f)->h.numchars) ? 0 :       \
-        (f->chrinfo[(unsigned int)(ch) - (f)->h.minchar].width > 0) )          \
+        (GrFontCharGlyph(f,ch) < 0) ? 0 :                                      \
+        ((f)->chrinfo[GrFontCharGlyph(f,ch)].width > 0)                        \
 )
 #define GrFontCharWidth(f,ch) (                                                \
         GrFontCharPresent(f,ch) ?                                              \
-        (int)(f)->chrinfo[(unsigned int)(ch) - (f)->h.minchar].width :         \
+        (int)(f)->chrinfo[GrFontCharGlyph(f,ch)].width :                       \
         (f)->h.width                                                           \
 )
 #define GrFontCharHeight(f,ch) (                                               \
@@ -1047,7 +1162,7 @@ void GrTextXY(int x,int y,char *text,GrColor fg,GrColor bg);
 )
 #define GrFontCharBmpRowSize(f,ch) (                                           \
         GrFontCharPresent(f,ch) ?                                              \
-        (((f)->chrinfo[(unsigned int)(ch) - (f)->h.minchar].width + 7) >> 3) : \
+        (((f)->chrinfo[GrFontCharGlyph(f,ch)].width + 7) >> 3) :               \
         0                                                                      \
 )
 #define GrFontCharBitmapSize(f,ch) (                                           \
@@ -1055,7 +1170,7 @@ void GrTextXY(int x,int y,char *text,GrColor fg,GrColor bg);
 )
 #define GrFontCharBitmap(f,ch) (                                               \
         GrFontCharPresent(f,ch) ?                                              \
-        &(f)->bitmap[(f)->chrinfo[(unsigned int)(ch) - (f)->h.minchar].offset]:\
+        &(f)->bitmap[(f)->chrinfo[GrFontCharGlyph(f,ch)].offset] :             \
         (char *)0                                                              \
 )
 #define GrFontCharAuxBmp(f,ch,dir,ul) (                                        \
@@ -1063,6 +1178,12 @@ void GrTextXY(int x,int y,char *text,GrColor fg,GrColor bg);
         GrFontCharBitmap(f,ch) :                                               \
         GrBuildAuxiliaryBitmap((f),(ch),(dir),(ul))                            \
 )
+#define GrFontCharCoverage(f,ch) (                                             \
+        ((f)->covmap && GrFontCharPresent(f,ch)) ?                             \
+        &(f)->covmap[                                                          \
+          (f)->chrinfo[GrFontCharGlyph(f,ch)].offset << 3] :                   \
+        (unsigned char *)0                                                     \
+)
 #endif /* GRX_SKIP_INLINES */
 
 /* ================================================================== */
@@ -1410,6 +1531,16 @@ int GrQueryPnm( char *pnmfn, int *width, int *height, int *maxval );
 int GrLoadContextFromPnmBuffer( GrContext *grc, const char *buffer );
 int GrQueryPnmBuffer( const char *buffer, int *width, int *height, int *maxval );
 
+/* ================================================================== */
+/*                           QOI FUNCTIONS                            */
+/* ================================================================== */
+
+int GrSaveContextToQoi( GrContext *grc, char *qoifn );
+int GrLoadContextFromQoi( GrContext *grc, char *qoifn, int use_alpha );
+int GrQueryQoi( char *qoifn, int *width, int *height );
+int GrLoadContextFromQoiBuffer( GrContext *grc, const char *qoibuf, int use_alpha );
+int GrQueryQoiBuffer( const char *qoibuf, int *width, int *height );
+
 /* ================================================================== */
 /*                           PNG FUNCTIONS                            */
 /*  these functions may not be installed or available on all system   */
@@ -1431,6 +1562,20 @@ int GrQueryJpeg( char *jpegfn, int *width, int *height );
 int GrSaveContextToJpeg( GrContext *grc, char *jpegfn, int quality );
 int GrSaveContextToGrayJpeg( GrContext *grc, char *jpegfn, int quality );
 
+/* ================================================================== */
+/*                 DITHERING AND PALETTES FOR IMAGES                  */
+/* ================================================================== */
+
+#define GR_DITHER_NONE      0       /* nearest color */
+#define GR_DITHER_ORDERED   1       /* 8x8 Bayer matrix */
+#define GR_DITHER_FLOYD     2       /* Floyd-Steinberg error diffusion */
+#define GR_DITHER_METHOD    0x0f    /* mask for the methods */
+#define GR_DITHER_OPTPAL    0x10    /* flag, build an optimal palette */
+
+void GrSetImageDither( int mode );
+int  GrGetImageDither( void );
+int  GrAllocOptimalPalette( const unsigned char *rgb, long npixels, int ncolors );
+
 /* ================================================================== */
 /*               MISCELLANEOUS UTILITIY FUNCTIONS                     */
 /* ================================================================== */
@@ -1440,6 +1585,33 @@ int  GrMatchString(const char *pattern,const char *strg);
 void GrSetWindowTitle(char *title);
 void GrSleep(int msec);
 long GrMsecTime( void );
+long long GrUsecTime( void );
+long long GrNsecTime( void );
+
+/* frame timing statistics */
+
+#define GR_FRAMESTATS_WINDOW    120     /* default frames in the window */
+#define GR_FRAMESTATS_MAXWINDOW 1024
+
+typedef struct {
+    int  nframes;           /* frames in the window */
+    long totframes;         /* frames since the last reset */
+    long drawmin;           /* draw time, usec */
+    long drawavg;
+    long drawp99;
+    long drawmax;
+    long presmin;           /* present time, usec */
+    long presavg;
+    long presp99;
+    long presmax;
+} GrFrameStats;
+
+int  GrFrameStatsSetWindow(int nframes);
+void GrFrameStatsReset(void);
+void GrFrameBegin(void);
+void GrFramePresent(void);
+void GrFrameEnd(void);
+void GrFrameGetStats(GrFrameStats *st);
 
 /* ================================================================== */
 /*                               EVENTS                               */
@@ -1468,11 +1640,18 @@ typedef struct {
 #define GREV_WSZCHG  7           /* window size changed (gen only if activated, X11, W32, Wyl) */
 #define GREV_CBREPLY 8           /* clipboard reply, p1=1 if ready to paste, p1=0 no data in clipboard */
 #define GREV_FRAME   9           /* ready for a new frame to be drawn (gen only if requested, Wyl) */
-#define GREV_CLOCK   10          /* clock eventframe to be drawn (gen only if requested) */
+#define GREV_CLOCK   10          /* clock tick, every msec set by GrEventGenClock (gen only if requested) */
+#define GREV_FDREADY 11          /* fd added by GrEventAddFd is ready, p1=fd, p2=GR_FD_ flags, p3=userdata */
+#define GREV_TIMER   12          /* timer added by GrEventAddTimer expired, p1=timer id, p2=userdata */
+#define GREV_REPLAYEND 13        /* event replay ended, p1=events replayed */
 #define GREV_USER    100         /* user event */
 
 #define GRKEY_KEYCODE     100    /* p1 is a special key, not a char */
 
+#define GR_FD_READ          1    /* fd ready to read */
+#define GR_FD_WRITE         2    /* fd ready to write */
+#define GR_FD_ERROR         4    /* error or hang up, always reported */
+
 #define GRMOUSE_LB_PRESSED  1    /* Left button pressed */
 #define GRMOUSE_MB_PRESSED  2    /* Middle button pressed */
 #define GRMOUSE_RB_PRESSED  3    /* Right button pressed */
@@ -1500,6 +1679,10 @@ typedef struct {
 #define GR_GEN_MMOVE_IFBUT  1    /* Gen GREV_MMOVE if a button is pressed */
 #define GR_GEN_MMOVE_ALWAYS 2    /* Gen GREV_MMOVE always */
 
+#define GR_COALESCE_NO      0    /* Doesn't coalesce events (default) */
+#define GR_COALESCE_MMOVE   1    /* Coalesce consecutive GREV_MMOVE */
+#define GR_COALESCE_EXPOSE  2    /* Coalesce overlapping GREV_EXPOSE */
+
 #define GR_GEN_NO           0    /* Doesn't generate the event */
 #define GR_GEN_YES          1    /* Gennerates the event */
 
@@ -1530,11 +1713,36 @@ int GrEventEnqueue(GrEvent * ev);
 int GrEventParEnqueue(int type, long p1, long p2, long p3, long p4);
 int GrEventEnqueueFirst(GrEvent * ev);
 int GrEventParEnqueueFirst(int type, long p1, long p2, long p3, long p4);
+int GrEventPostFromThread(GrEvent * ev);
+int GrEventSetQueueSize(int maxsize);
+long GrEventQueueOverflows(void);
+int GrEventCoalesce(int flags);
+
+#define GR_REPLAY_REALTIME  0    /* replay with the recorded timing */
+#define GR_REPLAY_FAST      1    /* replay as fast as the program reads */
+
+typedef struct {
+    long nevents;           /* events replayed */
+    long recmsec;           /* recorded time */
+    long msec;              /* replay time */
+    long evmsec;            /* time used by the program to process the events */
+    long maxevmsec;         /* max time used to process an event */
+} GrReplayStats;
+
+int GrEventStartRecord(char *filename);
+void GrEventStopRecord(void);
+int GrEventStartReplay(char *filename, int mode);
+void GrEventStopReplay(void);
+void GrEventReplayStats(GrReplayStats *st);
 void GrEventGenMmove(int when);
 int GrEventGenExpose(int gen);
 int GrEventGenWMEnd(int gen);
 int GrEventGenFrame(int gen);
 int GrEventGenClock(int gen, int msec);
+int GrEventAddFd(int fd, int events, long userdata);
+int GrEventRemoveFd(int fd);
+int GrEventAddTimer(long msec, int periodic, long userdata);
+int GrEventRemoveTimer(int id);
 int GrEventAddHook(int (*fn) (GrEvent *));
 int GrEventDeleteHook(int (*fn) (GrEvent *));
 
@@ -1643,6 +1851,7 @@ extern const struct _GR_mouseInfo {
         int     spmult,spdiv;                       /* mouse cursor speed factors */
         int     thresh,accel;                       /* mouse acceleration parameters */
         int     moved;                              /* mouse cursor movement flag */
+        int     hwcursor;                           /* cursor drawn by the video hardware */
 } * const GrMouseInfo;
 
 int  GrMouseDetect(void);
@@ -1660,9 +1869,12 @@ void GrMouseDisplayCursor(void);
 void GrMouseEraseCursor(void);
 void GrMouseUpdateCursor(void);
 int  GrMouseCursorIsDisplayed(void);
+int  GrMouseUseHwCursor(int use);
 
 int  GrMouseBlock(GrContext *c,int x1,int y1,int x2,int y2);
 void GrMouseUnBlock(int return_value_from_GrMouseBlock);
+void GrMouseBeginBatch(GrContext *c,int x1,int y1,int x2,int y2);
+void GrMouseEndBatch(void);
 
 #ifndef GRX_SKIP_INLINES
 #define GrMouseGetCursor()          (GrMouseInfo->cursor)
@@ -14,26 +14,24 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, stretch directly to the clipped destination, a
+ **                   temporary context is used only if areas overlap
+ **
  **/
 
+#include <stdlib.h>
+
 #include "libgrx.h"
 #include "grdriver.h"
 #include "clipping.h"
 
-void GrStretchBlt(GrContext *dst,int dx1,int dy1,int dx2,int dy2,
-                  GrContext *src,int x1,int y1,int x2,int y2,GrColor oper)
+/* source and destination areas share memory, stretch to a temporary context */
+
+static void stretchtmp(GrContext *dst,int dx1,int dy1,int dx2,int dy2,
+                       GrContext *src,int x1,int y1,int x2,int y2,GrColor oper)
 {
     GrContext *gcaux;
 
-    if(dst == NULL) dst = CURC;
-    if(src == NULL) src = CURC;
-
-    isort(x1,x2);
-    isort(y1,y2);
-    cxclip_ordbox(src,x1,y1,x2,y2);
-    isort(dx1,dx2);
-    isort(dy1,dy2);
-
     gcaux = GrCreateContext(dx2-dx1+1, dy2-dy1+1, NULL, NULL);
     if (gcaux == NULL) return;
 
@@ -47,3 +45,55 @@ void GrStretchBlt(GrContext *dst,int dx1,int dy1,int dx2,int dy2,
     GrBitBlt(dst, dx1, dy1, gcaux, 0, 0, dx2-dx1, dy2-dy1, oper);
     GrDestroyContext(gcaux);
 }
+
+void GrStretchBlt(GrContext *dst,int dx1,int dy1,int dx2,int dy2,
+                  GrContext *src,int x1,int y1,int x2,int y2,GrColor oper)
+{
+    int vx1, vy1, vx2, vy2;
+
+    if(dst == NULL) dst = CURC;
+    if(src == NULL) src = CURC;
+
+    isort(x1,x2);
+    isort(y1,y2);
+    cxclip_ordbox(src,x1,y1,x2,y2);
+    isort(dx1,dx2);
+    isort(dy1,dy2);
+
+    /* only the visible part of the destination is stretched */
+    vx1 = dx1; vy1 = dy1; vx2 = dx2; vy2 = dy2;
+    clip_ordbox(dst,vx1,vy1,vx2,vy2);
+
+    if (src->gc_baseaddr[0] == dst->gc_baseaddr[0] &&
+        x1 + src->gc_xoffset <= vx2 + dst->gc_xoffset &&
+        x2 + src->gc_xoffset >= vx1 + dst->gc_xoffset &&
+        y1 + src->gc_yoffset <= vy2 + dst->gc_yoffset &&
+        y2 + src->gc_yoffset >= vy1 + dst->gc_yoffset) {
+        stretchtmp(dst,dx1,dy1,dx2,dy2,src,x1,y1,x2,y2,oper);
+        return;
+    }
+
+    {
+        int *xsrc, *ysrc;
+
+        /* the maps can be big for a large zoom, not on the stack */
+        xsrc = malloc(sizeof(int) * (dx2-dx1+1));
+        ysrc = malloc(sizeof(int) * (dy2-dy1+1));
+        if (xsrc == NULL || ysrc == NULL) {
+            free(xsrc);
+            free(ysrc);
+            return;
+        }
+        _GrFrDrvGenericStretchMap(xsrc, dx2-dx1+1, x1+src->gc_xoffset, x2-x1+1);
+        _GrFrDrvGenericStretchMap(ysrc, dy2-dy1+1, y1+src->gc_yoffset, y2-y1+1);
+        mouse_block(src,x1,y1,x2,y2);
+        mouse_addblock(dst,vx1,vy1,vx2,vy2);
+        _GrFrDrvGenericStretchBltMap(
+            &dst->gc_frame, vx1+dst->gc_xoffset, vy1+dst->gc_yoffset,
+            vx2-vx1+1, vy2-vy1+1,
+            &src->gc_frame, &xsrc[vx1-dx1], &ysrc[vy1-dy1], oper);
+        mouse_unblock();
+        free(xsrc);
+        free(ysrc);
+    }
+}
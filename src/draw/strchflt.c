@@ -0,0 +1,302 @@
+/**
+ ** strchflt.c ---- filtered strech blit
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The resampling is separable: every source row needed is filtered
+ ** horizontally once and kept in a small row cache, then the output
+ ** rows are built combining the cached rows. Both filters use the same
+ ** code, only the weight tables differ (2 taps for bilinear, a box of
+ ** ceil(ratio)+1 taps for area average). Channels are kept in separate
+ ** arrays and weights are fixed point, so the inner loops are simple
+ ** enough for the compiler to vectorize them.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "libgrx.h"
+#include "clipping.h"
+#include "pixrow.h"
+
+#define WBITS   14              /* weights are 1.14 fixed point */
+#define WONE    (1 << WBITS)
+#define HBITS   6               /* horizontal pass output is 8.8 */
+
+typedef struct {
+    int *first;                 /* first source index for every output index */
+    int *count;                 /* number of taps */
+    int *wpos;                  /* position of the first weight in w */
+    int *w;                     /* weights, every set adds WONE */
+    int maxcount;
+} weighttable;
+
+static void freeweights(weighttable *wt)
+{
+    free(wt->first);
+    free(wt->count);
+    free(wt->wpos);
+    free(wt->w);
+}
+
+/*
+ * builds the weights for output indexes o1..o2 of a dn long output
+ * mapped to a sn long input, returns -1 on memory error
+ */
+static int buildweights(weighttable *wt, int filter, int sn, int dn, int o1, int o2)
+{
+    int n = o2 - o1 + 1;
+    int maxcount, i, j, k, sum, big;
+    double scale = (double)sn / (double)dn;
+    double f, a, b, cover;
+
+    if (filter == GR_STRETCH_AREA)
+        maxcount = (int)ceil(scale) + 1;
+    else
+        maxcount = 2;
+    wt->maxcount = maxcount;
+    wt->first = malloc(sizeof(int) * n);
+    wt->count = malloc(sizeof(int) * n);
+    wt->wpos = malloc(sizeof(int) * n);
+    wt->w = malloc(sizeof(int) * n * maxcount);
+    if (!wt->first || !wt->count || !wt->wpos || !wt->w) return -1;
+
+    for (i=0,k=0; i<n; i++) {
+        wt->wpos[i] = k;
+        if (filter == GR_STRETCH_AREA) {
+            a = (o1 + i) * scale;
+            b = (o1 + i + 1) * scale;
+            wt->first[i] = (int)floor(a);
+            wt->count[i] = (int)ceil(b) - wt->first[i];
+            if (wt->first[i] + wt->count[i] > sn)
+                wt->count[i] = sn - wt->first[i];
+            for (j=0; j<wt->count[i]; j++) {
+                cover = ((b < wt->first[i]+j+1) ? b : wt->first[i]+j+1) -
+                        ((a > wt->first[i]+j) ? a : wt->first[i]+j);
+                wt->w[k+j] = (int)(cover / (b - a) * WONE + 0.5);
+            }
+        }
+        else {
+            f = (o1 + i + 0.5) * scale - 0.5;
+            if (f < 0) f = 0;
+            wt->first[i] = (int)f;
+            if (wt->first[i] >= sn - 1) {
+                wt->first[i] = sn - 1;
+                wt->count[i] = 1;
+                wt->w[k] = WONE;
+            }
+            else {
+                wt->count[i] = 2;
+                wt->w[k+1] = (int)((f - wt->first[i]) * WONE + 0.5);
+                wt->w[k] = WONE - wt->w[k+1];
+            }
+        }
+        /* rounding must not change the total */
+        for (j=0,sum=0,big=0; j<wt->count[i]; j++) {
+            sum += wt->w[k+j];
+            if (wt->w[k+j] > wt->w[k+big]) big = j;
+        }
+        wt->w[k+big] += WONE - sum;
+        k += wt->count[i];
+    }
+    return 0;
+}
+
+/* reads source row sy (columns sx..sx+sw-1) and unpacks it */
+static void readrow(GrContext *src, int sx, int sy, int sw, GrColor *c,
+                    unsigned char *r, unsigned char *g, unsigned char *b)
+{
+    int bpp = _GrPixRowBytes(src);
+    const GrColor *scl;
+    int i;
+
+    if (bpp > 0)
+        _GrPixRowGet(_GrPixRowAddr(src, bpp, sx, sy), bpp, _GrPixRowShift(src), c, sw);
+    else {
+        scl = GrGetScanlineC(src, sx, sx+sw-1, sy);
+        if (scl == NULL) {
+            /* unreadable row, filter it as black */
+            memset(r, 0, sw);
+            memset(g, 0, sw);
+            memset(b, 0, sw);
+            return;
+        }
+        memcpy(c, scl, sizeof(GrColor) * sw);
+    }
+    for (i=0; i<sw; i++) {
+        r[i] = GrRGBcolorRed(c[i]);
+        g[i] = GrRGBcolorGreen(c[i]);
+        b[i] = GrRGBcolorBlue(c[i]);
+    }
+}
+
+/* horizontal pass, from unpacked source row to 8.8 channel rows */
+static void hfilter(const weighttable *wt, int n, int sx0,
+                    const unsigned char *r, const unsigned char *g,
+                    const unsigned char *b, unsigned int *hr,
+                    unsigned int *hg, unsigned int *hb)
+{
+    unsigned int ar, ag, ab;
+    const int *w;
+    int i, j, s;
+
+    for (i=0; i<n; i++) {
+        w = &wt->w[wt->wpos[i]];
+        s = wt->first[i] - sx0;
+        ar = ag = ab = 0;
+        for (j=0; j<wt->count[i]; j++) {
+            ar += r[s+j] * w[j];
+            ag += g[s+j] * w[j];
+            ab += b[s+j] * w[j];
+        }
+        hr[i] = ar >> HBITS;
+        hg[i] = ag >> HBITS;
+        hb[i] = ab >> HBITS;
+    }
+}
+
+/*
+** GrStretchBltFilter - like GrStretchBlt, but the source is resampled
+** with the selected filter:
+**
+**   GR_STRETCH_NEAREST:  nearest neighbour, same as GrStretchBlt
+**   GR_STRETCH_BILINEAR: bilinear interpolation, best for upscaling
+**   GR_STRETCH_AREA:     area average, best for downscaling
+**
+** Filters need RGB mode, in palette modes nearest neighbour is used
+*/
+
+void GrStretchBltFilter(GrContext *dst,int dx1,int dy1,int dx2,int dy2,
+                        GrContext *src,int x1,int y1,int x2,int y2,
+                        GrColor oper,int filter)
+{
+    weighttable wx, wy;
+    GrContext *gcaux = NULL;
+    GrContext grcaux;
+    GrColor lr[256], lg[256], lb[256];
+    GrColor *scolors = NULL, *dcolors = NULL;
+    unsigned char *ur = NULL, *ug, *ub;
+    unsigned int *cache = NULL, *acc, *hr;
+    int *cachey = NULL;
+    int vx1, vy1, vx2, vy2, vw, sw, sh, dw, dh;
+    int sx0, sxw, ncache, x, y, i, j, sy, slot;
+    unsigned int ar, ag, ab;
+    const int *w;
+
+    if(dst == NULL) dst = CURC;
+    if(src == NULL) src = CURC;
+
+    if (filter == GR_STRETCH_NEAREST || !CLRINFO->RGBmode) {
+        GrStretchBlt(dst,dx1,dy1,dx2,dy2,src,x1,y1,x2,y2,oper);
+        return;
+    }
+
+    isort(x1,x2);
+    isort(y1,y2);
+    cxclip_ordbox(src,x1,y1,x2,y2);
+    isort(dx1,dx2);
+    isort(dy1,dy2);
+
+    /* only the visible part of the destination is calculated */
+    vx1 = dx1; vy1 = dy1; vx2 = dx2; vy2 = dy2;
+    clip_ordbox(dst,vx1,vy1,vx2,vy2);
+
+    sw = x2 - x1 + 1;
+    sh = y2 - y1 + 1;
+    dw = dx2 - dx1 + 1;
+    dh = dy2 - dy1 + 1;
+    vw = vx2 - vx1 + 1;
+
+    /* source and destination overlap, work from a copy */
+    if (src->gc_baseaddr[0] == dst->gc_baseaddr[0] &&
+        x1 + src->gc_xoffset <= vx2 + dst->gc_xoffset &&
+        x2 + src->gc_xoffset >= vx1 + dst->gc_xoffset &&
+        y1 + src->gc_yoffset <= vy2 + dst->gc_yoffset &&
+        y2 + src->gc_yoffset >= vy1 + dst->gc_yoffset) {
+        gcaux = GrCreateFrameContext(src->gc_onscreen ? src->gc_driver->rmode :
+                                     src->gc_driver->mode, sw, sh, NULL, NULL);
+        if (gcaux == NULL) return;
+        GrBitBlt(gcaux, 0, 0, src, x1, y1, x2, y2, GrWRITE);
+        src = gcaux;
+        x1 = y1 = 0;
+    }
+
+    memset(&wx, 0, sizeof(wx));
+    memset(&wy, 0, sizeof(wy));
+    if (buildweights(&wx, filter, sw, dw, vx1-dx1, vx2-dx1) != 0) goto done;
+    if (buildweights(&wy, filter, sh, dh, vy1-dy1, vy2-dy1) != 0) goto done;
+
+    /* source columns needed by the visible part */
+    sx0 = wx.first[0];
+    sxw = wx.first[vw-1] + wx.count[vw-1] - sx0;
+
+    /* a slot per tap plus one, so consecutive rows don't evict each other */
+    ncache = wy.maxcount + 1;
+    scolors = malloc(sizeof(GrColor) * sxw);
+    dcolors = malloc(sizeof(GrColor) * vw);
+    ur = malloc(3 * sxw);
+    cache = malloc(sizeof(unsigned int) * 3 * vw * (ncache + 1));
+    cachey = malloc(sizeof(int) * ncache);
+    if (!scolors || !dcolors || !ur || !cache || !cachey) goto done;
+    ug = ur + sxw;
+    ub = ug + sxw;
+    acc = &cache[3 * vw * ncache];
+    for (i=0; i<ncache; i++) cachey[i] = -1;
+
+    _GrPixRowRGBTables(lr, lg, lb, NULL);
+    GrSaveContext(&grcaux);
+    GrSetContext(dst);
+
+    for (y=0; y<vy2-vy1+1; y++) {
+        /* fill the cache */
+        for (j=0; j<wy.count[y]; j++) {
+            sy = wy.first[y] + j;
+            slot = sy % ncache;
+            if (cachey[slot] != sy) {
+                readrow(src, x1+sx0, y1+sy, sxw, scolors, ur, ug, ub);
+                hr = &cache[3 * vw * slot];
+                hfilter(&wx, vw, sx0, ur, ug, ub, hr, hr+vw, hr+2*vw);
+                cachey[slot] = sy;
+            }
+        }
+        /* vertical pass, 8.8 * 1.14 -> 8 */
+        w = &wy.w[wy.wpos[y]];
+        for (x=0; x<3*vw; x++) acc[x] = 1 << (8 + WBITS - 1);
+        for (j=0; j<wy.count[y]; j++) {
+            hr = &cache[3 * vw * ((wy.first[y] + j) % ncache)];
+            for (x=0; x<3*vw; x++) acc[x] += hr[x] * w[j];
+        }
+        for (x=0; x<vw; x++) {
+            ar = acc[x] >> (8 + WBITS);
+            ag = acc[vw+x] >> (8 + WBITS);
+            ab = acc[2*vw+x] >> (8 + WBITS);
+            dcolors[x] = lr[ar > 255 ? 255 : ar] | lg[ag > 255 ? 255 : ag] |
+                         lb[ab > 255 ? 255 : ab];
+        }
+        GrPutScanline(vx1, vx2, vy1+y, dcolors, oper);
+    }
+
+    GrSetContext(&grcaux);
+
+done:
+    freeweights(&wx);
+    freeweights(&wy);
+    free(scolors);
+    free(dcolors);
+    free(ur);
+    free(cache);
+    free(cachey);
+    if (gcaux != NULL) GrDestroyContext(gcaux);
+}
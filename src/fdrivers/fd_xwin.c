@@ -566,6 +566,7 @@ static int init(GrVideoMode *mp)
         CLRINFO->nfree--;
       }
     }
+    _GrColorCacheInvalidate();
   }
   PIXEL_CACHE_INVALIDATE();
   return(TRUE);
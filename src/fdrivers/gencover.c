@@ -0,0 +1,58 @@
+/**
+ ** gencover.c ---- generic, VERY SLOW anti-aliased glyph drawing routine
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#include "libgrx.h"
+#include "grdriver.h"
+
+/* cov[i=0..h-1][j=0..w-1] (row i at cov + i*pitch) is the fg coverage   */
+/* of pixel x+j,y+i from 0 to 255, the rest is bg or the old pixel if    */
+/* bg is GrNOCOLOR. Only for RGB modes, colors are written (no GrXOR...) */
+
+void _GrFrDrvGenericDrawCoverage(int x,int y,int w,int h,const unsigned char *cov,
+                                 int pitch,GrColor fg,GrColor bg)
+{
+  int fr, fgr, fb, i, j, a;
+  GrColor c;
+  GRX_ENTER();
+  fg &= GrCVALUEMASK;
+  fr  = GrRGBcolorRed(fg);
+  fgr = GrRGBcolorGreen(fg);
+  fb  = GrRGBcolorBlue(fg);
+  for (i = 0; i < h; i++, cov += pitch) {
+    for (j = 0; j < w; j++) {
+      a = cov[j];
+      if (a == 255) {
+        (*FDRV->drawpixel)(x+j,y+i,fg);
+        continue;
+      }
+      if (a == 0) {
+        if (bg != GrNOCOLOR) (*FDRV->drawpixel)(x+j,y+i,bg);
+        continue;
+      }
+      if (bg != GrNOCOLOR) c = bg & GrCVALUEMASK;
+      else c = (*FDRV->readpixel)(&CURC->gc_frame,x+j,y+i);
+      a += a >> 7;
+      c = GrBuildRGBcolorR(
+            (fr  * a + GrRGBcolorRed(c)   * (256 - a)) >> 8,
+            (fgr * a + GrRGBcolorGreen(c) * (256 - a)) >> 8,
+            (fb  * a + GrRGBcolorBlue(c)  * (256 - a)) >> 8);
+      (*FDRV->drawpixel)(x+j,y+i,c);
+    }
+  }
+  GRX_LEAVE();
+}
@@ -0,0 +1,70 @@
+/**
+ ** generic/coverage.c ---- anti-aliased glyph drawing for 32bpp frames
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Included by the 32bpp linear frame drivers (not for FAR_ACCESS).
+ ** Needs FOFS, PIX2COL and COL2PIX. Red and blue are blended together
+ ** in a 32 bit word and green apart (two multiplies per pixel), fully
+ ** covered and empty pixels don't need any blending and they are checked
+ ** four at a time.
+ **/
+
+void drawcoverage(int x,int y,int w,int h,const unsigned char *cov,int pitch,
+                  GrColor fg,GrColor bg)
+{
+    GR_int32u *dptr, fpix, bpix, frb, fg8, c, a;
+    int opaque, i, j;
+
+    GRX_ENTER();
+    opaque = (bg != GrNOCOLOR);
+    fg &= GrCVALUEMASK;
+    bg &= GrCVALUEMASK;
+    fpix = COL2PIX(fg);
+    bpix = COL2PIX(bg);
+    frb = fg & 0xff00ff;
+    fg8 = fg & 0x00ff00;
+    for (i=0; i<h; i++, cov+=pitch) {
+        dptr = (GR_int32u *)&CURC->gc_baseaddr[0][FOFS(x,y+i,CURC->gc_lineoffset)];
+        for (j=0; j<w; j++) {
+            if (j + 4 <= w) {
+                memcpy(&a, &cov[j], 4);
+                if (a == 0) {
+                    if (opaque) dptr[j] = dptr[j+1] = dptr[j+2] = dptr[j+3] = bpix;
+                    j += 3;
+                    continue;
+                }
+                if (a == 0xffffffffU) {
+                    dptr[j] = dptr[j+1] = dptr[j+2] = dptr[j+3] = fpix;
+                    j += 3;
+                    continue;
+                }
+            }
+            a = cov[j];
+            if (a == 255)
+                dptr[j] = fpix;
+            else if (a == 0) {
+                if (opaque) dptr[j] = bpix;
+            }
+            else {
+                c = opaque ? bg : PIX2COL(dptr[j]);
+                a += a >> 7;    /* 0..256 */
+                c = (((frb * a + (c & 0xff00ff) * (256 - a)) >> 8) & 0xff00ff) |
+                    (((fg8 * a + (c & 0x00ff00) * (256 - a)) >> 8) & 0x00ff00);
+                dptr[j] = COL2PIX(c);
+            }
+        }
+    }
+    GRX_LEAVE();
+}
@@ -0,0 +1,119 @@
+/**
+ ** generic/strchblt.c ---- stretch blit for linear packed pixel frames
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Included by the linear frame drivers (not for FAR_ACCESS). Needs
+ ** FOFS and STRCH_PIXEL defined as the pixel type (GR_int8u, GR_int16u
+ ** or GR_int32u), if STRCH_PIXEL is not defined pixels are copied as
+ ** three bytes (24bpp). COL2PIX is used if defined.
+ **
+ ** xsrc[0..w-1] and ysrc[0..h-1] are the source frame coordinates for
+ ** every destination column and row. Source and destination must not
+ ** overlap.
+ **/
+
+void stretchblt(GrFrame *dst, int dx, int dy, int w, int h,
+                GrFrame *src, const int *xsrc, const int *ysrc, GrColor op)
+{
+#ifdef STRCH_PIXEL
+    STRCH_PIXEL *sptr, *dptr, *dprev = NULL, skipc, c;
+#else
+    GR_int8u *sptr, *dptr, *dprev = NULL, *sp, skipc[3];
+    GrColor sc;
+#endif
+    int op2, i, j;
+
+    GRX_ENTER();
+    op2 = C_OPER(op);
+#ifdef STRCH_PIXEL
+#ifdef COL2PIX
+    skipc = COL2PIX(op & GrCVALUEMASK);
+#else
+    skipc = op & GrCVALUEMASK;
+#endif
+#else
+    sc = op & GrCVALUEMASK;
+#if BYTE_ORDER==LITTLE_ENDIAN
+    skipc[0] = sc; skipc[1] = sc >> 8; skipc[2] = sc >> 16;
+#else
+    skipc[0] = sc >> 16; skipc[1] = sc >> 8; skipc[2] = sc;
+#endif
+#endif
+
+    for (i=0; i<h; i++) {
+#ifdef STRCH_PIXEL
+        dptr = (STRCH_PIXEL *)&dst->gf_baseaddr[0][FOFS(dx,dy+i,dst->gf_lineoffset)];
+        if (op2 == C_WRITE && dprev != NULL && ysrc[i] == ysrc[i-1]) {
+            /* same source row, copy the last one */
+            memcpy((void *)dptr, (void *)dprev, sizeof(STRCH_PIXEL)*w);
+            dprev = dptr;
+            continue;
+        }
+        sptr = (STRCH_PIXEL *)&src->gf_baseaddr[0][FOFS(0,ysrc[i],src->gf_lineoffset)];
+        switch(op2) {
+            case C_XOR:
+                for (j=0; j<w; j++) dptr[j] ^= sptr[xsrc[j]];
+                break;
+            case C_OR:
+                for (j=0; j<w; j++) dptr[j] |= sptr[xsrc[j]];
+                break;
+            case C_AND:
+                for (j=0; j<w; j++) dptr[j] &= sptr[xsrc[j]];
+                break;
+            case C_IMAGE:
+                for (j=0; j<w; j++) {
+                    c = sptr[xsrc[j]];
+                    if (c != skipc) dptr[j] = c;
+                }
+                break;
+            default:
+                for (j=0; j<w; j++) dptr[j] = sptr[xsrc[j]];
+                break;
+        }
+#else
+        dptr = (GR_int8u *)&dst->gf_baseaddr[0][FOFS(dx,dy+i,dst->gf_lineoffset)];
+        if (op2 == C_WRITE && dprev != NULL && ysrc[i] == ysrc[i-1]) {
+            memcpy((void *)dptr, (void *)dprev, 3*w);
+            dprev = dptr;
+            continue;
+        }
+        sptr = (GR_int8u *)&src->gf_baseaddr[0][FOFS(0,ysrc[i],src->gf_lineoffset)];
+        for (j=0; j<w; j++, dptr+=3) {
+            sp = sptr + 3*xsrc[j];
+            switch(op2) {
+                case C_XOR:
+                    dptr[0] ^= sp[0]; dptr[1] ^= sp[1]; dptr[2] ^= sp[2];
+                    break;
+                case C_OR:
+                    dptr[0] |= sp[0]; dptr[1] |= sp[1]; dptr[2] |= sp[2];
+                    break;
+                case C_AND:
+                    dptr[0] &= sp[0]; dptr[1] &= sp[1]; dptr[2] &= sp[2];
+                    break;
+                case C_IMAGE:
+                    if (sp[0] == skipc[0] && sp[1] == skipc[1] && sp[2] == skipc[2])
+                        break;
+                    /* fall through */
+                default:
+                    dptr[0] = sp[0]; dptr[1] = sp[1]; dptr[2] = sp[2];
+                    break;
+            }
+        }
+        dptr -= 3*w;
+#endif
+        dprev = dptr;
+    }
+    GRX_LEAVE();
+}
@@ -13,8 +13,14 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, the stretch is done using source coordinate maps, so
+ **                   it can be clipped, and frame drivers can provide a
+ **                   native stretchblt. Fixed source x offset added twice.
+ **
  **/
 
+#include <stdlib.h>
+
 #include "libgrx.h"
 #include "grdriver.h"
 #include "arith.h"
@@ -55,47 +61,59 @@ static INLINE int XLineInit(_GR_lineData *ld, int x,int y,int dx,int dy)
 
 #define XLineCheckDone(ldp) ((ldp)->cnt <= 0)
 
-/* ---------------------------------------------------- x- and y-dir stretch */
-static void stretch(GrFrame *dst,int dx,int dy,int dw, int dh,
-                    GrFrame *src,int sx,int sy,int sw, int sh,
-                    GrColor op)
+/* ------------------------------------------------- source coordinate maps */
+
+/* map[i=0..dn-1] = source coordinate (s..s+sn-1) for destination i */
+
+void _GrFrDrvGenericStretchMap(int *map,int dn,int s,int sn)
 {
+    _GR_lineData lne;
     int maxi;
-    int xsrc[dw];
 
     GRX_ENTER();
-    do {
-        GrFrame csave;
-        GrColor *pixels = NULL;
-        _GR_lineData lne;
-        _GR_putScanline        putscl = dst->gf_driver->putscanline;
-        int rd_y = -1;
-        /* set up xsrc[0..dw-1] = (line 0,sx to dw-1,sx+sw-1).y */
-        if(!XLineInit(&lne,0,sx,dw,sw)) break;
-        DBGPRINTF(DBG_DRIVER,("dw=%d, sw=%d\n",dw,sw));
-        maxi = sx+sw-1;
+    if (XLineInit(&lne,0,s,dn,sn)) {
+        maxi = s+sn-1;
         do {
             /* we need to check for upper bound here         */
             /* in rare cases the last element could overflow */
-            xsrc[lne.x] = min(lne.y,maxi);
-            DBGPRINTF(DBG_DRIVER,("xsrc[%d] = %d\n",lne.x,xsrc[lne.x]));
+            map[lne.x] = min(lne.y,maxi);
             XLineStep(&lne);
         } while (!XLineCheckDone(&lne));
-        
-        if(!XLineInit(&lne,dy,sy,dh,sh)) break;
-        maxi = sy+sh-1;
+    }
+    GRX_LEAVE();
+}
+
+/* ------------------------------------------------- stretch using the maps */
+
+/* dst pixel (dx+i,dy+j) = src pixel (xsrc[i],ysrc[j]), no overlap allowed */
+
+void _GrFrDrvGenericStretchBltMap(GrFrame *dst,int dx,int dy,int w,int h,
+                                  GrFrame *src,const int *xsrc,const int *ysrc,
+                                  GrColor op)
+{
+    _GR_stretchFunc strch = dst->gf_driver->stretchblt;
+    GRX_ENTER();
+    if (strch && src->gf_driver->stretchblt &&
+        (src->gf_driver == dst->gf_driver ||
+         src->gf_driver->mode == dst->gf_driver->rmode ||
+         src->gf_driver->rmode == dst->gf_driver->mode)) {
+        /* same pixel format, the driver can read the rows directly */
+        (*strch)(dst,dx,dy,w,h,src,xsrc,ysrc,op);
+    } else {
+        GrFrame csave;
+        GrColor *pixels = NULL;
+        _GR_putScanline putscl = dst->gf_driver->putscanline;
+        int i, rd_y = -1;
         sttcopy(&csave,&CURC->gc_frame);
         sttcopy(&CURC->gc_frame,dst);
-        do {
-            int y = min(lne.y,maxi);
-            if (!pixels || y != rd_y)
-                pixels = _GrFrDrvGenericGetIndexedScanline(src,sx,(rd_y=y),dw,xsrc);
+        for (i = 0; i < h; i++) {
+            if (!pixels || ysrc[i] != rd_y)
+                pixels = _GrFrDrvGenericGetIndexedScanline(src,0,(rd_y=ysrc[i]),w,(int *)xsrc);
             if (pixels)
-                putscl(dx,lne.x,dw,pixels,op);
-            XLineStep(&lne);
-        } while (!XLineCheckDone(&lne));
+                putscl(dx,dy+i,w,pixels,op);
+        }
         sttcopy(&CURC->gc_frame,&csave);
-    } while (0);
+    }
     GRX_LEAVE();
 }
 
@@ -130,10 +148,17 @@ void _GrFrDrvGenericStretchBlt(GrFrame *dst,int dx,int dy,int dw,int dh,
                     } while (!XLineCheckDone(&yline));
                 }
             }
-        } else
-            stretch(dst,dx,dy,dw,dh,
-                    src,sx,sy,sw,sh,
-                    op);
+        } else {
+            int *xsrc = malloc(sizeof(int) * dw);
+            int *ysrc = malloc(sizeof(int) * dh);
+            if (xsrc && ysrc) {
+                _GrFrDrvGenericStretchMap(xsrc,dw,sx,sw);
+                _GrFrDrvGenericStretchMap(ysrc,dh,sy,sh);
+                _GrFrDrvGenericStretchBltMap(dst,dx,dy,dw,dh,src,xsrc,ysrc,op);
+            }
+            free(xsrc);
+            free(ysrc);
+        }
     }
     GRX_LEAVE();
 }
@@ -21,6 +21,10 @@
 
 #include "fdrivers/driver16.h"
 
+#define STRCH_PIXEL GR_int16u
+static
+#include "fdrivers/generic/strchblt.c"
+
 GrFrameDriver _GrFrameDriverRAM16 = {
     GR_frameRAM16,              /* frame mode */
     GR_frameUndef,              /* compatible RAM frame mode */
@@ -42,7 +46,8 @@ GrFrameDriver _GrFrameDriverRAM16 = {
     NULL,
     NULL,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -73,7 +78,8 @@ GrFrameDriver _GrFrameDriverSVGA16_LFB = {
     bitblt,
     bitblt,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt
 };
 
 #endif
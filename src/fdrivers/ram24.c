@@ -23,6 +23,9 @@
 #undef FAR_ACCESS
 #include "fdrivers/driver24.h"
 
+static
+#include "fdrivers/generic/strchblt.c"
+
 GrFrameDriver _GrFrameDriverRAM24 = {
     GR_frameRAM24,              /* frame mode */
     GR_frameUndef,              /* compatible RAM frame mode */
@@ -44,7 +47,8 @@ GrFrameDriver _GrFrameDriverRAM24 = {
     NULL,
     NULL,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -75,6 +79,7 @@ GrFrameDriver _GrFrameDriverSVGA24_LFB = {
     bitblt,
     bitblt,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt
 };
 #endif /* defined(LFB_BY_NEAR_POINTER) */
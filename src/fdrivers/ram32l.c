@@ -24,6 +24,12 @@
 
 #include "fdrivers/driver32.h"
 
+#define STRCH_PIXEL GR_int32u
+static
+#include "fdrivers/generic/strchblt.c"
+static
+#include "fdrivers/generic/coverage.c"
+
 GrFrameDriver _GrFrameDriverRAM32L = {
     GR_frameRAM32L,             /* frame mode */
     GR_frameUndef,              /* compatible RAM frame mode */
@@ -45,7 +51,9 @@ GrFrameDriver _GrFrameDriverRAM32L = {
     NULL,
     NULL,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt,
+    drawcoverage
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -76,7 +84,9 @@ GrFrameDriver _GrFrameDriverSVGA32L_LFB = {
     bitblt,
     bitblt,
     _GrFrDrvGenericGetScanline,
-    _GrFrDrvGenericPutScanline
+    _GrFrDrvGenericPutScanline,
+    stretchblt,
+    drawcoverage
 };
 
 #endif
@@ -23,6 +23,10 @@
 
 #include "fdrivers/driver8.h"
 
+#define STRCH_PIXEL GR_int8u
+static
+#include "fdrivers/generic/strchblt.c"
+
 /* -------------------------------------------------------------------- */
 
 GrFrameDriver _GrFrameDriverRAM8 = {
@@ -46,7 +50,8 @@ GrFrameDriver _GrFrameDriverRAM8 = {
     NULL,
     NULL,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
 
 
@@ -79,7 +84,8 @@ GrFrameDriver _GrFrameDriverSVGA8_LFB = {
     bitblit,
     bitblit,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
 
 #endif
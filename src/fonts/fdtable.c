@@ -24,10 +24,12 @@ GrFontDriver *_GrFontDriverTable[] = {
     &_GrFontDriverXWIN,
 #endif
     &_GrFontDriverGRX,
+    &_GrFontDriverMFN,
     &_GrFontDriverBGI,
     &_GrFontDriverRAW,
     &_GrFontDriverFNA,
     &_GrFontDriverWIN,
+    &_GrFontDriverBDF,
     NULL
 };
 
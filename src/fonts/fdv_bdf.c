@@ -0,0 +1,382 @@
+/**
+ ** fdv_bdf.c -- driver for X11 BDF (bitmap distribution format) fonts
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The whole file is parsed when opened, the glyph bitmaps are kept
+ ** packed with their bounding box and placed in the font cell (ascent
+ ** plus descent high, DWIDTH wide) when they are requested. ISO10646
+ ** fonts are unicode encoded, glyphs without encoding are skipped.
+ **
+ **/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "grfontdv.h"
+#include "arith.h"
+
+#define BDF_MAXBBX  0x7fff                /* max glyph width and height */
+
+typedef struct {
+    long    code;                       /* char */
+    int     dwidth;                     /* advance width */
+    int     bbw, bbh, bbx, bby;         /* bounding box */
+    long    bits;                       /* offset in bitpool */
+} bdfglyph;
+
+static bdfglyph *glyphs = NULL;         /* sorted by code */
+static int nglyphs = 0;
+static unsigned char *bitpool = NULL;
+static char name[40], family[40];
+
+static struct {
+    int  ascent, descent;
+    int  fbbw, fbbh, fbbx, fbby;
+    int  ulpos, ulheight;
+    int  encoding;
+    int  proportional;
+    int  width;
+} fhdr;
+
+static void cleanup(void)
+{
+    GRX_ENTER();
+    if(glyphs != NULL) free(glyphs);
+    if(bitpool != NULL) free(bitpool);
+    glyphs = NULL;
+    bitpool = NULL;
+    nglyphs = 0;
+    GRX_LEAVE();
+}
+
+static int cmpglyph(const void *a, const void *b)
+{
+    const bdfglyph *ga = a, *gb = b;
+    if(ga->code != gb->code) return (ga->code < gb->code) ? -1 : 1;
+    /* same code, the first one in the file (bits grow in file order) */
+    return (ga->bits < gb->bits) ? -1 : (ga->bits > gb->bits);
+}
+
+/* the next line of the file in memory, NULL at the end */
+static char *nextline(char **pos)
+{
+    char *s = *pos, *e;
+
+    if(*s == '\0') return NULL;
+    e = strchr(s, '\n');
+    if(e != NULL) {
+        *pos = e + 1;
+        *e = '\0';
+        if(e > s && e[-1] == '\r') e[-1] = '\0';
+    }
+    else *pos = s + strlen(s);
+    while(isspace((unsigned char)*s)) s++;
+    return s;
+}
+
+static int keyword(const char *line, const char *key, char **value)
+{
+    int len = strlen(key);
+
+    if(strncmp(line, key, len) != 0) return FALSE;
+    if(line[len] != '\0' && !isspace((unsigned char)line[len])) return FALSE;
+    for(line += len; isspace((unsigned char)*line); line++);
+    *value = (char *)line;
+    return TRUE;
+}
+
+/* a property string value without the quotes */
+static void strvalue(char *dst, const char *value, int size)
+{
+    int i = 0;
+
+    if(*value == '"') value++;
+    while(*value != '\0' && *value != '"' && i < size - 1) dst[i++] = *value++;
+    dst[i] = '\0';
+}
+
+static int hexdigit(int c)
+{
+    if(c >= '0' && c <= '9') return c - '0';
+    c = tolower(c);
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static int parse(char *text, long size)
+{
+    char *pos = text, *line, *value;
+    char registry[40], chset[40], family2[40];
+    bdfglyph *g = NULL;
+    long poolsize = 0, code = -1;
+    int  nchars = 0, inbitmap = 0, row = 0, ascent = -1, descent = -1;
+    int  ulpos = -1, ulheight = 0, i, j, pitch;
+
+    registry[0] = chset[0] = family2[0] = '\0';
+    sttzero(&fhdr);
+    bitpool = malloc(size / 2 + 1);
+    if(bitpool == NULL) return FALSE;
+    line = nextline(&pos);
+    if(line == NULL || !keyword(line, "STARTFONT", &value)) {
+        DBGPRINTF(DBG_FONT, ("not a BDF file\n"));
+        return FALSE;
+    }
+    while((line = nextline(&pos)) != NULL) {
+        if(inbitmap) {
+            if(keyword(line, "ENDCHAR", &value)) {
+                inbitmap = 0;
+                if(row == g->bbh) nglyphs++;
+                continue;
+            }
+            if(row >= g->bbh) continue;
+            pitch = (g->bbw + 7) >> 3;
+            for(j = 0; j < pitch; j++) {
+                int hi = hexdigit(line[2 * j]);
+                int lo = (hi >= 0) ? hexdigit(line[2 * j + 1]) : -1;
+                bitpool[g->bits + row * pitch + j] = (lo >= 0) ? (hi << 4) | lo : 0;
+                if(lo < 0) break;
+            }
+            row++;
+            continue;
+        }
+        if(keyword(line, "FONTBOUNDINGBOX", &value))
+            sscanf(value, "%d %d %d %d", &fhdr.fbbw, &fhdr.fbbh, &fhdr.fbbx, &fhdr.fbby);
+        else if(keyword(line, "FONT_ASCENT", &value)) ascent = atoi(value);
+        else if(keyword(line, "FONT_DESCENT", &value)) descent = atoi(value);
+        else if(keyword(line, "UNDERLINE_POSITION", &value)) ulpos = atoi(value);
+        else if(keyword(line, "UNDERLINE_THICKNESS", &value)) ulheight = atoi(value);
+        else if(keyword(line, "FAMILY_NAME", &value))
+            strvalue(family2, value, sizeof family2);
+        else if(keyword(line, "CHARSET_REGISTRY", &value))
+            strvalue(registry, value, sizeof registry);
+        else if(keyword(line, "CHARSET_ENCODING", &value))
+            strvalue(chset, value, sizeof chset);
+        else if(keyword(line, "CHARS", &value)) {
+            nchars = atoi(value);
+            if(nchars <= 0) break;
+            glyphs = malloc(nchars * sizeof(bdfglyph));
+            if(glyphs == NULL) return FALSE;
+        }
+        else if(keyword(line, "STARTCHAR", &value)) {
+            if(glyphs == NULL || nglyphs >= nchars) break;
+            g = &glyphs[nglyphs];
+            g->dwidth = g->bbw = g->bbh = g->bbx = g->bby = 0;
+            code = -1;
+        }
+        else if(keyword(line, "ENCODING", &value)) {
+            /* "-1 n" is a glyph not in the font encoding, skipped */
+            code = strtol(value, NULL, 10);
+        }
+        else if(keyword(line, "DWIDTH", &value)) {
+            if(g != NULL) g->dwidth = atoi(value);
+        }
+        else if(keyword(line, "BBX", &value)) {
+            if(g != NULL) sscanf(value, "%d %d %d %d", &g->bbw, &g->bbh, &g->bbx, &g->bby);
+        }
+        else if(keyword(line, "BITMAP", &value)) {
+            if(g == NULL || code < 0 || g->bbw < 0 || g->bbh < 0) continue;
+            /* keep the bitmap size in an int */
+            if(g->bbw > BDF_MAXBBX || g->bbh > BDF_MAXBBX) continue;
+            i = ((g->bbw + 7) >> 3) * g->bbh;
+            if(poolsize + i > size / 2 + 1) break;
+            g->code = code;
+            g->bits = poolsize;
+            memset(&bitpool[poolsize], 0, i);
+            poolsize += i;
+            inbitmap = 1;
+            row = 0;
+        }
+        else if(keyword(line, "ENDFONT", &value)) break;
+    }
+    if(nglyphs == 0) {
+        DBGPRINTF(DBG_FONT, ("no glyphs in the BDF file\n"));
+        return FALSE;
+    }
+    qsort(glyphs, nglyphs, sizeof(bdfglyph), cmpglyph);
+    for(i = j = 1; i < nglyphs; i++) {
+        if(glyphs[i].code != glyphs[j - 1].code) glyphs[j++] = glyphs[i];
+    }
+    nglyphs = j;
+    /* font cell */
+    fhdr.ascent = (ascent >= 0) ? ascent : fhdr.fbbh + fhdr.fbby;
+    fhdr.descent = (descent >= 0) ? descent : -fhdr.fbby;
+    if(fhdr.ascent + fhdr.descent <= 0) {
+        DBGPRINTF(DBG_FONT, ("invalid font height\n"));
+        return FALSE;
+    }
+    fhdr.ulheight = (ulheight > 0) ? ulheight : imax(1, (fhdr.ascent + fhdr.descent) / 15);
+    fhdr.ulpos = (ulpos >= 0) ? fhdr.ascent + ulpos : fhdr.ascent + fhdr.descent - fhdr.ulheight;
+    fhdr.ulpos = imax(0, imin(fhdr.ulpos, fhdr.ascent + fhdr.descent - fhdr.ulheight));
+    for(i = 0, poolsize = 0; i < nglyphs; i++) {
+        if(glyphs[i].dwidth <= 0) glyphs[i].dwidth = imax(1, glyphs[i].bbw);
+        if(glyphs[i].dwidth != glyphs[0].dwidth) fhdr.proportional = TRUE;
+        poolsize += glyphs[i].dwidth;
+    }
+    fhdr.width = fhdr.proportional ? poolsize / nglyphs : glyphs[0].dwidth;
+    /* encoding */
+    for(i = 0; registry[i]; i++) registry[i] = toupper(registry[i]);
+    fhdr.encoding = GR_FONTENC_UNKNOWN;
+    if(strcmp(registry, "ISO10646") == 0) fhdr.encoding = GR_FONTENC_UNICODE;
+    else if(strcmp(registry, "ISO8859") == 0) {
+        if(strcmp(chset, "1") == 0) fhdr.encoding = GR_FONTENC_ISO_8859_1;
+        else if(strcmp(chset, "5") == 0) fhdr.encoding = GR_FONTENC_ISO_8859_5;
+        else if(strcmp(chset, "7") == 0) fhdr.encoding = GR_FONTENC_ISO_8859_7;
+    }
+    if(family2[0] != '\0') {
+        for(i = j = 0; family2[i] && j < (int)sizeof family - 1; i++) {
+            if(isalnum((unsigned char)family2[i])) family[j++] = tolower(family2[i]);
+        }
+        family[j] = '\0';
+    }
+    return TRUE;
+}
+
+static int openfile(char *fname)
+{
+    FILE *fp;
+    char *text = NULL, *s;
+    long size;
+    int res;
+    GRX_ENTER();
+    res = FALSE;
+    cleanup();
+    fp = fopen(fname, "rb");
+    if(fp == NULL) {
+        DBGPRINTF(DBG_FONT, ("fopen(\"%s\") failed\n", fname));
+        goto done;
+    }
+    if(fseek(fp, 0, SEEK_END) < 0 || (size = ftell(fp)) <= 0) goto done;
+    rewind(fp);
+    text = malloc(size + 1);
+    if(text == NULL) goto done;
+    if(fread(text, 1, size, fp) != (size_t)size) goto done;
+    text[size] = '\0';
+    /* get font name and family from the file name */
+    s = strrchr(fname, '/');
+    #if defined(__MSDOS__) || defined(__WIN32__)
+    if(s == NULL) {
+        s = strrchr(fname, '\\');
+        if(s == NULL) s = strrchr(fname, ':');
+    }
+    else if(strrchr(s, '\\') != NULL) s = strrchr(s, '\\');
+    #endif
+    if(s == NULL || *++s == '\0') s = fname;
+    strncpy(name, s, sizeof name - 1);
+    name[sizeof name - 1] = '\0';
+    if((s = strrchr(name, '.')) != NULL) *s = '\0';
+    strcpy(family, name);
+    for(s = family; isalpha(*s); s++);
+    if(s > family) *s = '\0';
+    res = parse(text, size);
+    done:
+    if(text != NULL) free(text);
+    if(fp != NULL) fclose(fp);
+    if(!res) cleanup();
+    GRX_RETURN(res);
+}
+
+static int header(GrFontHeader *hdr)
+{
+    int res;
+    GRX_ENTER();
+    res = FALSE;
+    if(glyphs != NULL) {
+        strcpy(hdr->name, name);
+        strcpy(hdr->family, family);
+        hdr->proportional = fhdr.proportional;
+        hdr->scalable = FALSE;
+        hdr->preloaded = FALSE;
+        hdr->modified = GR_FONTCVT_NONE;
+        hdr->width = fhdr.width;
+        hdr->height = fhdr.ascent + fhdr.descent;
+        hdr->baseline = fhdr.ascent;
+        hdr->ulheight = fhdr.ulheight;
+        hdr->ulpos = fhdr.ulpos;
+        hdr->minchar = glyphs[0].code;
+        hdr->numchars = glyphs[nglyphs - 1].code - glyphs[0].code + 1;
+        hdr->encoding = fhdr.encoding;
+        hdr->sparse = (hdr->numchars != (unsigned int)nglyphs);
+        hdr->usedefg = FALSE;
+        hdr->defglyph = 0;
+        res = TRUE;
+    }
+    GRX_RETURN(res);
+}
+
+static bdfglyph *findglyph(int chr)
+{
+    int lo = 0, hi = nglyphs - 1, mid;
+
+    while(lo <= hi) {
+        mid = (lo + hi) / 2;
+        if(glyphs[mid].code == chr) return &glyphs[mid];
+        if(glyphs[mid].code < chr) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return NULL;
+}
+
+static int charwdt(int chr)
+{
+    bdfglyph *g;
+    GRX_ENTER();
+    if(glyphs == NULL || chr < glyphs[0].code || chr > glyphs[nglyphs - 1].code)
+        GRX_RETURN(-1);
+    g = findglyph(chr);
+    GRX_RETURN(g ? g->dwidth : 0);
+}
+
+static int bitmap(int chr,int w,int h,char *buffer)
+{
+    bdfglyph *g;
+    unsigned char *src;
+    int pitch, spitch, x, y, r, c;
+    GRX_ENTER();
+    g = findglyph(chr);
+    if(g == NULL || w != g->dwidth || h != fhdr.ascent + fhdr.descent)
+        GRX_RETURN(FALSE);
+    pitch = (w + 7) >> 3;
+    spitch = (g->bbw + 7) >> 3;
+    memset(buffer, 0, pitch * h);
+    for(r = 0; r < g->bbh; r++) {
+        y = fhdr.ascent - (g->bby + g->bbh) + r;
+        if(y < 0 || y >= h) continue;
+        src = &bitpool[g->bits + r * spitch];
+        for(c = 0; c < g->bbw; c++) {
+            if(!(src[c >> 3] & (0x80 >> (c & 7)))) continue;
+            x = g->bbx + c;
+            if(x < 0 || x >= w) continue;
+            buffer[y * pitch + (x >> 3)] |= (0x80 >> (x & 7));
+        }
+    }
+    GRX_RETURN(TRUE);
+}
+
+GrFontDriver _GrFontDriverBDF = {
+    "BDF",                              /* driver name (doc only) */
+    ".bdf",                             /* font file extension */
+    FALSE,                              /* scalable */
+    openfile,                           /* file open and check routine */
+    header,                             /* font header reader routine */
+    charwdt,                            /* character width reader routine */
+    bitmap,                             /* character bitmap reader routine */
+    cleanup,                            /* cleanup routine */
+    NULL,                               /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
+};
@@ -18,6 +18,8 @@
  ** Contributions by: (See "doc/credits.doc" for details)
  ** Hartmut Schirmer (hsc@techfak.uni-kiel.de)
  **
+ ** 261019 M.Alvarez, anti-aliased rendering and stroke vectors reader
+ **
  **/
 
 #include <stdio.h>
@@ -331,6 +333,122 @@ static int bitmap(int chr,int w,int h,char *buffer)
     return(TRUE);
 }
 
+/* square root of v < 65536 (no libm, every program links this driver) */
+static unsigned int isqrt16(unsigned int v)
+{
+    unsigned int r = 0, b;
+
+    for(b = 0x80; b != 0; b >>= 1) {
+        if((r + b) * (r + b) <= v) r += b;
+    }
+    return(r);
+}
+
+/*
+ * anti-aliased rendering, the coverage of a pixel is 1 - its distance
+ * to the nearest stroke (in pixels), strokes are one pixel wide
+ */
+static void covline(double x1,double y1,double x2,double y2,
+                    unsigned char *buffer,int w,int h,int pitch)
+{
+    double dx = x2 - x1, dy = y2 - y1, len2 = dx * dx + dy * dy;
+    double t, ex, ey, d2;
+    int xmin, xmax, ymin, ymax, x, y, c;
+
+    /* the coordinates aren't negative, so (int) is floor */
+    xmin = imax(0,(int)((x1 < x2) ? x1 : x2));
+    xmax = imin(w - 1,(int)((x1 > x2) ? x1 : x2) + 1);
+    ymin = imax(0,(int)((y1 < y2) ? y1 : y2));
+    ymax = imin(h - 1,(int)((y1 > y2) ? y1 : y2) + 1);
+    for(y = ymin; y <= ymax; y++) {
+        for(x = xmin; x <= xmax; x++) {
+            t = (len2 > 0.0) ? ((x - x1) * dx + (y - y1) * dy) / len2 : 0.0;
+            if(t < 0.0) t = 0.0;
+            if(t > 1.0) t = 1.0;
+            ex = x1 + t * dx - x;
+            ey = y1 + t * dy - y;
+            d2 = ex * ex + ey * ey;
+            if(d2 >= 1.0) continue;
+            c = 255 - isqrt16((unsigned int)(d2 * 65535.0));
+            if(c > buffer[y * pitch + x]) buffer[y * pitch + x] = c;
+        }
+    }
+}
+
+static int coverage(int chr,int w,int h,unsigned char *buffer)
+{
+    double xscale,yscale;
+    int xpos,ypos,xend,yend;
+    int pitch;
+    GR_int16u *vp;
+    chr -= fhtp->firstch;
+
+    if(!fdata) return(FALSE);
+    if((unsigned int)chr >= (unsigned int)fhtp->nchrs) return(FALSE);
+    if((w <= 0) || (h <= 0)) return(FALSE);
+    pitch = (w + 7) & ~7;
+    memfill_b(buffer,0,(pitch * h));
+    if((realwdt[chr] <= 1) || (realhgt <= 1)) return(TRUE);
+    /* the same pixel centers than bitmap */
+    xscale = (double)(w - 1) / (realwdt[chr] - 1);
+    yscale = (double)(h - 1) / (realhgt - 1);
+    vp = (GR_int16u *)(vecdata + offsets[chr]);
+    for(xpos = ypos = 0; ; vp++) {
+        switch(SV_COMMAND(*vp)) {
+            case SVC_END:
+                break;
+            case SVC_MOVE:
+                xpos = SV_XCOORD(*vp) + xoffset[chr];
+                ypos = fhtp->org_to_cap - SV_YCOORD(*vp) + yoffset;
+                continue;
+            case SVC_SCAN:
+                continue;
+            case SVC_DRAW:
+                xend = SV_XCOORD(*vp) + xoffset[chr];
+                yend = fhtp->org_to_cap - SV_YCOORD(*vp) + yoffset;
+                covline(xpos * xscale,ypos * yscale,
+                        xend * xscale,yend * yscale,
+                        buffer,w,h,pitch);
+                xpos = xend;
+                ypos = yend;
+                continue;
+        }
+        break;
+    }
+    return(TRUE);
+}
+
+/* the vectors in font units, returns how many (only counts if !buffer) */
+static int strokes(int chr,GrFontStroke *buffer)
+{
+    GR_int16u *vp;
+    int n = 0;
+    chr -= fhtp->firstch;
+
+    if(!fdata) return(-1);
+    if((unsigned int)chr >= (unsigned int)fhtp->nchrs) return(-1);
+    vp = (GR_int16u *)(vecdata + offsets[chr]);
+    for( ; ; vp++) {
+        switch(SV_COMMAND(*vp)) {
+            case SVC_END:
+                break;
+            case SVC_SCAN:
+                continue;
+            case SVC_MOVE:
+            case SVC_DRAW:
+                if(buffer) {
+                    buffer[n].x    = SV_XCOORD(*vp) + xoffset[chr];
+                    buffer[n].y    = fhtp->org_to_cap - SV_YCOORD(*vp) + yoffset;
+                    buffer[n].draw = (SV_COMMAND(*vp) == SVC_DRAW);
+                }
+                n++;
+                continue;
+        }
+        break;
+    }
+    return(n);
+}
+
 GrFontDriver _GrFontDriverBGI = {
     "BGI",                              /* driver name (doc only) */
     ".chr",                             /* font file extension */
@@ -339,5 +457,8 @@ GrFontDriver _GrFontDriverBGI = {
     header,                             /* font header reader routine */
     charwdt,                            /* character width reader routine */
     bitmap,                             /* character bitmap reader routine */
-    cleanup                             /* cleanup routine */
+    cleanup,                            /* cleanup routine */
+    coverage,                           /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    strokes                             /* stroke vectors reader routine */
 };
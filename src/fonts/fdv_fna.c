@@ -14,6 +14,10 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, "coverage 4" fonts are anti-aliased, a hex digit
+ **                   per pixel ('.' is 0 and '#' is f), the bitmap has
+ **                   the pixels with 8 or more
+ **
  **/
 
 #include <ctype.h>
@@ -40,6 +44,7 @@ static struct {
     int  width;
     int  height;
     int  isfixed;
+    int  coverage;                      /* bits per pixel, 1 or 4 */
 } fhdr;
 
 static int readline(void)
@@ -132,6 +137,7 @@ static int header(GrFontHeader *hdr)
         "minwidth",
         "maxwidth",
         "note",
+        "coverage",
         NULL
     };
     int attrib;
@@ -139,6 +145,7 @@ static int header(GrFontHeader *hdr)
     res = FALSE;
     if(fontfp == NULL) goto done;
     attrib = 0;
+    fhdr.coverage = 1;
     while(readline() && isalpha(*fhdr.buffer)) {
         fhdr.offset = ftell(fontfp);
         if(fhdr.offset == -1) {
@@ -166,7 +173,7 @@ static int header(GrFontHeader *hdr)
             DBGPRINTF(DBG_FONT, ("duplicate attribute \"%s\"\n", fhdr.buffer));
             goto done;
         }
-        if(index >= 2 && index <= 11) {
+        if((index >= 2 && index <= 11) || index == 13) {
             if(sscanf(s, "%d%n", &i, &n) != 1 || n != strlen(s)) {
                 DBGPRINTF(DBG_FONT, ("invalid number \"%s\"\n", s));
                 goto done;
@@ -202,6 +209,13 @@ static int header(GrFontHeader *hdr)
                 }
                 break;
             case 12 : continue;
+            case 13 :
+                if(i != 1 && i != 4) {
+                    DBGPRINTF(DBG_FONT, ("invalid coverage %d\n", i));
+                    goto done;
+                }
+                fhdr.coverage = i;
+                break;
             default :
                 DBGPRINTF(DBG_FONT, ("unsupported attribute \"%s\"\n", fhdr.buffer));
                 goto done;
@@ -244,10 +258,23 @@ static int charwdt(int chr)
     GRX_RETURN(res);
 }
 
+/* pixel value from 0 to 15, -1 if invalid */
+static int pixel(char c)
+{
+    if(c == '.') return 0;
+    if(c == '#') return 15;
+    if(fhdr.coverage == 4) {
+        if(c >= '0' && c <= '9') return c - '0';
+        if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    }
+    return -1;
+}
+
 static int bitmap(int chr, int w, int h, char *buffer)
 {
     int res;
-    int y, x;
+    int y, x, v;
     int bytes;
     GRX_ENTER();
     DBGPRINTF(DBG_FONT, ("bitmap(%d, %d, %d)\n", chr, w, h));
@@ -262,8 +289,9 @@ static int bitmap(int chr, int w, int h, char *buffer)
             goto done;
         }
         for(x = 0; x < w; x++) {
-            if(fhdr.buffer[x] == '#') buffer[x >> 3] |= 1 << (7 - (x & 7));
-            else if(fhdr.buffer[x] != '.') {
+            v = pixel(fhdr.buffer[x]);
+            if(v >= 8) buffer[x >> 3] |= 1 << (7 - (x & 7));
+            else if(v < 0) {
                 DBGPRINTF(DBG_FONT, ("invalid character data \'%c\'\n", fhdr.buffer[x]));
                 goto done;
             }
@@ -274,6 +302,31 @@ static int bitmap(int chr, int w, int h, char *buffer)
     done:	GRX_RETURN(res);
 }
 
+static int coverage(int chr, int w, int h, unsigned char *buffer)
+{
+    int res;
+    int y, x, v;
+    int pitch;
+    GRX_ENTER();
+    DBGPRINTF(DBG_FONT, ("coverage(%d, %d, %d)\n", chr, w, h));
+    res = FALSE;
+    if(fhdr.coverage == 1) goto done;
+    if(w != charwdt(chr) || h != fhdr.height) goto done;
+    pitch = (w + 7) & ~7;
+    for(y = 0; y < h; y++) {
+        if(!readindex(chr, y)) goto done;
+        if(strlen(fhdr.buffer) != w) goto done;
+        for(x = 0; x < w; x++) {
+            v = pixel(fhdr.buffer[x]);
+            if(v < 0) goto done;
+            buffer[x] = v * 17;
+        }
+        buffer += pitch;
+    }
+    res = TRUE;
+    done:	GRX_RETURN(res);
+}
+
 GrFontDriver _GrFontDriverFNA = {
     "FNA",                              /* driver name (doc only) */
     ".fna",                             /* font file extension */
@@ -282,5 +335,8 @@ GrFontDriver _GrFontDriverFNA = {
     header,                             /* font header reader routine */
     charwdt,                            /* character width reader routine */
     bitmap,                             /* character bitmap reader routine */
-    cleanup                             /* cleanup routine */
+    cleanup,                            /* cleanup routine */
+    coverage,                           /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
 };
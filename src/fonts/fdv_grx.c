@@ -225,5 +225,8 @@ GrFontDriver _GrFontDriverGRX = {
     header,                             /* font header reader routine */
     charwdt,                            /* character width reader routine */
     bitmap,                             /* character bitmap reader routine */
-    cleanup                             /* cleanup routine */
+    cleanup,                            /* cleanup routine */
+    NULL,                               /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
 };
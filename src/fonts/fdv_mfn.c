@@ -0,0 +1,340 @@
+/**
+ ** fdv_mfn.c ---- driver for MGRX mappable font files
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The file is mapped in memory (read in systems without mmap). Fonts
+ ** loaded without conversion use the mapped bitmap directly, so only
+ ** the pages with used glyphs are read, the mapping is released by
+ ** GrUnloadFont. Converted fonts are built as usual.
+ **
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "grfontdv.h"
+#include "fonts/fdv_mfn.h"
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP
+#endif
+
+typedef struct _mapping {
+    struct _mapping *next;
+    GrFont *font;
+    void   *base;
+    long    size;
+    int     mapped;                     /* else malloc'ed */
+} mapping;
+
+static mapping *mappings = NULL;
+
+static GrFontFileHeaderMFN fhdr;
+static unsigned char *fbase = NULL;     /* the file in memory */
+static long fsize = 0;
+static int fmapped = FALSE;
+static const unsigned char *ranges = NULL;
+static const unsigned char *glyphs = NULL;
+
+static GR_int32u get32(const unsigned char *p)
+{
+    return (GR_int32u)p[0] | ((GR_int32u)p[1] << 8) |
+           ((GR_int32u)p[2] << 16) | ((GR_int32u)p[3] << 24);
+}
+
+static void release(void *base, long size, int mapped)
+{
+#ifdef HAVE_MMAP
+    if (mapped) {
+        munmap(base, size);
+        return;
+    }
+#endif
+    free(base);
+}
+
+static void cleanup(void)
+{
+    GRX_ENTER();
+    if (fbase != NULL) release(fbase, fsize, fmapped);
+    fbase = NULL;
+    fsize = 0;
+    ranges = glyphs = NULL;
+    GRX_LEAVE();
+}
+
+static int readfile(char *fname)
+{
+    FILE *fp;
+    int res = FALSE;
+
+    fp = fopen(fname, "rb");
+    if (fp == NULL) return FALSE;
+    if (fseek(fp, 0, SEEK_END) != 0) goto done;
+    if ((fsize = ftell(fp)) < (long)sizeof(GrFontFileHeaderMFN)) goto done;
+    rewind(fp);
+    /* don't map or read other formats */
+    if (fread(&fhdr, sizeof(fhdr), 1, fp) != 1) goto done;
+    if (get32((unsigned char *)&fhdr.magic) != MFN_FONTMAGIC) goto done;
+    rewind(fp);
+#ifdef HAVE_MMAP
+    fbase = mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+    fmapped = TRUE;
+    if (fbase == MAP_FAILED) fbase = NULL;
+#endif
+    if (fbase == NULL) {
+        fmapped = FALSE;
+        fbase = malloc(fsize);
+        if (fbase == NULL) goto done;
+        if (fread(fbase, 1, fsize, fp) != (size_t)fsize) {
+            free(fbase);
+            fbase = NULL;
+            goto done;
+        }
+    }
+    res = TRUE;
+done:
+    fclose(fp);
+    return res;
+}
+
+static int openfile(char *fname)
+{
+    GR_int32u *p;
+    unsigned long end;
+    int res, i;
+    GRX_ENTER();
+    res = FALSE;
+    cleanup();
+    if (!readfile(fname)) {
+        DBGPRINTF(DBG_FONT,("can't read \"%s\" as a MFN font\n", fname));
+        goto done;
+    }
+    /* the numbers before the names */
+    for (i = 0, p = &fhdr.magic; p < (GR_int32u *)fhdr.fnname; i++, p++)
+        *p = get32(&fbase[i * 4]);
+    fhdr.fnname[MFN_NAMEWIDTH - 1] = '\0';
+    fhdr.family[MFN_NAMEWIDTH - 1] = '\0';
+    if (fhdr.hdrsize < sizeof(fhdr) || fhdr.numchars == 0 || fhdr.height == 0) {
+        DBGPRINTF(DBG_FONT,("invalid header\n"));
+        goto done;
+    }
+    end = fhdr.hdrsize + 12UL * fhdr.nranges + 8UL * fhdr.nglyphs;
+    if (end > (unsigned long)fsize ||
+        fhdr.bmpofs + (unsigned long)fhdr.bmpsize > (unsigned long)fsize ||
+        (fhdr.covofs &&
+         fhdr.covofs + 8UL * fhdr.bmpsize > (unsigned long)fsize)) {
+        DBGPRINTF(DBG_FONT,("truncated file\n"));
+        goto done;
+    }
+    ranges = fbase + fhdr.hdrsize;
+    glyphs = ranges + 12 * fhdr.nranges;
+    res = TRUE;
+    done:
+    if (!res) cleanup();
+    GRX_RETURN(res);
+}
+
+static int header(GrFontHeader *hdr)
+{
+    GRX_ENTER();
+    strcpy(hdr->name, fhdr.fnname);
+    strcpy(hdr->family, fhdr.family);
+    hdr->proportional = fhdr.proportional ? TRUE : FALSE;
+    hdr->scalable = FALSE;
+    hdr->preloaded = FALSE;
+    hdr->modified = GR_FONTCVT_NONE;
+    hdr->width = fhdr.width;
+    hdr->height = fhdr.height;
+    hdr->baseline = fhdr.baseline;
+    hdr->ulpos = fhdr.ulpos;
+    hdr->ulheight = fhdr.ulheight;
+    hdr->minchar = fhdr.minchar;
+    hdr->numchars = fhdr.numchars;
+    hdr->encoding = fhdr.encoding;
+    hdr->sparse = (fhdr.nglyphs < fhdr.numchars) ? TRUE : FALSE;
+    hdr->usedefg = fhdr.usedefg ? TRUE : FALSE;
+    hdr->defglyph = fhdr.defglyph;
+    GRX_RETURN(TRUE);
+}
+
+/* glyph table entry of chr, NULL if not present */
+static const unsigned char *findglyph(int chr)
+{
+    unsigned int lo, hi, mid, first, n, g;
+
+    lo = 0;
+    hi = fhdr.nranges;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        first = get32(&ranges[12 * mid]);
+        if ((unsigned int)chr < first) hi = mid;
+        else lo = mid + 1;
+    }
+    if (lo == 0) return NULL;
+    first = get32(&ranges[12 * (lo - 1)]);
+    n = get32(&ranges[12 * (lo - 1) + 4]);
+    if ((unsigned int)chr >= first + n) return NULL;
+    g = get32(&ranges[12 * (lo - 1) + 8]) + (chr - first);
+    if (g >= fhdr.nglyphs) return NULL;
+    return &glyphs[8 * g];
+}
+
+static int charwdt(int chr)
+{
+    const unsigned char *gp;
+    GRX_ENTER();
+    gp = findglyph(chr);
+    GRX_RETURN(gp ? (int)get32(gp) : (fhdr.nglyphs < fhdr.numchars ? 0 : -1));
+}
+
+static int bitmap(int chr, int w, int h, char *buffer)
+{
+    const unsigned char *gp;
+    unsigned long ofs, size;
+    GRX_ENTER();
+    gp = findglyph(chr);
+    if (gp == NULL || get32(gp) != (GR_int32u)w || h != (int)fhdr.height)
+        GRX_RETURN(FALSE);
+    ofs = get32(gp + 4);
+    size = ((w + 7) >> 3) * h;
+    if (ofs > fhdr.bmpsize || size > fhdr.bmpsize - ofs) GRX_RETURN(FALSE);
+    memcpy(buffer, fbase + fhdr.bmpofs + ofs, size);
+    GRX_RETURN(TRUE);
+}
+
+static int coverage(int chr, int w, int h, unsigned char *buffer)
+{
+    const unsigned char *gp;
+    unsigned long ofs, size;
+    GRX_ENTER();
+    if (fhdr.covofs == 0) GRX_RETURN(FALSE);
+    gp = findglyph(chr);
+    if (gp == NULL || get32(gp) != (GR_int32u)w || h != (int)fhdr.height)
+        GRX_RETURN(FALSE);
+    ofs = get32(gp + 4);
+    size = ((w + 7) & ~7) * h;
+    if (ofs > fhdr.bmpsize || size > 8UL * (fhdr.bmpsize - ofs))
+        GRX_RETURN(FALSE);
+    ofs <<= 3;
+    memcpy(buffer, fbase + fhdr.covofs + ofs, size);
+    GRX_RETURN(TRUE);
+}
+
+/* the font of the file just read, without conversion */
+static GrFont *mapfont(void)
+{
+    GrFont *f;
+    mapping *m;
+    unsigned int r, i, first, n, g, w, ofs, ninfo, idx;
+    GRX_ENTER();
+    ninfo = fhdr.numchars;
+    if (_GrFontUseGlyphMap(fhdr.numchars, fhdr.nglyphs)) ninfo = fhdr.nglyphs;
+    m = NULL;
+    f = calloc(1, sizeof(GrFont) + (ninfo - 1) * sizeof(GrFontChrInfo));
+    if (f == NULL) goto error;
+    m = malloc(sizeof(mapping));
+    if (m == NULL) goto error;
+    f->h.name = malloc(strlen(fhdr.fnname) + 1);
+    f->h.family = malloc(strlen(fhdr.family) + 1);
+    if (f->h.name == NULL || f->h.family == NULL) goto error;
+    header(&f->h);
+    f->minwidth = fhdr.minwidth;
+    f->maxwidth = fhdr.maxwidth;
+    /* with a glyph map chrinfo is the glyph table */
+    if (ninfo != fhdr.numchars) {
+        if (!_GrFontNewGlyphMap(f)) goto error;
+        f->numglyphs = ninfo;
+    }
+    for (r = 0; r < fhdr.nranges; r++) {
+        first = get32(&ranges[12 * r]);
+        n = get32(&ranges[12 * r + 4]);
+        g = get32(&ranges[12 * r + 8]);
+        for (i = 0; i < n; i++, g++) {
+            if (first + i < fhdr.minchar ||
+                first + i >= fhdr.minchar + fhdr.numchars ||
+                g >= fhdr.nglyphs) goto error;
+            w = get32(&glyphs[8 * g]);
+            ofs = get32(&glyphs[8 * g + 4]);
+            if (ofs > fhdr.bmpsize ||
+                (w >> 3) + ((w & 7) ? 1 : 0) >
+                (fhdr.bmpsize - ofs) / fhdr.height) goto error;
+            idx = first + i - fhdr.minchar;
+            if (f->glyphmap) {
+                if (!_GrFontSetGlyph(f, idx, g)) goto error;
+                idx = g;
+            }
+            f->chrinfo[idx].width = w;
+            f->chrinfo[idx].offset = ofs;
+        }
+    }
+    f->bitmap = (char *)fbase + fhdr.bmpofs;
+    if (fhdr.covofs) f->covmap = fbase + fhdr.covofs;
+    m->font = f;
+    m->base = fbase;
+    m->size = fsize;
+    m->mapped = fmapped;
+    m->next = mappings;
+    mappings = m;
+    fbase = NULL;       /* now it belongs to the font */
+    GRX_RETURN(f);
+    error:
+    if (f != NULL) {
+        _GrFontFreeGlyphMap(f);
+        free(f->h.name);
+        free(f->h.family);
+        free(f);
+    }
+    free(m);
+    GRX_RETURN(NULL);
+}
+
+/*
+ * _GrFontUnmap - releases the file of a mapped font, returns FALSE if
+ * the font is not mapped (then the bitmap must be freed)
+ */
+int _GrFontUnmap(GrFont *f)
+{
+    mapping **pm, *m;
+
+    for (pm = &mappings; (m = *pm) != NULL; pm = &m->next) {
+        if (m->font != f) continue;
+        *pm = m->next;
+        release(m->base, m->size, m->mapped);
+        free(m);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+GrFontDriver _GrFontDriverMFN = {
+    "MFN",                              /* driver name (doc only) */
+    ".mfn",                             /* font file extension */
+    FALSE,                              /* scalable */
+    openfile,                           /* file open and check routine */
+    header,                             /* font header reader routine */
+    charwdt,                            /* character width reader routine */
+    bitmap,                             /* character bitmap reader routine */
+    cleanup,                            /* cleanup routine */
+    coverage,                           /* coverage map reader routine */
+    mapfont,                            /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
+};
@@ -0,0 +1,70 @@
+/**
+ ** fdv_mfn.h ---- MGRX mappable font file format
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#ifndef __FDV_MFN_H_INCLUDED__
+#define __FDV_MFN_H_INCLUDED__
+
+/*
+ *  font file structure (all numbers are 32 bit little endian):
+ *  +-----------------------+
+ *  |     FILE HEADER       |
+ *  +-----------------------+
+ *  |     RANGE TABLE       |  first char, number of chars, first
+ *  |     (nranges)         |  glyph (runs of present glyphs)
+ *  +-----------------------+
+ *  |     GLYPH TABLE       |  width, bitmap offset
+ *  |     (nglyphs)         |  (glyphs of every range in order)
+ *  +-----------------------+
+ *  |     BITMAP            |  at bmpofs, 8 bytes aligned
+ *  +-----------------------+
+ *  |     COVERAGE MAP      |  at covofs (if not 0), 8 * bmpsize
+ *  +-----------------------+
+ *
+ *  Glyph bitmaps are stored like in a GrFont, so the file can be
+ *  mapped in memory and used directly, only the used pages are read.
+ */
+
+#define MFN_NAMEWIDTH   32
+#define MFN_FONTMAGIC   0x314e464dL     /* "MFN1" */
+
+typedef struct _GR_fontFileHeaderMFN {  /* the header */
+    GR_int32u magic;                  /* font file magic number */
+    GR_int32u hdrsize;                /* size of this header */
+    GR_int32u width;                  /* width (average for proportional) */
+    GR_int32u height;                 /* font height */
+    GR_int32u baseline;               /* baseline from top of font */
+    GR_int32u ulpos;                  /* underline position from top */
+    GR_int32u ulheight;               /* underline height */
+    GR_int32u minchar;                /* lowest character code in font */
+    GR_int32u numchars;               /* characters from minchar */
+    GR_int32u proportional;           /* nonzero if proportional font */
+    GR_int32u encoding;               /* font encoding (0=unknown) */
+    GR_int32u usedefg;                /* use the default glyph */
+    GR_int32u defglyph;               /* default glyph */
+    GR_int32u minwidth;               /* width of narrowest glyph */
+    GR_int32u maxwidth;               /* width of widest glyph */
+    GR_int32u nranges;                /* entries in the range table */
+    GR_int32u nglyphs;                /* entries in the glyph table */
+    GR_int32u bmpofs;                 /* bitmap file offset */
+    GR_int32u bmpsize;                /* bitmap size */
+    GR_int32u covofs;                 /* coverage map file offset or 0 */
+    char      fnname[MFN_NAMEWIDTH];  /* font name */
+    char      family[MFN_NAMEWIDTH];  /* font family name */
+} GrFontFileHeaderMFN;
+
+#endif /* whole file */
@@ -18,6 +18,8 @@
  **   - Added psf2 support, raw and psf1 are now treated as pseudo-psf2.
  **   - Better support for RAW files: up to 16x32, assuming scale 1:2.
  **
+ ** 261019 M.Alvarez, psf fonts with a unicode table are unicode encoded
+ **
  **/
 
 #include <ctype.h>
@@ -43,6 +45,14 @@ static int nextch = 0;
 static char name[40], family[40];
 static GrFontFileHeaderPSF fhdr;
 
+typedef struct {
+    GR_int32u code;                     /* unicode char */
+    GR_int32u glyph;                    /* glyph in the file */
+} unientry;
+
+static unientry *unimap = NULL;         /* sorted by code, or NULL */
+static int nunimap = 0;
+
 #if BYTE_ORDER==BIG_ENDIAN
 #include "ordswap.h"
 static void swap_header(void) {
@@ -64,9 +74,99 @@ static void cleanup(void)
     if(fontfp != NULL) fclose(fontfp);
     fontfp = NULL;
     nextch = 0;
+    if(unimap != NULL) free(unimap);
+    unimap = NULL;
+    nunimap = 0;
     GRX_LEAVE();
 }
 
+static int cmpunientry(const void *a, const void *b)
+{
+    const unientry *ua = a, *ub = b;
+    if(ua->code != ub->code) return (ua->code < ub->code) ? -1 : 1;
+    return (ua->glyph < ub->glyph) ? -1 : (ua->glyph > ub->glyph);
+}
+
+/*
+ * readunimap - reads the unicode table after the glyphs. For every glyph
+ * there is a list of chars (utf-8 in psf2, 16 bit little endian in psf1),
+ * then sequences of chars (skipped) and a terminator.
+ */
+static int readunimap(long pos, long size, int psf2)
+{
+    unsigned char *buf, *p, *end;
+    long code;
+    int glyph, seq, n, i;
+
+    size -= pos;
+    if(size <= 0 || fseek(fontfp, pos, SEEK_SET) < 0) return FALSE;
+    buf = malloc(size);
+    /* there can't be more entries than bytes (psf2) or words (psf1) */
+    unimap = malloc(size * sizeof(unientry));
+    if(buf == NULL || unimap == NULL) goto error;
+    if(fread(buf, 1, size, fontfp) != (size_t)size) goto error;
+    p = buf;
+    end = buf + size;
+    for(glyph = 0; glyph < (int)fhdr.numchars && p < end; glyph++) {
+        seq = FALSE;
+        while(p < end) {
+            if(psf2) {
+                if(*p == 0xff) { p++; break; }
+                if(*p == 0xfe) { p++; seq = TRUE; continue; }
+                /* a char truncated by the end of the file ends the table */
+                n = (*p < 0xc2 || *p > 0xf4) ? 1 :
+                    (*p < 0xe0) ? 2 : (*p < 0xf0) ? 3 : 4;
+                if(n > end - p) { p = end; break; }
+                n = _GrRecode_UTF8_UCS4(p, &code);
+                p += n;
+            }
+            else {
+                if(p + 1 >= end) { p = end; break; }
+                code = p[0] | (p[1] << 8);
+                p += 2;
+                if(code == 0xffff) break;
+                if(code == 0xfffe) { seq = TRUE; continue; }
+            }
+            if(seq) continue;
+            unimap[nunimap].code = code;
+            unimap[nunimap].glyph = glyph;
+            nunimap++;
+        }
+    }
+    if(nunimap == 0) goto error;
+    qsort(unimap, nunimap, sizeof(unientry), cmpunientry);
+    /* a char in two glyphs uses the first one */
+    for(i = n = 1; i < nunimap; i++) {
+        if(unimap[i].code != unimap[n - 1].code) unimap[n++] = unimap[i];
+    }
+    nunimap = n;
+    free(buf);
+    return TRUE;
+    error:
+    if(buf != NULL) free(buf);
+    if(unimap != NULL) free(unimap);
+    unimap = NULL;
+    nunimap = 0;
+    return FALSE;
+}
+
+/* the glyph of a char, -1 if out of the font, -2 if not in a unicode font */
+static int findglyph(int chr)
+{
+    int lo, hi, mid;
+    if(unimap == NULL) return (chr >= 0 && chr < (int)fhdr.numchars) ? chr : -1;
+    if(chr < (int)unimap[0].code || chr > (int)unimap[nunimap - 1].code) return -1;
+    lo = 0;
+    hi = nunimap - 1;
+    while(lo <= hi) {
+        mid = (lo + hi) / 2;
+        if((int)unimap[mid].code == chr) return unimap[mid].glyph;
+        if((int)unimap[mid].code < chr) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -2;
+}
+
 static int openfile(char *fname)
 {
     int res;
@@ -157,6 +257,15 @@ static int openfile(char *fname)
     strcpy(family, name);
     for(s = family; isalpha(*s); s++);
     if(s > family) *s = '\0';
+    /* psf fonts with a unicode table are indexed by unicode chars */
+    if((fhdr.offset == PSF1_HDRSIZE && (fhdr.mode & PSF1_UNICODE)) ||
+       (fhdr.offset != PSF1_HDRSIZE && fhdr.offset != 0 &&
+        (fhdr.flags & PSF2_UNICODE))) {
+        if(!readunimap(fhdr.offset + (long)fhdr.charsize * fhdr.numchars, size,
+                       fhdr.offset != PSF1_HDRSIZE)) {
+            DBGPRINTF(DBG_FONT, ("invalid unicode table, using glyph numbers\n"));
+        }
+    }
     /* finish and return */
     nextch = fhdr.numchars;
     res = TRUE;
@@ -185,6 +294,12 @@ static int header(GrFontHeader *hdr)
         hdr->numchars = fhdr.numchars;
         hdr->encoding = 0; /* GR_FONTENC_UNKNOWN */
         hdr->sparse = FALSE;
+        if(unimap != NULL) {
+            hdr->minchar = unimap[0].code;
+            hdr->numchars = unimap[nunimap - 1].code - unimap[0].code + 1;
+            hdr->encoding = GR_FONTENC_UNICODE;
+            hdr->sparse = (hdr->numchars != (unsigned int)nunimap);
+        }
         hdr->usedefg = FALSE;
         hdr->defglyph = 0;
         res = TRUE;
@@ -197,19 +312,26 @@ static int charwdt(int chr)
     int res;
     GRX_ENTER();
     res = -1;
-    if(fontfp != NULL && chr >= 0 && chr < fhdr.numchars) res = fhdr.width;
+    if(fontfp != NULL) {
+        switch(findglyph(chr)) {
+          case -1: break;
+          case -2: res = 0; break;
+          default: res = fhdr.width; break;
+        }
+    }
     GRX_RETURN(res);
 }
 
 static int bitmap(int chr,int w,int h,char *buffer)
 {
-    int res;
+    int res, glyph;
     GRX_ENTER();
     res = FALSE;
     if(w != charwdt(chr) || h != fhdr.height) goto done;
-    if(chr != nextch && fseek(fontfp, fhdr.offset + fhdr.charsize * chr, SEEK_SET) < 0) goto done;
+    if((glyph = findglyph(chr)) < 0) goto done;
+    if(glyph != nextch && fseek(fontfp, fhdr.offset + fhdr.charsize * glyph, SEEK_SET) < 0) goto done;
     if(fread(buffer, 1, fhdr.charsize, fontfp) != fhdr.charsize) goto done;
-    nextch = chr + 1;
+    nextch = glyph + 1;
     res = TRUE;
     done:	GRX_RETURN(res);
 }
@@ -222,5 +344,8 @@ GrFontDriver _GrFontDriverRAW = {
     header,                             /* font header reader routine */
     charwdt,                            /* character width reader routine */
     bitmap,                             /* character bitmap reader routine */
-    cleanup                             /* cleanup routine */
+    cleanup,                            /* cleanup routine */
+    NULL,                               /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
 };
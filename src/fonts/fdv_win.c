@@ -246,5 +246,8 @@ GrFontDriver _GrFontDriverWIN = {
     header,                             /* font header reader routine */
     charwdt,                            /* character width reader routine */
     bitmap,                             /* character bitmap reader routine */
-    cleanup                             /* cleanup routine */
+    cleanup,                            /* cleanup routine */
+    NULL,                               /* coverage map reader routine */
+    NULL,                               /* direct font routine */
+    NULL                                /* stroke vectors reader routine */
 };
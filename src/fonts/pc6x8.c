@@ -555,6 +555,9 @@ struct {
 	0,			    /* allocated size of auxiliary bitmap */
 	0,			    /* free space in auxiliary bitmap */
 	{  0		},	    /* converted character bitmap offsets */
+	(unsigned char *)0,	    /* coverage map */
+	0,                          /* glyphs in chrinfo */
+	0,                          /* char to glyph map */
 	{{ 6,	0	}}	    /* first character info */
     },
     {
@@ -61,3 +61,23 @@ void GrDestroyCursor(GrCursor *cursor)
 	    free(cursor);
 	}
 }
+
+/*
+ * The cursor image as a w x h ARGB32 array (left top aligned, transparent
+ * pixels have alpha 0), for the video drivers with a hardware cursor
+ */
+int _GrViDrvCursorARGB(GrCursor *cursor,unsigned int *argb,int w,int h)
+{
+	int  wrkw2 = (cursor->xsize + 7) & ~7;
+	int  xx,yy,r,g,b;
+	if((cursor->xsize > w) || (cursor->ysize > h)) return(FALSE);
+	memset(argb,0,(w * h * sizeof(unsigned int)));
+	for(yy = 0; yy < cursor->ysize; yy++) {
+	    for(xx = 0; xx < cursor->xsize; xx++) {
+		if(GrPixelC(&cursor->work,(xx + wrkw2),yy) != 0) continue;
+		GrQueryColor(GrPixelC(&cursor->work,xx,yy),&r,&g,&b);
+		argb[(yy * w) + xx] = 0xff000000U | (r << 16) | (g << 8) | b;
+	    }
+	}
+	return(TRUE);
+}
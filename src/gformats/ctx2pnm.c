@@ -14,12 +14,14 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 Rows are written with one fwrite, RAM frames are read directly
  **/
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include "mgrx.h"
+#include "libgrx.h"
+#include "pixrow.h"
 
 /*
 ** GrSaveContextToPbm - Dump a context in a PBM file (bitmap)
@@ -41,21 +43,22 @@ int GrSaveContextToPbm( GrContext *grc, char *pbmfn, char *docn )
   FILE *f;
   GrContext grcaux;
   char cab[81];
-  int currentbyte = 0, currentbit = 7;
-  int x, y, width;
+  int x, y, width, rowbytes;
+  GrColor black;
   GrColor *pColors = NULL;
+  unsigned char *pRow = NULL;
+  int res = 0;
 
   if( (f = fopen( pbmfn,"wb" )) == NULL ) return -1;
   
   GrSaveContext( &grcaux );
   if( grc != NULL ) GrSetContext( grc );
   width = GrSizeX();
+  rowbytes = (width + 7) / 8;
   pColors = malloc( sizeof(GrColor)*width );
-  if( pColors == NULL ){
-    GrSetContext( &grcaux );
-    fclose( f );
-    return -1;
-    }
+  pRow = malloc( rowbytes );
+  if( pColors == NULL || pRow == NULL ){ res = -1; goto salida; }
+  black = GrBlack();
   
   sprintf( cab,"P4\n#" );
   fwrite( cab,1,strlen( cab ),f );
@@ -63,28 +66,20 @@ int GrSaveContextToPbm( GrContext *grc, char *pbmfn, char *docn )
   sprintf( cab,"\n%d %d\n",GrSizeX(),GrSizeY() );
   fwrite( cab,1,strlen( cab ),f );
   for( y=0; y<GrSizeY(); y++ ){
-    memcpy( pColors,GrGetScanline( 0,width-1,y ),sizeof(GrColor)*width );
-    for( x=0; x<width; x++ ){
-      if( pColors[x] == GrBlack() )
-        currentbyte |= 1 << currentbit;
-      currentbit--;
-      if( currentbit < 0 ){
-        fwrite( &currentbyte,1,1,f );
-        currentbyte = 0;
-        currentbit = 7;
-        }
-      }
-    if( currentbit < 7 ){
-      fwrite( &currentbyte,1,1,f );
-      currentbyte = 0;
-      currentbit = 7;
-      }
+    _GrPixRowGetColors( width,y,pColors );
+    memset( pRow,0,rowbytes );
+    for( x=0; x<width; x++ )
+      if( pColors[x] == black ) pRow[x >> 3] |= 0x80 >> (x & 7);
+    if( fwrite( pRow,1,rowbytes,f ) != (size_t)rowbytes ){ res = -1; goto salida; }
     }
-  free( pColors );
+
+salida:
+  if( pColors != NULL ) free( pColors );
+  if( pRow != NULL ) free( pRow );
   GrSetContext( &grcaux );
   fclose( f );
 
-  return 0;
+  return res;
 }
 
 /*
@@ -107,10 +102,11 @@ int GrSaveContextToPgm( GrContext *grc, char *pgmfn, char *docn )
   FILE *f;
   GrContext grcaux;
   char cab[81];
-  unsigned char grey;
-  int rgb[3];
+  int r, g, b;
   int x, y, width;
   GrColor *pColors = NULL;
+  unsigned char *pRow = NULL;
+  int res = 0;
 
   if( (f = fopen( pgmfn,"wb" )) == NULL ) return -1;
   
@@ -118,11 +114,8 @@ int GrSaveContextToPgm( GrContext *grc, char *pgmfn, char *docn )
   if( grc != NULL ) GrSetContext( grc );
   width = GrSizeX();
   pColors = malloc( sizeof(GrColor)*width );
-  if( pColors == NULL ){
-    GrSetContext( &grcaux );
-    fclose( f );
-    return -1;
-    }
+  pRow = malloc( width );
+  if( pColors == NULL || pRow == NULL ){ res = -1; goto salida; }
   
   sprintf( cab,"P5\n#" );
   fwrite( cab,1,strlen( cab ),f );
@@ -130,18 +123,21 @@ int GrSaveContextToPgm( GrContext *grc, char *pgmfn, char *docn )
   sprintf( cab,"\n%d %d\n255\n",GrSizeX(),GrSizeY() );
   fwrite( cab,1,strlen( cab ),f );
   for( y=0; y<GrSizeY(); y++ ) {
-    memcpy( pColors,GrGetScanline( 0,width-1,y ),sizeof(GrColor)*width );
+    _GrPixRowGetColors( width,y,pColors );
     for( x=0; x<width; x++ ){
-      GrQueryColor( pColors[x],&rgb[0],&rgb[1],&rgb[2] );
-      grey = (0.229 * rgb[0]) + (0.587 * rgb[1]) + (0.114 * rgb[2]);
-      fwrite( &grey,1,1,f );
+      _GrPixRowQueryColor( pColors[x],&r,&g,&b );
+      pRow[x] = ((229 * r) + (587 * g) + (114 * b)) / 1000;
       }
+    if( fwrite( pRow,1,width,f ) != (size_t)width ){ res = -1; goto salida; }
     }
-  free( pColors );
+
+salida:
+  if( pColors != NULL ) free( pColors );
+  if( pRow != NULL ) free( pRow );
   GrSetContext( &grcaux );
   fclose( f );
 
-  return 0;
+  return res;
 }
 
 /*
@@ -163,9 +159,10 @@ int GrSaveContextToPpm( GrContext *grc, char *ppmfn, char *docn )
   FILE *f;
   GrContext grcaux;
   char cab[81];
-  unsigned char brgb[3];
   int x, y, r, g, b, width;
   GrColor *pColors = NULL;
+  unsigned char *pRow = NULL, *pCursor;
+  int res = 0;
 
   if( (f = fopen( ppmfn,"wb" )) == NULL ) return -1;
   
@@ -173,11 +170,8 @@ int GrSaveContextToPpm( GrContext *grc, char *ppmfn, char *docn )
   if( grc != NULL ) GrSetContext( grc );
   width = GrSizeX();
   pColors = malloc( sizeof(GrColor)*width );
-  if( pColors == NULL ){
-    GrSetContext( &grcaux );
-    fclose( f );
-    return -1;
-    }
+  pRow = malloc( width * 3 );
+  if( pColors == NULL || pRow == NULL ){ res = -1; goto salida; }
   
   sprintf( cab,"P6\n#" );
   fwrite( cab,1,strlen( cab ),f );
@@ -185,18 +179,23 @@ int GrSaveContextToPpm( GrContext *grc, char *ppmfn, char *docn )
   sprintf( cab,"\n%d %d\n255\n",GrSizeX(),GrSizeY() );
   fwrite( cab,1,strlen( cab ),f );
   for( y=0; y<GrSizeY(); y++ ) {
-    memcpy( pColors,GrGetScanline( 0,width-1,y ),sizeof(GrColor)*width );
+    _GrPixRowGetColors( width,y,pColors );
+    pCursor = pRow;
     for( x=0; x<width; x++ ){
-      GrQueryColor( pColors[x],&r,&g,&b );
-      brgb[0] = r;
-      brgb[1] = g;
-      brgb[2] = b;
-      fwrite( brgb,1,3,f );
+      _GrPixRowQueryColor( pColors[x],&r,&g,&b );
+      pCursor[0] = r;
+      pCursor[1] = g;
+      pCursor[2] = b;
+      pCursor += 3;
       }
+    if( fwrite( pRow,3,width,f ) != (size_t)width ){ res = -1; goto salida; }
     }
-  free( pColors );
+
+salida:
+  if( pColors != NULL ) free( pColors );
+  if( pRow != NULL ) free( pRow );
   GrSetContext( &grcaux );
   fclose( f );
 
-  return 0;
+  return res;
 }
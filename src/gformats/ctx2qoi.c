@@ -0,0 +1,176 @@
+/**
+ ** ctx2qoi.c ---- saves a context in a QOI file
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** QOI is the "Quite OK Image" format (https://qoiformat.org), a
+ ** lossless format that needs no external library and is very fast
+ ** to encode and decode.
+ **
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "libgrx.h"
+#include "pixrow.h"
+
+#define QOI_OP_INDEX  0x00 /* 00xxxxxx */
+#define QOI_OP_DIFF   0x40 /* 01xxxxxx */
+#define QOI_OP_LUMA   0x80 /* 10xxxxxx */
+#define QOI_OP_RUN    0xc0 /* 11xxxxxx */
+#define QOI_OP_RGB    0xfe /* 11111110 */
+
+#define QOI_HASH(r,g,b) (((r)*3 + (g)*5 + (b)*7 + 255*11) & 63)
+
+typedef struct{
+  int index[64][3];  /* -1 if not used */
+  int r, g, b;  /* previous pixel */
+  int run;
+  } encoderstruct;
+
+/**/
+
+static unsigned char *putrun( encoderstruct *es, unsigned char *p )
+{
+  if( es->run > 0 ){
+    *p++ = QOI_OP_RUN | (es->run - 1);
+    es->run = 0;
+    }
+  return p;
+}
+
+/*
+** encoderow - encodes w colors, returns the number of bytes written
+** in out, that must have space for 4 bytes per pixel
+*/
+
+static int encoderow( encoderstruct *es, const GrColor *pColors, int w,
+                      unsigned char *out )
+{
+  unsigned char *p = out;
+  int x, r, g, b, h, vr, vg, vb, vgr, vgb;
+
+  for( x=0; x<w; x++ ){
+    _GrPixRowQueryColor( pColors[x],&r,&g,&b );
+    if( (r == es->r) && (g == es->g) && (b == es->b) ){
+      es->run++;
+      if( es->run == 62 ) p = putrun( es,p );
+      continue;
+      }
+    p = putrun( es,p );
+    h = QOI_HASH( r,g,b );
+    if( (es->index[h][0] == r) && (es->index[h][1] == g) &&
+        (es->index[h][2] == b) ){
+      *p++ = QOI_OP_INDEX | h;
+      }
+    else{
+      es->index[h][0] = r;
+      es->index[h][1] = g;
+      es->index[h][2] = b;
+      vr = (signed char)(r - es->r);
+      vg = (signed char)(g - es->g);
+      vb = (signed char)(b - es->b);
+      vgr = vr - vg;
+      vgb = vb - vg;
+      if( (vr > -3) && (vr < 2) && (vg > -3) && (vg < 2) &&
+          (vb > -3) && (vb < 2) ){
+        *p++ = QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+        }
+      else if( (vgr > -9) && (vgr < 8) && (vg > -33) && (vg < 32) &&
+               (vgb > -9) && (vgb < 8) ){
+        *p++ = QOI_OP_LUMA | (vg + 32);
+        *p++ = ((vgr + 8) << 4) | (vgb + 8);
+        }
+      else{
+        *p++ = QOI_OP_RGB;
+        *p++ = r;
+        *p++ = g;
+        *p++ = b;
+        }
+      }
+    es->r = r;
+    es->g = g;
+    es->b = b;
+    }
+  return p - out;
+}
+
+/*
+** GrSaveContextToQoi - Dump a context in a QOI file
+**
+** This routine works both in RGB and palette modes
+** The file is saved with three channels (no alpha)
+**
+** Arguments:
+**   grc:   Context to be saved (NULL -> use current context)
+**   qoifn: Name of qoi file
+**
+** Returns  0 on success
+**         -1 on error
+*/
+
+int GrSaveContextToQoi( GrContext *grc, char *qoifn )
+{
+  static const unsigned char padding[8] = {0,0,0,0,0,0,0,1};
+  encoderstruct es;
+  unsigned char header[14];
+  GrContext grcaux;
+  FILE *f;
+  int y, width, height, n;
+  GrColor *pColors = NULL;
+  unsigned char *pOut = NULL;
+  int res = 0;
+
+  if( (f = fopen( qoifn,"wb" )) == NULL ) return -1;
+
+  GrSaveContext( &grcaux );
+  if( grc != NULL ) GrSetContext( grc );
+  width = GrSizeX();
+  height = GrSizeY();
+  pColors = malloc( sizeof(GrColor) * width );
+  pOut = malloc( 4 * width + 2 );
+  if( pColors == NULL || pOut == NULL ){ res = -1; goto salida; }
+
+  memcpy( header,"qoif",4 );
+  header[4] = width >> 24;
+  header[5] = width >> 16;
+  header[6] = width >> 8;
+  header[7] = width;
+  header[8] = height >> 24;
+  header[9] = height >> 16;
+  header[10] = height >> 8;
+  header[11] = height;
+  header[12] = 3;  /* RGB */
+  header[13] = 0;  /* sRGB with linear alpha */
+  if( fwrite( header,1,14,f ) != 14 ){ res = -1; goto salida; }
+
+  memset( &es,0,sizeof(es) );
+  memset( es.index,0xff,sizeof(es.index) );
+  for( y=0; y<height; y++ ){
+    _GrPixRowGetColors( width,y,pColors );
+    n = encoderow( &es,pColors,width,pOut );
+    if( y == height-1 ) n = putrun( &es,pOut+n ) - pOut;
+    if( fwrite( pOut,1,n,f ) != (size_t)n ){ res = -1; goto salida; }
+    }
+  if( fwrite( padding,1,8,f ) != 8 ) res = -1;
+
+salida:
+  if( pColors != NULL ) free( pColors );
+  if( pOut != NULL ) free( pOut );
+  GrSetContext( &grcaux );
+  fclose( f );
+
+  return res;
+}
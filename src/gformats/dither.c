@@ -0,0 +1,210 @@
+/**
+ ** dither.c ---- dithering of RGB rows for the image loaders
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Used when the image has more colors than the context can show: RGB
+ ** modes with less than 8 bits per component and palette modes. The
+ ** Floyd-Steinberg errors are kept in two integer rows in 1/16 units,
+ ** rows are scanned in serpentine order.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include "libgrx.h"
+#include "pixrow.h"
+#include "dither.h"
+
+static int dithermode = GR_DITHER_NONE;
+
+static const unsigned char bayer[8][8] = {
+  {  0, 32,  8, 40,  2, 34, 10, 42 },
+  { 48, 16, 56, 24, 50, 18, 58, 26 },
+  { 12, 44,  4, 36, 14, 46,  6, 38 },
+  { 60, 28, 52, 20, 62, 30, 54, 22 },
+  {  3, 35, 11, 43,  1, 33,  9, 41 },
+  { 51, 19, 59, 27, 49, 17, 57, 25 },
+  { 15, 47,  7, 39, 13, 45,  5, 37 },
+  { 63, 31, 55, 23, 61, 29, 53, 21 }
+  };
+
+/*
+** GrSetImageDither - Set the dithering used by the image loaders
+**
+** Arguments:
+**   mode: GR_DITHER_NONE, GR_DITHER_ORDERED or GR_DITHER_FLOYD, it can
+**         be or'ed with GR_DITHER_OPTPAL to build an optimal palette
+**         for the image in palette modes (PNG and PPM loaders)
+*/
+
+void GrSetImageDither( int mode )
+{
+  dithermode = mode;
+}
+
+/*
+** GrGetImageDither - Returns the dithering used by the image loaders
+*/
+
+int GrGetImageDither( void )
+{
+  return dithermode;
+}
+
+/**/
+
+int _GrDitherInit( GrDitherState *ds, int width )
+{
+  int k, n;
+
+  ds->mode = dithermode & GR_DITHER_METHOD;
+  ds->width = width;
+  ds->y = 0;
+  ds->rgb = NULL;
+  ds->err = NULL;
+  if( CLRINFO->RGBmode && (CLRINFO->prec[0] >= 8) &&
+      (CLRINFO->prec[1] >= 8) && (CLRINFO->prec[2] >= 8) )
+    ds->mode = GR_DITHER_NONE;
+  if( ds->mode == GR_DITHER_NONE ) return 0;
+
+  if( CLRINFO->RGBmode ){
+    _GrPixRowRGBTables( ds->lut[0],ds->lut[1],ds->lut[2],NULL );
+    for( k=0; k<3; k++ )
+      ds->amp[k] = (0xff & ~CLRINFO->mask[k]) + 1;
+    }
+  else{
+    /* like a n x n x n color cube */
+    for( n=2; (n+1)*(n+1)*(n+1) <= (int)CLRINFO->ncolors; n++ );
+    ds->amp[0] = ds->amp[1] = ds->amp[2] = 255 / (n - 1);
+    }
+
+  ds->rgb = malloc( 3 * width );
+  if( ds->rgb == NULL ) return -1;
+  if( ds->mode == GR_DITHER_FLOYD ){
+    ds->err = calloc( 2 * 3 * (width + 2),sizeof(int) );
+    if( ds->err == NULL ) return -1;
+    }
+  return 0;
+}
+
+/**/
+
+void _GrDitherEnd( GrDitherState *ds )
+{
+  if( ds->rgb != NULL ) free( ds->rgb );
+  if( ds->err != NULL ) free( ds->err );
+  ds->rgb = NULL;
+  ds->err = NULL;
+}
+
+/* GrAllocColor gives up if the palette is full and there isn't a */
+/* close enough color, but the error must go somewhere            */
+
+static GrColor nearest( const int *v )
+{
+  long err, minerr = 0x7fffffffL;
+  GrColor c = GrNOCOLOR;
+  int i, dr, dg, db;
+
+  for( i=0; i<(int)CLRINFO->ncolors; i++ ){
+    if( !CLRINFO->ctable[i].defined ) continue;
+    dr = v[0] - CLRINFO->ctable[i].r;
+    dg = v[1] - CLRINFO->ctable[i].g;
+    db = v[2] - CLRINFO->ctable[i].b;
+    err = (long)dr * dr + (long)dg * dg + (long)db * db;
+    if( err < minerr ){
+      minerr = err;
+      c = i;
+      }
+    }
+  return c;
+}
+
+/* nearest color to v, v is updated to the color components */
+
+static INLINE GrColor quantize( GrDitherState *ds, int *v )
+{
+  GrColor c;
+  int k;
+
+  if( CLRINFO->RGBmode ){
+    for( k=0; k<3; k++ ){
+      if( v[k] >= (int)CLRINFO->mask[k] )
+        v[k] = CLRINFO->mask[k];
+      else
+        v[k] = (v[k] + CLRINFO->round[k]) & CLRINFO->mask[k];
+      }
+    return ds->lut[0][v[0]] | ds->lut[1][v[1]] | ds->lut[2][v[2]];
+    }
+  c = GrAllocColor( v[0],v[1],v[2] );
+  if( c == GrNOCOLOR ) c = nearest( v );
+  if( c != GrNOCOLOR ) GrQueryColor( c,&v[0],&v[1],&v[2] );
+  return c;
+}
+
+#define CLAMP(v) (((v) < 0) ? 0 : ((v) > 255) ? 255 : (v))
+
+/*
+** _GrDitherRow - converts the row in ds->rgb to colors in c
+*/
+
+void _GrDitherRow( GrDitherState *ds, GrColor *c )
+{
+  const unsigned char *p;
+  const unsigned char *t;
+  int *cur, *nxt, *e;
+  int v[3], w[3];
+  int x, n, k, d, dir;
+
+  if( ds->mode == GR_DITHER_ORDERED ){
+    t = bayer[ds->y & 7];
+    p = ds->rgb;
+    for( x=0; x<ds->width; x++, p+=3 ){
+      for( k=0; k<3; k++ ){
+        v[k] = p[k] + ((2 * t[x & 7] - 63) * ds->amp[k]) / 128;
+        v[k] = CLAMP( v[k] );
+        }
+      c[x] = quantize( ds,v );
+      }
+    ds->y++;
+    return;
+    }
+
+  /* Floyd-Steinberg */
+  n = 3 * (ds->width + 2);
+  cur = &ds->err[(ds->y & 1) * n];
+  nxt = &ds->err[((ds->y & 1) ^ 1) * n];
+  memset( nxt,0,n * sizeof(int) );
+  dir = (ds->y & 1) ? -1 : 1;
+  x = (dir > 0) ? 0 : ds->width - 1;
+  for( n=0; n<ds->width; n++, x+=dir ){
+    p = &ds->rgb[3 * x];
+    e = &cur[3 * (x + 1)];
+    for( k=0; k<3; k++ ){
+      w[k] = p[k] + ((e[k] + 8) >> 4);
+      w[k] = CLAMP( w[k] );
+      v[k] = w[k];
+      }
+    c[x] = quantize( ds,v );
+    for( k=0; k<3; k++ ){
+      d = w[k] - v[k];
+      e[3 * dir + k] += d * 7;
+      nxt[3 * (x + 1 - dir) + k] += d * 3;
+      nxt[3 * (x + 1) + k] += d * 5;
+      nxt[3 * (x + 1 + dir) + k] += d;
+      }
+    }
+  ds->y++;
+}
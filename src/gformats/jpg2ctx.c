@@ -14,13 +14,15 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, Optional dithering
  **/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <setjmp.h>
 #include <jpeglib.h>
-#include "mgrx.h"
+#include "libgrx.h"
+#include "dither.h"
 
 /*
 ** GrJpegSupport - Returns true
@@ -129,13 +131,18 @@ static int readjpeg( FILE *f, GrContext *grc, int scale )
   int row_stride;
   int maxwidth, maxheight;
   static GrColor *pColors = NULL;
-  unsigned char *pix_ptr;
+  static GrDitherState ds;
+  unsigned char *pix_ptr, *pRGB;
   int x, y, r, g, b;
 
+  pColors = NULL;
+  ds.rgb = NULL;
+  ds.err = NULL;
   cinfo.err = jpeg_std_error( &jerr.pub );
   jerr.pub.error_exit = my_error_exit;
   if( setjmp( jerr.setjmp_buffer ) ) {
     if( pColors) free( pColors );
+    _GrDitherEnd( &ds );
     jpeg_destroy_decompress( &cinfo );
     return -1;
   }
@@ -159,11 +166,27 @@ static int readjpeg( FILE *f, GrContext *grc, int scale )
              GrSizeY() : cinfo.output_height;
   pColors = malloc( maxwidth * sizeof(GrColor) );
   if( pColors == NULL ) longjmp( jerr.setjmp_buffer,1 );
+  if( _GrDitherInit( &ds,maxwidth ) != 0 ) longjmp( jerr.setjmp_buffer,1 );
 
   for( y=0; y<maxheight; y++ ){
     jpeg_read_scanlines( &cinfo,buffer,1 );
     pix_ptr = buffer[0];
-    if( cinfo.output_components == 1 ){
+    if( ds.mode != GR_DITHER_NONE ){
+      pRGB = ds.rgb;
+      for( x=0; x<maxwidth; x++ ){
+        if( cinfo.output_components == 1 ){
+          pRGB[0] = pRGB[1] = pRGB[2] = *pix_ptr++;
+          }
+        else{
+          pRGB[0] = *pix_ptr++;
+          pRGB[1] = *pix_ptr++;
+          pRGB[2] = *pix_ptr++;
+          }
+        pRGB += 3;
+        }
+      _GrDitherRow( &ds,pColors );
+      }
+    else if( cinfo.output_components == 1 ){
       for( x=0; x<maxwidth; x++ ){
         r = *pix_ptr++;
         pColors[x] = GrAllocColor( r,r,r );
@@ -182,6 +205,9 @@ static int readjpeg( FILE *f, GrContext *grc, int scale )
 
   jpeg_finish_decompress( &cinfo );
   jpeg_destroy_decompress( &cinfo );
+  _GrDitherEnd( &ds );
+  free( pColors );
+  pColors = NULL;
   
   return 0;
 }
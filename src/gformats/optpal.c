@@ -0,0 +1,167 @@
+/**
+ ** optpal.c ---- builds an optimal palette for an image
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Median cut over a 5 bits per component histogram: the box with
+ ** more pixels times its longest side is split at the median of that
+ ** side until there are enough boxes, every box gives its average
+ ** color.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include "libgrx.h"
+
+#define HBITS 5
+#define HSIZE (1 << HBITS)
+#define HIDX(r,g,b) (((r) << (2*HBITS)) | ((g) << HBITS) | (b))
+
+typedef struct{
+  int lo[3], hi[3];  /* inclusive histogram limits */
+  long count;        /* pixels in the box */
+  } colorbox;
+
+/* adjust the box limits to the used cells */
+
+static void shrinkbox( colorbox *cb, const long *hist )
+{
+  int lo[3], hi[3], v[3];
+
+  lo[0] = lo[1] = lo[2] = HSIZE;
+  hi[0] = hi[1] = hi[2] = -1;
+  cb->count = 0;
+  for( v[0]=cb->lo[0]; v[0]<=cb->hi[0]; v[0]++ )
+    for( v[1]=cb->lo[1]; v[1]<=cb->hi[1]; v[1]++ )
+      for( v[2]=cb->lo[2]; v[2]<=cb->hi[2]; v[2]++ ){
+        if( hist[HIDX( v[0],v[1],v[2] )] == 0 ) continue;
+        cb->count += hist[HIDX( v[0],v[1],v[2] )];
+        if( v[0] < lo[0] ) lo[0] = v[0];
+        if( v[0] > hi[0] ) hi[0] = v[0];
+        if( v[1] < lo[1] ) lo[1] = v[1];
+        if( v[1] > hi[1] ) hi[1] = v[1];
+        if( v[2] < lo[2] ) lo[2] = v[2];
+        if( v[2] > hi[2] ) hi[2] = v[2];
+        }
+  if( cb->count > 0 ){
+    memcpy( cb->lo,lo,sizeof(lo) );
+    memcpy( cb->hi,hi,sizeof(hi) );
+    }
+}
+
+/* split cb at the median of its longest side, the upper half goes to nb */
+
+static void splitbox( colorbox *cb, colorbox *nb, int axis, const long *hist )
+{
+  long slice[HSIZE], sum;
+  int v[3], cut;
+
+  memset( slice,0,sizeof(slice) );
+  for( v[0]=cb->lo[0]; v[0]<=cb->hi[0]; v[0]++ )
+    for( v[1]=cb->lo[1]; v[1]<=cb->hi[1]; v[1]++ )
+      for( v[2]=cb->lo[2]; v[2]<=cb->hi[2]; v[2]++ )
+        slice[v[axis]] += hist[HIDX( v[0],v[1],v[2] )];
+
+  sum = 0;
+  for( cut=cb->lo[axis]; cut<cb->hi[axis]-1; cut++ ){
+    sum += slice[cut];
+    if( sum >= cb->count / 2 ) break;
+    }
+
+  *nb = *cb;
+  cb->hi[axis] = cut;
+  nb->lo[axis] = cut + 1;
+  shrinkbox( cb,hist );
+  shrinkbox( nb,hist );
+}
+
+/*
+** GrAllocOptimalPalette - Allocates the colors that better represent
+** an image, so the image can be loaded with less error in palette
+** modes. Nothing is done in RGB modes.
+**
+** Arguments:
+**   rgb:      image pixels, 3 bytes (red, green, blue) per pixel
+**   npixels:  number of pixels
+**   ncolors:  colors to allocate, limited to the free colors
+**
+** Returns the number of colors allocated
+**         -1 on error
+*/
+
+int GrAllocOptimalPalette( const unsigned char *rgb, long npixels, int ncolors )
+{
+  colorbox *boxes = NULL;
+  long *hist = NULL;
+  long i, score, best, sr, sg, sb, n;
+  int nboxes, b, axis, bestbox, bestaxis, k, v[3];
+  int res = 0;
+
+  if( CLRINFO->RGBmode ) return 0;
+  if( ncolors > (int)GrNumFreeColors() ) ncolors = GrNumFreeColors();
+  if( (ncolors <= 0) || (npixels <= 0) ) return 0;
+
+  hist = calloc( HSIZE * HSIZE * HSIZE,sizeof(long) );
+  boxes = malloc( ncolors * sizeof(colorbox) );
+  if( (hist == NULL) || (boxes == NULL) ){ res = -1; goto salida; }
+
+  for( i=0; i<npixels; i++, rgb+=3 )
+    hist[HIDX( rgb[0] >> (8-HBITS),rgb[1] >> (8-HBITS),rgb[2] >> (8-HBITS) )]++;
+
+  boxes[0].lo[0] = boxes[0].lo[1] = boxes[0].lo[2] = 0;
+  boxes[0].hi[0] = boxes[0].hi[1] = boxes[0].hi[2] = HSIZE - 1;
+  shrinkbox( &boxes[0],hist );
+  nboxes = 1;
+
+  while( nboxes < ncolors ){
+    best = 0;
+    bestbox = bestaxis = -1;
+    for( b=0; b<nboxes; b++ ){
+      axis = 0;
+      for( k=1; k<3; k++ )
+        if( boxes[b].hi[k] - boxes[b].lo[k] >
+            boxes[b].hi[axis] - boxes[b].lo[axis] ) axis = k;
+      score = boxes[b].count * (boxes[b].hi[axis] - boxes[b].lo[axis]);
+      if( score > best ){
+        best = score;
+        bestbox = b;
+        bestaxis = axis;
+        }
+      }
+    if( bestbox < 0 ) break;  /* all boxes are a single cell */
+    splitbox( &boxes[bestbox],&boxes[nboxes],bestaxis,hist );
+    nboxes++;
+    }
+
+  for( b=0; b<nboxes; b++ ){
+    sr = sg = sb = 0;
+    for( v[0]=boxes[b].lo[0]; v[0]<=boxes[b].hi[0]; v[0]++ )
+      for( v[1]=boxes[b].lo[1]; v[1]<=boxes[b].hi[1]; v[1]++ )
+        for( v[2]=boxes[b].lo[2]; v[2]<=boxes[b].hi[2]; v[2]++ ){
+          n = hist[HIDX( v[0],v[1],v[2] )];
+          sr += n * ((v[0] << (8-HBITS)) | (v[0] >> (2*HBITS-8)));
+          sg += n * ((v[1] << (8-HBITS)) | (v[1] >> (2*HBITS-8)));
+          sb += n * ((v[2] << (8-HBITS)) | (v[2] >> (2*HBITS-8)));
+          }
+    n = boxes[b].count;
+    if( GrAllocColor( (sr + n/2) / n,(sg + n/2) / n,(sb + n/2) / n ) != GrNOCOLOR )
+      res++;
+    }
+
+salida:
+  if( hist != NULL ) free( hist );
+  if( boxes != NULL ) free( boxes );
+  return res;
+}
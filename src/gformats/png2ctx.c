@@ -15,13 +15,15 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 170320 M.Alvarez, Fix a warning in newer versions of libPNG
+ ** 261019 M.Alvarez, Optional dithering and optimal palette
  **/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <png.h>
-#include "mgrx.h"
+#include "libgrx.h"
+#include "dither.h"
 
 /*
 ** GrPngSupport - Returns true
@@ -123,6 +125,7 @@ static int readpng( FILE *f, GrContext *grc, int use_alpha )
   int alpha = 0, ro, go, bo;
   int maxwidth, maxheight;
   GrColor *pColors = NULL;
+  GrDitherState ds;
 
   /* is it a PNG file? */
   if( fread( buf,1,8,f ) != 8 ) return -1;
@@ -216,8 +219,10 @@ static int readpng( FILE *f, GrContext *grc, int use_alpha )
   maxwidth = (width > GrSizeX()) ? GrSizeX() : width;
   maxheight = (height > GrSizeY()) ? GrSizeY() : height;
 
-  pColors = malloc( maxwidth * sizeof(GrColor) );
-  if( pColors == NULL ){
+  if( _GrDitherInit( &ds,maxwidth ) != 0 ||
+      (pColors = malloc( maxwidth * sizeof(GrColor) )) == NULL ){
+    _GrDitherEnd( &ds );
+    if( pColors ) free( pColors );
     free( row_pointers );
     row_pointers = NULL;
     free( png_pixels );
@@ -225,6 +230,10 @@ static int readpng( FILE *f, GrContext *grc, int use_alpha )
     return -1;
     }
 
+  /* the whole image is here, a good time to choose the colors */
+  if( (GrGetImageDither() & GR_DITHER_OPTPAL) && !alpha_present )
+    GrAllocOptimalPalette( png_pixels,(long)width * height,GrNumFreeColors() );
+
   for( y=0; y<maxheight; y++ ){
     pix_ptr = row_pointers[y];
     if( alpha_present && use_alpha ){
@@ -251,12 +260,20 @@ static int readpng( FILE *f, GrContext *grc, int use_alpha )
             b = ((b * alpha) + (bo * ralpha)) / 255;
           }
         }
-        pColors[x] = GrAllocColor( r,g,b );
+        if( ds.mode != GR_DITHER_NONE ){
+          ds.rgb[3*x] = r;
+          ds.rgb[3*x+1] = g;
+          ds.rgb[3*x+2] = b;
+          }
+        else
+          pColors[x] = GrAllocColor( r,g,b );
         }
       }
+    if( ds.mode != GR_DITHER_NONE ) _GrDitherRow( &ds,pColors );
     GrPutScanline( 0,maxwidth-1,y,pColors,GrWRITE );
     }
 
+  _GrDitherEnd( &ds );
   if( pColors) free( pColors );
   if( row_pointers ) free( row_pointers );
   if( png_pixels ) free( png_pixels );
@@ -17,32 +17,49 @@
  ** Contributions by Josu Onandia (jonandia@fagorautomation.es) 10/03/2001
  **   _GrLoadContextFromPpm optimized (applied to Pbm and Pgm too)
  **
+ ** 261019 Files are mmaped when possible and rows converted directly from
+ **        the input bytes with precalculated color tables, RAM frames
+ **        are written directly without the frame driver
+ ** 261019 Optional dithering and optimal palette
+ **
  **/
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include "mgrx.h"
+#include "libgrx.h"
+#include "pixrow.h"
+#include "dither.h"
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP
+#endif
 
 typedef struct{
-  int method;  /* 0=file, 1=buffer */
+  int method;  /* 0=file, 1=buffer, 2=mapped file */
   FILE *file;
   const char *buffer;
-  int bufferpointer;
+  long bufferpointer;
+  long buffersize;  /* only checked for mapped files */
+  unsigned char *rowbuf;  /* row buffer for the file method */
   } inputstruct;
 
-/**/
 
 static size_t inputread( void *buffer, size_t size, size_t number,
                          inputstruct *is )
 {
   if( is->method == 0 )
     return fread( buffer,size,number,is->file );
-  else{
-    memcpy( buffer,&(is->buffer[is->bufferpointer]),size*number );
-    is->bufferpointer += size * number;
-    return number;
-    }
+  if( (is->method == 2) &&
+      (is->bufferpointer + (long)(size*number) > is->buffersize) )
+    return 0;
+  memcpy( buffer,&(is->buffer[is->bufferpointer]),size*number );
+  is->bufferpointer += size * number;
+  return number;
 }
 
 /**/
@@ -51,8 +68,9 @@ static int inputgetc( inputstruct *is )
 {
   if( is->method == 0 )
     return fgetc( is->file );
-  else
-    return is->buffer[is->bufferpointer++];
+  if( (is->method == 2) && (is->bufferpointer >= is->buffersize) )
+    return EOF;
+  return is->buffer[is->bufferpointer++];
 }
 
 /**/
@@ -67,6 +85,27 @@ int inputungetc( int c, inputstruct *is )
     }
 }
 
+/*
+** inputrow - returns a pointer to the next size bytes of input,
+** directly into the buffer (or mapped file) when possible, so
+** rows are converted without an intermediate copy
+*/
+
+static const unsigned char *inputrow( inputstruct *is, int size )
+{
+  const unsigned char *p;
+
+  if( is->method == 0 ){
+    if( fread( is->rowbuf,1,size,is->file ) != (size_t)size ) return NULL;
+    return is->rowbuf;
+    }
+  if( (is->method == 2) && (is->bufferpointer + size > is->buffersize) )
+    return NULL;
+  p = (const unsigned char *)&(is->buffer[is->bufferpointer]);
+  is->bufferpointer += size;
+  return p;
+}
+
 /**/
 
 static int skipspaces( inputstruct *is )
@@ -135,42 +174,56 @@ static int loaddata( inputstruct *is, int *width, int *height, int *maxval )
 
 /**/
 
+/*
+** scaletable - component value scale table for maxval < 255
+*/
+
+static void scaletable( unsigned char *scale, int maxval )
+{
+  int i, v;
+
+  for( i=0; i<256; i++ ){
+    v = (maxval > 0) ? (i * 255) / maxval : 0;
+    scale[i] = (v > 255) ? 255 : v;
+    }
+}
+
+/**/
+
 static int _GrLoadContextFromPbm( inputstruct *is, int width, int height )
 {
   int x, y;
   int maxwidth, maxheight;
-  GrColor color;
-  int currentbyte, isbyteread = 0;
-  int currentbit = 0;
+  GrColor black, white;
+  const unsigned char *pRow;
   GrColor *pColors=NULL;
+  GrPixRowOutput os;
   int res = 0;
 
   maxwidth = (width > GrSizeX()) ? GrSizeX() : width;
   maxheight = (height > GrSizeY()) ? GrSizeY() : height;
+  _GrPixRowSetOutput( &os );
+  black = GrBlack();
+  white = GrWhite();
 
   pColors = malloc( maxwidth * sizeof(GrColor) );
   if(pColors == NULL) { res = -1; goto salida; }
+  if( is->method == 0 ){
+    is->rowbuf = malloc( (width + 7) / 8 );
+    if(is->rowbuf == NULL) { res = -1; goto salida; }
+    }
 
   for( y=0; y<maxheight; y++ ){
-    for( x=0; x<width; x++ ){
-      if( !isbyteread ){
-        if( inputread( &currentbyte,1,1,is ) != 1 ) { res = -1; goto salida; }
-        isbyteread = 1;
-        currentbit = 7;
-        }
-      if( x < maxwidth ){
-        color = currentbyte & (1 << currentbit) ? GrBlack() : GrWhite();
-        pColors[x] = color;
-        }
-      currentbit--;
-      if( currentbit < 0 ) isbyteread = 0;
-      }
-    GrPutScanline( 0,maxwidth-1,y,pColors,GrWRITE );
-    isbyteread = 0;
+    if( (pRow = inputrow( is,(width + 7) / 8 )) == NULL ) { res = -1; goto salida; }
+    for( x=0; x<maxwidth; x++ )
+      pColors[x] = (pRow[x >> 3] & (0x80 >> (x & 7))) ? black : white;
+    _GrPixRowPutColors( &os,maxwidth,y,pColors );
     }
 
 salida:
   if( pColors != NULL ) free( pColors );
+  if( is->rowbuf != NULL ) free( is->rowbuf );
+  is->rowbuf = NULL;
   return res;
 }
 
@@ -179,43 +232,56 @@ salida:
 static int _GrLoadContextFromPgm( inputstruct *is, int width,
                                   int height, int maxval )
 {
-  int x, y;
-  int needcoloradjust = 0;
+  int i, x, y;
   int maxwidth, maxheight;
-  double coloradjust = 255.0;
+  unsigned char scale[256];
+  GrColor grays[256];
+  const unsigned char *pRow;
   GrColor *pColors=NULL;
-  unsigned char *pData=NULL, *pCursor;
+  GrPixRowOutput os;
+  GrDitherState ds;
   int res = 0;
 
   maxwidth = (width > GrSizeX()) ? GrSizeX() : width;
   maxheight = (height > GrSizeY()) ? GrSizeY() : height;
+  _GrPixRowSetOutput( &os );
+  scaletable( scale,maxval );
+  if( _GrDitherInit( &ds,maxwidth ) != 0 ) { res = -1; goto salida; }
 
-  if( maxval < 255 ){
-    needcoloradjust = 1;
-    coloradjust = 255.0 / maxval;
-    }
+  /* in RGB mode all the grays are known, in palette mode they
+     are allocated the first time they are used */
+  for( i=0; i<256; i++ )
+    grays[i] = CLRINFO->RGBmode ? GrAllocColor( scale[i],scale[i],scale[i] )
+                                : GrNOCOLOR;
 
-  pData = NULL;
   pColors = malloc( maxwidth * sizeof(GrColor) );
   if(pColors == NULL) { res = -1; goto salida; }
-  pData = malloc( width * sizeof(char) );
-  if(pData == NULL) { res = -1; goto salida; }
+  if( is->method == 0 ){
+    is->rowbuf = malloc( width );
+    if(is->rowbuf == NULL) { res = -1; goto salida; }
+    }
 
   for( y=0; y<maxheight; y++ ){
-    if( inputread( pData,1,width,is ) != width ) { res = -1; goto salida; }
-    pCursor = pData;
-    for( x=0; x<maxwidth; x++ ){
-      if( needcoloradjust )
-        *pCursor *= coloradjust;
-      pColors[x] = GrAllocColor( *pCursor,*pCursor,*pCursor );
-      pCursor += 1;
+    if( (pRow = inputrow( is,width )) == NULL ) { res = -1; goto salida; }
+    if( ds.mode != GR_DITHER_NONE ){
+      for( x=0; x<maxwidth; x++ )
+        ds.rgb[3*x] = ds.rgb[3*x+1] = ds.rgb[3*x+2] = scale[pRow[x]];
+      _GrDitherRow( &ds,pColors );
+      }
+    else for( x=0; x<maxwidth; x++ ){
+      if( grays[pRow[x]] == GrNOCOLOR )
+        grays[pRow[x]] = GrAllocColor( scale[pRow[x]],scale[pRow[x]],
+                                       scale[pRow[x]] );
+      pColors[x] = grays[pRow[x]];
       }
-    GrPutScanline( 0,maxwidth-1,y,pColors,GrWRITE );
+    _GrPixRowPutColors( &os,maxwidth,y,pColors );
     }
 
 salida:
+  _GrDitherEnd( &ds );
   if( pColors != NULL ) free( pColors );
-  if( pData != NULL ) free( pData );
+  if( is->rowbuf != NULL ) free( is->rowbuf );
+  is->rowbuf = NULL;
   return res;
 }
 
@@ -225,48 +291,90 @@ static int _GrLoadContextFromPpm( inputstruct *is, int width,
                                   int height, int maxval )
 {
   int x, y;
-  int needcoloradjust = 0;
   int maxwidth, maxheight;
-  double coloradjust = 255.0;
+  unsigned char scale[256];
+  GrColor lutr[256], lutg[256], lutb[256];
+  const unsigned char *pRow, *pCursor;
+  unsigned char *pRGB;
   GrColor *pColors=NULL;
-  unsigned char *pRGB=NULL, *pCursor;
+  GrPixRowOutput os;
+  GrDitherState ds;
   int res = 0;
 
   maxwidth = (width > GrSizeX()) ? GrSizeX() : width;
   maxheight = (height > GrSizeY()) ? GrSizeY() : height;
+  _GrPixRowSetOutput( &os );
+  scaletable( scale,maxval );
+  if( _GrDitherInit( &ds,maxwidth ) != 0 ) { res = -1; goto salida; }
 
-  if( maxval < 255 ){
-    needcoloradjust = 1;
-    coloradjust = 255.0 / maxval;
-    }
+  /* with a buffer or mapped file the whole image is available */
+  if( (GrGetImageDither() & GR_DITHER_OPTPAL) && (is->method != 0) &&
+      (maxval == 255) && ((is->method != 2) ||
+      (is->bufferpointer + 3L * width * height <= is->buffersize)) )
+    GrAllocOptimalPalette( (const unsigned char *)&is->buffer[is->bufferpointer],
+                           (long)width * height,GrNumFreeColors() );
+
+  if( CLRINFO->RGBmode )
+    _GrPixRowRGBTables( lutr,lutg,lutb,scale );
 
-  pRGB = NULL;
   pColors = malloc( maxwidth * sizeof(GrColor) );
   if(pColors == NULL) { res = -1; goto salida; }
-  pRGB = malloc( width * 3 * sizeof(char) );
-  if(pRGB == NULL) { res = -1; goto salida; }
+  if( is->method == 0 ){
+    is->rowbuf = malloc( width * 3 );
+    if(is->rowbuf == NULL) { res = -1; goto salida; }
+    }
 
   for( y=0; y<maxheight; y++ ){
-    if( inputread( pRGB,3,width,is ) != width ) { res = -1; goto salida; }
-    pCursor = pRGB;
-    for( x=0; x<maxwidth; x++ ){
-      if( needcoloradjust ){
-        pCursor[0] *= coloradjust;
-        pCursor[1] *= coloradjust;
-        pCursor[2] *= coloradjust;
+    if( (pRow = inputrow( is,width * 3 )) == NULL ) { res = -1; goto salida; }
+    pCursor = pRow;
+    if( ds.mode != GR_DITHER_NONE ){
+      pRGB = ds.rgb;
+      for( x=0; x<3*maxwidth; x++ )
+        *pRGB++ = scale[*pCursor++];
+      _GrDitherRow( &ds,pColors );
+      }
+    else if( CLRINFO->RGBmode ){
+      for( x=0; x<maxwidth; x++ ){
+        pColors[x] = lutr[pCursor[0]] | lutg[pCursor[1]] | lutb[pCursor[2]];
+        pCursor += 3;
         }
-      pColors[x] = GrAllocColor( pCursor[0],pCursor[1],pCursor[2] );
-      pCursor += 3;
       }
-    GrPutScanline( 0,maxwidth-1,y,pColors,GrWRITE );
+    else{
+      for( x=0; x<maxwidth; x++ ){
+        pColors[x] = GrAllocColor( scale[pCursor[0]],scale[pCursor[1]],
+                                   scale[pCursor[2]] );
+        pCursor += 3;
+        }
+      }
+    _GrPixRowPutColors( &os,maxwidth,y,pColors );
     }
 
 salida:
+  _GrDitherEnd( &ds );
   if( pColors != NULL ) free( pColors );
-  if( pRGB != NULL ) free( pRGB );
+  if( is->rowbuf != NULL ) free( is->rowbuf );
+  is->rowbuf = NULL;
   return res;
 }
 
+/**/
+
+static int _GrLoadContextFromPnmInput( inputstruct *is )
+{
+  int format, width, height, maxval;
+
+  format = loaddata( is,&width,&height,&maxval );
+  if( maxval > 255 ) return -1;
+  if( (format < PBMFORMAT) || (format > PPMFORMAT) ) return -1;
+
+  switch( format ){
+    case PBMFORMAT: return _GrLoadContextFromPbm( is,width,height );
+    case PGMFORMAT: return _GrLoadContextFromPgm( is,width,height,maxval );
+    case PPMFORMAT: return _GrLoadContextFromPpm( is,width,height,maxval );
+    }
+  return -1;
+}
+
 /*
 ** GrLoadContextFromPnm - Load a context from a PNM file
 **
@@ -288,31 +396,39 @@ salida:
 
 int GrLoadContextFromPnm( GrContext *grc, char *pnmfn )
 {
-  inputstruct is = {0, NULL, NULL, 0};
+  inputstruct is = {0, NULL, NULL, 0, 0, NULL};
   GrContext grcaux;
-  int r = -1;
-  int format, width, height, maxval;
+  int r;
+#ifdef HAVE_MMAP
+  struct stat st;
+  void *map = MAP_FAILED;
+#endif
 
   if( (is.file = fopen( pnmfn,"rb" )) == NULL ) return -1;
 
+#ifdef HAVE_MMAP
+  /* map the file if possible, so rows are converted directly
+     from the mapped bytes, else fall back to stdio */
+  if( (fstat( fileno( is.file ),&st ) == 0) && (st.st_size > 0) ){
+    map = mmap( NULL,st.st_size,PROT_READ,MAP_PRIVATE,fileno( is.file ),0 );
+    if( map != MAP_FAILED ){
+      madvise( map,st.st_size,MADV_SEQUENTIAL );
+      is.method = 2;
+      is.buffer = map;
+      is.buffersize = st.st_size;
+      }
+    }
+#endif
+
   GrSaveContext( &grcaux );
   if( grc != NULL ) GrSetContext( grc );
 
-  format = loaddata( &is,&width,&height,&maxval );
-  if( maxval > 255 ) goto ENDFUNCTION;
-  if( (format < PBMFORMAT) || (format > PPMFORMAT) ) goto ENDFUNCTION;
-
-  switch( format ){
-    case PBMFORMAT: r = _GrLoadContextFromPbm( &is,width,height );
-                    break;
-    case PGMFORMAT: r = _GrLoadContextFromPgm( &is,width,height,maxval );
-                    break;
-    case PPMFORMAT: r = _GrLoadContextFromPpm( &is,width,height,maxval );
-                    break;
-    }
+  r = _GrLoadContextFromPnmInput( &is );
 
-ENDFUNCTION:
   GrSetContext( &grcaux );
+#ifdef HAVE_MMAP
+  if( map != MAP_FAILED ) munmap( map,st.st_size );
+#endif
   fclose( is.file );
 
   return r;
@@ -333,7 +449,7 @@ ENDFUNCTION:
 
 int GrQueryPnm( char *pnmfn, int *width, int *height, int *maxval )
 {
-  inputstruct is = {0, NULL, NULL, 0};
+  inputstruct is = {0, NULL, NULL, 0, 0, NULL};
   int r;
 
   if( (is.file = fopen( pnmfn,"rb" )) == NULL ) return -1;
@@ -366,30 +482,17 @@ int GrQueryPnm( char *pnmfn, int *width, int *height, int *maxval )
 
 int GrLoadContextFromPnmBuffer( GrContext *grc, const char *pnmbuf )
 {
-  inputstruct is = {1, NULL, NULL, 0};
+  inputstruct is = {1, NULL, NULL, 0, 0, NULL};
   GrContext grcaux;
-  int r = -1;
-  int format, width, height, maxval;
+  int r;
 
   is.buffer = pnmbuf;
   
   GrSaveContext( &grcaux );
   if( grc != NULL ) GrSetContext( grc );
 
-  format = loaddata( &is,&width,&height,&maxval );
-  if( maxval > 255 ) goto ENDFUNCTION;
-  if( (format < PBMFORMAT) || (format > PPMFORMAT) ) goto ENDFUNCTION;
-
-  switch( format ){
-    case PBMFORMAT: r = _GrLoadContextFromPbm( &is,width,height );
-                    break;
-    case PGMFORMAT: r = _GrLoadContextFromPgm( &is,width,height,maxval );
-                    break;
-    case PPMFORMAT: r = _GrLoadContextFromPpm( &is,width,height,maxval );
-                    break;
-    }
+  r = _GrLoadContextFromPnmInput( &is );
 
-ENDFUNCTION:
   GrSetContext( &grcaux );
 
   return r;
@@ -410,7 +513,7 @@ ENDFUNCTION:
 
 int GrQueryPnmBuffer( const char *pnmbuf, int *width, int *height, int *maxval )
 {
-  inputstruct is = {1, NULL, NULL, 0};
+  inputstruct is = {1, NULL, NULL, 0, 0, NULL};
   int r;
 
   is.buffer = pnmbuf;
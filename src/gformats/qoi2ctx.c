@@ -0,0 +1,343 @@
+/**
+ ** qoi2ctx.c ---- loads a context from a QOI file or QOI buffer
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** QOI is the "Quite OK Image" format (https://qoiformat.org), a
+ ** lossless format that needs no external library and is very fast
+ ** to encode and decode.
+ **
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "libgrx.h"
+#include "pixrow.h"
+#include "dither.h"
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP
+#endif
+
+#define QOI_OP_INDEX  0x00 /* 00xxxxxx */
+#define QOI_OP_DIFF   0x40 /* 01xxxxxx */
+#define QOI_OP_LUMA   0x80 /* 10xxxxxx */
+#define QOI_OP_RUN    0xc0 /* 11xxxxxx */
+#define QOI_OP_RGB    0xfe /* 11111110 */
+#define QOI_OP_RGBA   0xff /* 11111111 */
+#define QOI_MASK_2    0xc0 /* 11000000 */
+
+#define QOI_HEADER_SIZE 14
+#define QOI_HASH(p) (((p)[0]*3 + (p)[1]*5 + (p)[2]*7 + (p)[3]*11) & 63)
+
+typedef struct{
+  const unsigned char *buffer;
+  long pointer;
+  long size;  /* < 0 if unknown (buffer method) */
+  } inputstruct;
+
+/**/
+
+static int readbyte( inputstruct *is )
+{
+  if( (is->size >= 0) && (is->pointer >= is->size) ) return -1;
+  return is->buffer[is->pointer++];
+}
+
+/**/
+
+static int loadheader( inputstruct *is, int *width, int *height )
+{
+  const unsigned char *p;
+  unsigned long w, h;
+
+  if( (is->size >= 0) && (is->size < QOI_HEADER_SIZE) ) return -1;
+  p = is->buffer;
+  if( memcmp( p,"qoif",4 ) != 0 ) return -1;
+  w = ((unsigned long)p[4] << 24) | (p[5] << 16) | (p[6] << 8) | p[7];
+  h = ((unsigned long)p[8] << 24) | (p[9] << 16) | (p[10] << 8) | p[11];
+  if( (p[12] < 3) || (p[12] > 4) || (p[13] > 1) ) return -1;
+  if( (w == 0) || (h == 0) || (w > 32767) || (h > 32767) ) return -1;
+  *width = w;
+  *height = h;
+  is->pointer = QOI_HEADER_SIZE;
+  return 0;
+}
+
+/**/
+
+static int _GrLoadContextFromQoi( inputstruct *is, int use_alpha )
+{
+  unsigned char index[64][4];
+  unsigned char px[4], pxold[3];
+  int width, height, maxwidth, maxheight;
+  int x, y, run, b1, b2, vg, valid;
+  int r, g, b, ro, go, bo;
+  GrColor lutr[256], lutg[256], lutb[256];
+  GrColor color = 0, *pColors = NULL;
+  GrPixRowOutput os;
+  GrDitherState ds;
+  int res = 0;
+
+  if( loadheader( is,&width,&height ) != 0 ) return -1;
+
+  maxwidth = (width > GrSizeX()) ? GrSizeX() : width;
+  maxheight = (height > GrSizeY()) ? GrSizeY() : height;
+  _GrPixRowSetOutput( &os );
+  if( CLRINFO->RGBmode )
+    _GrPixRowRGBTables( lutr,lutg,lutb,NULL );
+
+  if( _GrDitherInit( &ds,maxwidth ) != 0 ) { res = -1; goto salida; }
+  pColors = malloc( maxwidth * sizeof(GrColor) );
+  if( pColors == NULL ) { res = -1; goto salida; }
+
+  memset( index,0,sizeof(index) );
+  px[0] = px[1] = px[2] = 0;
+  px[3] = 255;
+  valid = 0;
+  run = 0;
+
+  for( y=0; y<maxheight; y++ ){
+    if( use_alpha ) _GrPixRowGetColors( maxwidth,y,pColors );
+    for( x=0; x<width; x++ ){
+      if( run > 0 )
+        run--;
+      else{
+        if( (b1 = readbyte( is )) < 0 ) { res = -1; goto salida; }
+        if( b1 == QOI_OP_RGB ){
+          if( (r = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          if( (g = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          if( (b = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          px[0] = r; px[1] = g; px[2] = b;
+          }
+        else if( b1 == QOI_OP_RGBA ){
+          if( (r = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          if( (g = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          if( (b = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          if( (b2 = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          px[0] = r; px[1] = g; px[2] = b; px[3] = b2;
+          }
+        else if( (b1 & QOI_MASK_2) == QOI_OP_INDEX ){
+          memcpy( px,index[b1],4 );
+          }
+        else if( (b1 & QOI_MASK_2) == QOI_OP_DIFF ){
+          px[0] += ((b1 >> 4) & 0x03) - 2;
+          px[1] += ((b1 >> 2) & 0x03) - 2;
+          px[2] += ( b1       & 0x03) - 2;
+          }
+        else if( (b1 & QOI_MASK_2) == QOI_OP_LUMA ){
+          if( (b2 = readbyte( is )) < 0 ) { res = -1; goto salida; }
+          vg = (b1 & 0x3f) - 32;
+          px[0] += vg - 8 + ((b2 >> 4) & 0x0f);
+          px[1] += vg;
+          px[2] += vg - 8 +  (b2       & 0x0f);
+          }
+        else if( (b1 & QOI_MASK_2) == QOI_OP_RUN ){
+          run = (b1 & 0x3f);
+          }
+        memcpy( index[QOI_HASH( px )],px,4 );
+        }
+      if( x >= maxwidth ) continue;
+      if( ds.mode != GR_DITHER_NONE ){
+        r = px[0];
+        g = px[1];
+        b = px[2];
+        if( use_alpha && (px[3] != 255) ){
+          _GrPixRowQueryColor( pColors[x],&ro,&go,&bo );
+          r = ((px[0] * px[3]) + (ro * (255 - px[3]))) / 255;
+          g = ((px[1] * px[3]) + (go * (255 - px[3]))) / 255;
+          b = ((px[2] * px[3]) + (bo * (255 - px[3]))) / 255;
+          }
+        ds.rgb[3*x] = r;
+        ds.rgb[3*x+1] = g;
+        ds.rgb[3*x+2] = b;
+        continue;
+        }
+      if( use_alpha && (px[3] != 255) ){
+        if( px[3] == 0 ) continue;
+        _GrPixRowQueryColor( pColors[x],&ro,&go,&bo );
+        r = ((px[0] * px[3]) + (ro * (255 - px[3]))) / 255;
+        g = ((px[1] * px[3]) + (go * (255 - px[3]))) / 255;
+        b = ((px[2] * px[3]) + (bo * (255 - px[3]))) / 255;
+        pColors[x] = GrAllocColor( r,g,b );
+        continue;
+        }
+      /* runs and repeated pixels reuse the last color */
+      if( !valid || (memcmp( px,pxold,3 ) != 0) ){
+        if( CLRINFO->RGBmode )
+          color = lutr[px[0]] | lutg[px[1]] | lutb[px[2]];
+        else
+          color = GrAllocColor( px[0],px[1],px[2] );
+        memcpy( pxold,px,3 );
+        valid = 1;
+        }
+      pColors[x] = color;
+      }
+    if( ds.mode != GR_DITHER_NONE ) _GrDitherRow( &ds,pColors );
+    _GrPixRowPutColors( &os,maxwidth,y,pColors );
+    }
+
+salida:
+  _GrDitherEnd( &ds );
+  free( pColors );
+  return res;
+}
+
+/*
+** GrLoadContextFromQoi - Load a context from a QOI file
+**
+** If context dimensions are lesser than qoi dimensions,
+** the routine loads as much as it can
+**
+** If color mode is not in RGB mode, the routine allocates as
+** much colors as it can
+**
+** Arguments:
+**   grc:       Context to be loaded (NULL -> use current context)
+**   qoifn:     Name of qoi file
+**   use_alpha: if true, use alpha channel if available
+**
+** Returns  0 on success
+**         -1 on error
+*/
+
+int GrLoadContextFromQoi( GrContext *grc, char *qoifn, int use_alpha )
+{
+  inputstruct is = {NULL, 0, 0};
+  GrContext grcaux;
+  unsigned char *data = NULL;
+  FILE *f;
+  long size = 0;
+  int r = -1;
+#ifdef HAVE_MMAP
+  void *map = MAP_FAILED;
+#endif
+
+  if( (f = fopen( qoifn,"rb" )) == NULL ) return -1;
+  if( fseek( f,0,SEEK_END ) != 0 ) goto ENDFUNCTION;
+  if( (size = ftell( f )) <= 0 ) goto ENDFUNCTION;
+  rewind( f );
+
+#ifdef HAVE_MMAP
+  map = mmap( NULL,size,PROT_READ,MAP_PRIVATE,fileno( f ),0 );
+  if( map != MAP_FAILED ){
+    madvise( map,size,MADV_SEQUENTIAL );
+    is.buffer = map;
+    }
+#endif
+  if( is.buffer == NULL ){
+    if( (data = malloc( size )) == NULL ) goto ENDFUNCTION;
+    if( fread( data,1,size,f ) != (size_t)size ) goto ENDFUNCTION;
+    is.buffer = data;
+    }
+  is.size = size;
+
+  GrSaveContext( &grcaux );
+  if( grc != NULL ) GrSetContext( grc );
+  r = _GrLoadContextFromQoi( &is,use_alpha );
+  GrSetContext( &grcaux );
+
+ENDFUNCTION:
+#ifdef HAVE_MMAP
+  if( map != MAP_FAILED ) munmap( map,size );
+#endif
+  if( data != NULL ) free( data );
+  fclose( f );
+
+  return r;
+}
+
+/*
+** GrQueryQoi - Query width and height data from a QOI file
+**
+** Arguments:
+**   qoifn:   Name of qoi file
+**   width:   return qoi width
+**   height:  return qoi height
+**
+** Returns  0 on success
+**         -1 on error
+*/
+
+int GrQueryQoi( char *qoifn, int *width, int *height )
+{
+  inputstruct is = {NULL, 0, 0};
+  unsigned char header[QOI_HEADER_SIZE];
+  FILE *f;
+  int r;
+
+  if( (f = fopen( qoifn,"rb" )) == NULL ) return -1;
+  is.size = fread( header,1,QOI_HEADER_SIZE,f );
+  is.buffer = header;
+  r = loadheader( &is,width,height );
+  fclose( f );
+
+  return r;
+}
+
+/*
+** GrLoadContextFromQoiBuffer - Load a context from a QOI buffer
+**
+** Like GrLoadContextFromQoi, but the data is read from a buffer
+**
+** Arguments:
+**   grc:       Context to be loaded (NULL -> use current context)
+**   qoibuf:    Buffer that holds data
+**   use_alpha: if true, use alpha channel if available
+**
+** Returns  0 on success
+**         -1 on error
+*/
+
+int GrLoadContextFromQoiBuffer( GrContext *grc, const char *qoibuf, int use_alpha )
+{
+  inputstruct is = {NULL, 0, -1};
+  GrContext grcaux;
+  int r;
+
+  is.buffer = (const unsigned char *)qoibuf;
+
+  GrSaveContext( &grcaux );
+  if( grc != NULL ) GrSetContext( grc );
+  r = _GrLoadContextFromQoi( &is,use_alpha );
+  GrSetContext( &grcaux );
+
+  return r;
+}
+
+/*
+** GrQueryQoiBuffer - Query width and height data from a QOI buffer
+**
+** Arguments:
+**   qoibuf:  Buffer that holds data
+**   width:   return qoi width
+**   height:  return qoi height
+**
+** Returns  0 on success
+**         -1 on error
+*/
+
+int GrQueryQoiBuffer( const char *qoibuf, int *width, int *height )
+{
+  inputstruct is = {NULL, 0, -1};
+
+  is.buffer = (const unsigned char *)qoibuf;
+
+  return loadheader( &is,width,height );
+}
@@ -152,12 +152,32 @@ void GUIGroupRestartAfterVisibleChanges(GUIGroup *g)
 
 void GUIGroupPaint(GUIGroup *g)
 {
-    int i;
+    GUIObject *o;
+    int i, x1, y1, x2, y2, n = 0;
+
+    /* hide the mouse cursor once for all the visible objects */
+    x1 = y1 = x2 = y2 = 0;
+    for (i=0; i<g->nobj; i++) {
+        o = &(g->o[i]);
+        if (!o->visible) continue;
+        if (n++ == 0) {
+            x1 = o->x; y1 = o->y;
+            x2 = o->x + o->width - 1; y2 = o->y + o->height - 1;
+            continue;
+        }
+        if (o->x < x1) x1 = o->x;
+        if (o->y < y1) y1 = o->y;
+        if (o->x + o->width - 1 > x2) x2 = o->x + o->width - 1;
+        if (o->y + o->height - 1 > y2) y2 = o->y + o->height - 1;
+    }
+    if (n == 0) return;
 
+    GrMouseBeginBatch(NULL, g->x+x1, g->y+y1, g->x+x2, g->y+y2);
     for (i=0; i<g->nobj; i++) {
         if (g->o[i].visible)
             _GUIObjectPaint(&(g->o[i]), g->x, g->y);
     }
+    GrMouseEndBatch();
 }
 
 /***************************/
@@ -159,14 +159,13 @@ static void dboton(int x, int y, int an, int al, GrColor c, GrColor ct,
 {
     int pol[7][2], prof;
     GrLineOption glo;
-    int mouseblock;
     GrColor caux, ctdim;
     long lctdim;
     int iaux;
 
     prof = (pulsd) ? 2 : 4;
 
-    mouseblock = GrMouseBlock(NULL, x, y, x+an-1, y+al-1);
+    GrMouseBeginBatch(NULL, x, y, x+an-1, y+al-1);
     GrBox(x, y, x+an-1, y+al-1, _objectlcolor);
     x = x + 1; y = y + 1;
     an = an - 2; al = al - 2;
@@ -218,5 +217,5 @@ static void dboton(int x, int y, int an, int al, GrColor c, GrColor ct,
         GrCustomBox(x+2+prof, y+2+prof, x+an-3-prof, y+al-3-prof, &glo);
     }
 
-    GrMouseUnBlock(mouseblock);
+    GrMouseEndBatch();
 }
@@ -126,7 +126,6 @@ void _GUIODListDestroy(GUIObject *o)
 void _GUIODListPaint(GUIObject *o, int dx, int dy)
 {
     DListData *data;
-    int mouseblock;
     int x, y;
     
     data = (DListData *)(o->data);
@@ -134,12 +133,12 @@ void _GUIODListPaint(GUIObject *o, int dx, int dy)
     x = o->x + dx;
     y = o->y + dy;
 
-    mouseblock = GrMouseBlock(NULL, x, y, x+o->width-1, y+o->height-1);
+    GrMouseBeginBatch(NULL, x, y, x+o->width-1, y+o->height-1);
 
     GUIRDLSetSelected(data->rdl, o->selected, 0, 0);
     GUIRDLPaint(data->rdl, dx, dy, 0);
 
-    GrMouseUnBlock(mouseblock);
+    GrMouseEndBatch();
 }
 
 /***************************/
@@ -150,7 +150,6 @@ void _GUIOEditSetText(GUIObject *o, void *newtext)
 void _GUIOEditPaint(GUIObject *o, int dx, int dy)
 {
     EditData *data;
-    int mouseblock;
     int x, y;
     GrLineOption glo;
     
@@ -159,7 +158,7 @@ void _GUIOEditPaint(GUIObject *o, int dx, int dy)
     x = o->x + dx;
     y = o->y + dy;
 
-    mouseblock = GrMouseBlock(NULL, x, y, x+o->width-1, y+o->height-1);
+    GrMouseBeginBatch(NULL, x, y, x+o->width-1, y+o->height-1);
 
     GrBox(x, y, x+o->width-1, y+o->height-1, o->fg);
     GrFilledBox(x+1, y+1, x+o->width-2, y+o->height-2, o->bg);
@@ -194,7 +193,7 @@ void _GUIOEditPaint(GUIObject *o, int dx, int dy)
         else GUIRTEHideTcursor(data->rte);
     }
 
-    GrMouseUnBlock(mouseblock);
+    GrMouseEndBatch();
 
     if (!o->selected && GUIRTEGetChanged(data->rte)) {
         GrEventParEnqueue(GREV_FCHANGE, o->id, 0, 0, 0);
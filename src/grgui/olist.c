@@ -145,14 +145,13 @@ void _GUIOListPaint(GUIObject *o, int dx, int dy)
     ListData *data;
     GrLineOption glo;
     int midx, midy, tri[3][2];
-    int mouseblock;
     int x, y;
     
     data = (ListData *)(o->data);
     x = o->x + dx;
     y = o->y + dy;
 
-    mouseblock = GrMouseBlock(NULL, x, y, x+o->width-1, y+o->height-1);
+    GrMouseBeginBatch(NULL, x, y, x+o->width-1, y+o->height-1);
 
     GrBox(x, y, x+o->width-1-SELECTWIDTH, y+o->height-1, _objectlcolor);
     GrFilledBox(x+1, y+1, x+o->width-2-SELECTWIDTH, y+o->height-2, o->bg);
@@ -197,7 +196,7 @@ void _GUIOListPaint(GUIObject *o, int dx, int dy)
         GrResetClipBox();
     }
  
-    GrMouseUnBlock(mouseblock);
+    GrMouseEndBatch();
 }
 
 /***************************/
@@ -103,7 +103,6 @@ void _GUIORegListDestroy(GUIObject *o)
 void _GUIORegListPaint(GUIObject *o, int dx, int dy)
 {
     RegListData *data;
-    int mouseblock;
     int x, y;
     
     data = (RegListData *)(o->data);
@@ -111,12 +110,12 @@ void _GUIORegListPaint(GUIObject *o, int dx, int dy)
     x = o->x + dx;
     y = o->y + dy;
 
-    mouseblock = GrMouseBlock(NULL, x, y, x+o->width-1, y+o->height-1);
+    GrMouseBeginBatch(NULL, x, y, x+o->width-1, y+o->height-1);
 
     GUIRDL2SetSelected(data->rdl2, o->selected, 0, 0);
     GUIRDL2Paint(data->rdl2, dx, dy, 0);
 
-    GrMouseUnBlock(mouseblock);
+    GrMouseEndBatch();
 }
 
 /***************************/
@@ -40,6 +40,7 @@ void GUIInit(int initgrevent, int doublebuffer)
         GrMouseDisplayCursor();
         GrEventGenMmove(GR_GEN_MMOVE_IFBUT);
         //GrEventGenMmove(GR_GEN_MMOVE_ALWAYS);
+        GrEventCoalesce(GR_COALESCE_MMOVE | GR_COALESCE_EXPOSE);
         greventinited = 1;
     }
 
@@ -0,0 +1,45 @@
+/**
+ ** dither.h ---- dithering of RGB rows for the image loaders
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The loaders fill rgb[] with a row of 8 bit components and call
+ ** _GrDitherRow to get the colors. Rows must be passed in order,
+ ** starting at row 0. If _GrDitherInit sets mode to GR_DITHER_NONE
+ ** the current color mode doesn't need dithering and the loader
+ ** must use its normal path.
+ **/
+
+#ifndef __DITHER_H_INCLUDED__
+#define __DITHER_H_INCLUDED__
+
+#ifndef __LIBGRX_H_INCLUDED__
+#include "libgrx.h"
+#endif
+
+typedef struct {
+    int mode;                   /* GR_DITHER_xxx */
+    int width;                  /* pixels per row */
+    int y;                      /* next row */
+    int amp[3];                 /* ordered dither amplitudes */
+    unsigned char *rgb;         /* input row, 3 * width bytes */
+    int *err;                   /* error rows, 1/16 units */
+    GrColor lut[3][256];        /* component colors in RGB modes */
+} GrDitherState;
+
+int  _GrDitherInit(GrDitherState *ds, int width);
+void _GrDitherRow(GrDitherState *ds, GrColor *c);
+void _GrDitherEnd(GrDitherState *ds);
+
+#endif
@@ -211,6 +211,7 @@ extern  struct _GR_mouseInfo   _GrMouseInfo;
 extern int _GR_firstFreeColor; /* can't access all colors on all systems */
 extern int _GR_lastFreeColor;  /* eg. X11 and other windowing systems    */
 int _GrResetColors(void);      /* like GrResetColors but return true on success */
+void _GrColorCacheInvalidate(void); /* after changing the color table directly */
 
 #define C_OPER(color)   (unsigned int)(((GrColor)(color) >> 24) & 15)
 #define C_WRITE         (int)(GrWRITE >> 24)
@@ -254,6 +255,7 @@ int _GrRecode_CP1252_UCS2(unsigned char src, long *des);
 int _GrRecode_CP1253_UCS2(unsigned char src, long *des);
 int _GrRecode_ISO88591_UCS2(unsigned char src, long *des);
 int _GrRecode_UTF8_UCS2(const unsigned char *src, long *des);
+int _GrRecode_UTF8_UCS4(const unsigned char *src, long *des);
 int _GrRecode_mgrx512_UCS2(unsigned short src, long *des);
 int _GrRecode_ISO88595_UCS2(unsigned char src, long *des);
 int _GrRecode_ISO88597_UCS2(unsigned char src, long *des);
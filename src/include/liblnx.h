@@ -0,0 +1,43 @@
+/**
+ ** liblnx.h - GRX library Linux console private include file
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#ifndef _LIBLNX_H_
+#define _LIBLNX_H_
+
+/* evdev pointer input, lnxevdev.c */
+
+#define LNXEV_LEFTBUTTON   1    /* same bits as GRMOUSE_LB_STATUS, etc */
+#define LNXEV_RIGHTBUTTON  2
+#define LNXEV_MIDDLEBUTTON 4
+
+#define LNXEV_ABSMAX       65535
+
+typedef struct {
+    int dx, dy;             /* relative motion */
+    int absx, absy;         /* absolute position, 0 to LNXEV_ABSMAX, or -1 */
+    int buttons;            /* LNXEV_ buttons status */
+    int wheel;              /* wheel clicks, > 0 up */
+    long time;              /* GrMsecTime of the kernel timestamp */
+} LnxEvdevReport;
+
+int _LnxEvdevInit(void);
+void _LnxEvdevUnInit(void);
+int _LnxEvdevPollFds(struct pollfd *pfd, int max);
+int _LnxEvdevRead(LnxEvdevReport *r);
+
+#endif
@@ -36,6 +36,7 @@ extern int _W32EventQueueSize;
 extern int _W32EventQueueRead;
 extern int _W32EventQueueWrite;
 extern int _W32EventQueueLength;
+extern HANDLE _W32EventAvailable;
 
 extern HWND hGRXWnd;
 extern HDC hDCMem;
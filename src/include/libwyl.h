@@ -100,10 +100,12 @@ extern int _WGrGenFrameEvents;
 extern int _WGrGenWSzChgEvents;
 extern int _WGrUserHadSetWName;
 extern int _WGrLastKbEnterSerial;
+extern uint32_t _WGrLastPtrEnterSerial;
 
 extern const struct wl_pointer_listener _Gr_wyl_pointer_listener;
 extern const struct wl_keyboard_listener _Gr_wyl_keyboard_listener;
 
 void _WGrIniClipBoard(void);
+void _WGrSetPointerCursor(void);
 
 #endif
@@ -92,4 +92,6 @@ void _XGrCopyBStore(int x, int y, int width, int lenght);
 void _XGrIniClipBoard(void);
 int _XGrLoadClipBoard(void);
 
+void _XGrSetBlankCursor(void);
+
 #endif
@@ -21,6 +21,28 @@
 int _GrEventInit(void);
 void _GrEventUnInit(void);
 int _GrReadInputs(void);
+int _GrWaitInputs(long msec);
+
+/* user fds and wakeup, evfd_psx.c (POSIX) or evfd_gen.c */
+
+struct pollfd;
+int _GrPollInputs(struct pollfd *drvfds, int ndrv, long msec);
+int _GrCheckFds(void);
+void _GrWakeInputsInit(void);
+void _GrWakeInputs(void);
+void _GrWakeInputsDrain(void);
+
+/* event record and replay, evrecord.c */
+
+void _GrRecordEvent(GrEvent *ev);
+int _GrReplaying(void);
+int _GrReplayInputs(void);
+long _GrReplayWait(void);
+
+/* provided by grevent.c */
+
+int _GrEventQueued(int type, long p1);
+int _GrEventEnqueueTimed(GrEvent *ev);
 
 int _GrMouseDetect(void);
 void _GrInitMouseCursor(void);
@@ -0,0 +1,201 @@
+/**
+ ** pixrow.h ---- direct access to rows of native pixels in RAM frames
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Used by the image loaders/savers and other bulk routines to convert
+ ** whole rows at once instead of going through the frame driver pixel
+ ** by pixel. Only off screen, one plane, 16/24/32bpp frames qualify,
+ ** other frames must use the GrPutScanline/GrGetScanline path.
+ **/
+
+#ifndef __PIXROW_H_INCLUDED__
+#define __PIXROW_H_INCLUDED__
+
+#ifndef __LIBGRX_H_INCLUDED__
+#include "libgrx.h"
+#endif
+
+/* bytes per pixel if the context rows can be accessed directly, else 0 */
+static INLINE int _GrPixRowBytes(const GrContext *ctx)
+{
+    GrFrameDriver *fd = ctx->gc_driver;
+
+    if (ctx->gc_onscreen || fd == NULL || fd->num_planes != 1) return 0;
+    switch (fd->bits_per_pixel) {
+        case 16: return 2;
+        case 24: return 3;
+        case 32: return 4;
+    }
+    return 0;
+}
+
+/* shift to convert a GrColor to the native pixel (COL2PIX) */
+static INLINE int _GrPixRowShift(const GrContext *ctx)
+{
+    switch (ctx->gc_driver->mode) {
+        case GR_frameRAM32H:
+        case GR_frameNRAM32H: return 8;
+        default: return 0;
+    }
+}
+
+/* address of pixel x,y (context coordinates) */
+static INLINE char *_GrPixRowAddr(const GrContext *ctx, int bpp, int x, int y)
+{
+    return &ctx->gc_baseaddr[0][(long)(y + ctx->gc_yoffset) * ctx->gc_lineoffset +
+                                (long)(x + ctx->gc_xoffset) * bpp];
+}
+
+/* store w GrColors as native pixels */
+static INLINE void _GrPixRowPut(char *p, int bpp, int shift, const GrColor *c, int w)
+{
+    GR_int16u *p16;
+    GR_int32u *p32;
+    GR_int8u *p8;
+    int i;
+
+    switch (bpp) {
+        case 2:
+            p16 = (GR_int16u *)p;
+            for (i=0; i<w; i++) p16[i] = (GR_int16u)c[i];
+            break;
+        case 3:
+            p8 = (GR_int8u *)p;
+            for (i=0; i<w; i++) {
+                p8[0] = (GR_int8u)c[i];
+                p8[1] = (GR_int8u)(c[i] >> 8);
+                p8[2] = (GR_int8u)(c[i] >> 16);
+                p8 += 3;
+            }
+            break;
+        case 4:
+            p32 = (GR_int32u *)p;
+            if (shift)
+                for (i=0; i<w; i++) p32[i] = c[i] << 8;
+            else
+                for (i=0; i<w; i++) p32[i] = c[i] & 0xFFFFFF;
+            break;
+    }
+}
+
+/* load w native pixels as GrColors */
+static INLINE void _GrPixRowGet(const char *p, int bpp, int shift, GrColor *c, int w)
+{
+    const GR_int16u *p16;
+    const GR_int32u *p32;
+    const GR_int8u *p8;
+    int i;
+
+    switch (bpp) {
+        case 2:
+            p16 = (const GR_int16u *)p;
+            for (i=0; i<w; i++) c[i] = p16[i];
+            break;
+        case 3:
+            p8 = (const GR_int8u *)p;
+            for (i=0; i<w; i++) {
+                c[i] = p8[0] | (p8[1] << 8) | ((GrColor)p8[2] << 16);
+                p8 += 3;
+            }
+            break;
+        case 4:
+            p32 = (const GR_int32u *)p;
+            if (shift)
+                for (i=0; i<w; i++) c[i] = p32[i] >> 8;
+            else
+                for (i=0; i<w; i++) c[i] = p32[i] & 0xFFFFFF;
+            break;
+    }
+}
+
+/*
+ * Row output to the current context, the pixels are stored directly
+ * when the frame allows it, else through GrPutScanline. The clip box
+ * is honored in both cases.
+ */
+typedef struct {
+    int bpp;                    /* bytes per pixel if direct, else 0 */
+    int shift;                  /* COL2PIX shift */
+    int x1, y1, x2, y2;         /* clip box */
+} GrPixRowOutput;
+
+static INLINE void _GrPixRowSetOutput(GrPixRowOutput *os)
+{
+    os->bpp = CLRINFO->RGBmode ? _GrPixRowBytes(CURC) : 0;
+    os->shift = os->bpp ? _GrPixRowShift(CURC) : 0;
+    os->x1 = CURC->gc_xcliplo;
+    os->y1 = CURC->gc_ycliplo;
+    os->x2 = CURC->gc_xcliphi;
+    os->y2 = CURC->gc_ycliphi;
+}
+
+/* write c[0..w-1] at x=0..w-1 of row y */
+static INLINE void _GrPixRowPutColors(GrPixRowOutput *os, int w, int y, const GrColor *c)
+{
+    int x1, x2;
+
+    if (os->bpp == 0) {
+        GrPutScanline(0, w-1, y, c, GrWRITE);
+        return;
+    }
+    if (y < os->y1 || y > os->y2) return;
+    x1 = (os->x1 > 0) ? os->x1 : 0;
+    x2 = (os->x2 < w-1) ? os->x2 : w-1;
+    if (x1 > x2) return;
+    _GrPixRowPut(_GrPixRowAddr(CURC, os->bpp, x1, y), os->bpp, os->shift,
+                 &c[x1], x2-x1+1);
+}
+
+/* read x=0..w-1 of row y of the current context in c[] */
+static INLINE void _GrPixRowGetColors(int w, int y, GrColor *c)
+{
+    int bpp = _GrPixRowBytes(CURC);
+
+    if (bpp > 0)
+        _GrPixRowGet(_GrPixRowAddr(CURC, bpp, 0, y), bpp, _GrPixRowShift(CURC), c, w);
+    else
+        memcpy(c, GrGetScanline(0, w-1, y), sizeof(GrColor) * w);
+}
+
+/*
+ * In RGB modes a color is the OR of its three components, so they can
+ * be precalculated (scale can be NULL if no component scaling is needed)
+ */
+static INLINE void _GrPixRowRGBTables(GrColor *lr, GrColor *lg, GrColor *lb,
+                                      const unsigned char *scale)
+{
+    int i, v;
+
+    for (i=0; i<256; i++) {
+        v = scale ? scale[i] : i;
+        lr[i] = GrAllocColor(v, 0, 0);
+        lg[i] = GrAllocColor(0, v, 0);
+        lb[i] = GrAllocColor(0, 0, v);
+    }
+}
+
+/* unpack a color, inlined in RGB modes */
+static INLINE void _GrPixRowQueryColor(GrColor c, int *r, int *g, int *b)
+{
+    if (CLRINFO->RGBmode) {
+        *r = GrRGBcolorRed(c);
+        *g = GrRGBcolorGreen(c);
+        *b = GrRGBcolorBlue(c);
+    }
+    else
+        GrQueryColor(c, r, g, b);
+}
+
+#endif
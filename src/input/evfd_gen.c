@@ -0,0 +1,57 @@
+/**
+ ** evfd_gen.c ---- MGRX events, user file descriptors (not supported)
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** DOS and W32 have no poll, so fds can't be added to the event loop.
+ ** GrEventPostFromThread wakes up the W32 event loop with the event
+ ** object of the input queue, DOS has no threads.
+ **
+ **/
+
+#include "libgrx.h"
+#include "ninput.h"
+#if defined(__WIN32__)
+#include "libwin32.h"
+#endif
+
+int GrEventAddFd(int fd, int events, long userdata)
+{
+    return -1;
+}
+
+int GrEventRemoveFd(int fd)
+{
+    return -1;
+}
+
+int _GrCheckFds(void)
+{
+    return 0;
+}
+
+void _GrWakeInputsInit(void)
+{
+}
+
+void _GrWakeInputs(void)
+{
+#if defined(__WIN32__)
+    if (_W32EventAvailable != NULL) SetEvent(_W32EventAvailable);
+#endif
+}
+
+void _GrWakeInputsDrain(void)
+{
+}
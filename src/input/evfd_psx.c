@@ -0,0 +1,223 @@
+/**
+ ** evfd_psx.c ---- MGRX events, user file descriptors (POSIX)
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The input drivers wait in _GrPollInputs, that polls their own fds
+ ** and the user ones together. A ready user fd is reported with a
+ ** GREV_FDREADY event and not polled again while the event is queued.
+ ** A pipe is polled too, GrEventPostFromThread writes in it to wake up
+ ** the event loop.
+ **
+ **/
+
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "libgrx.h"
+#include "ninput.h"
+
+#define MAX_EVFDS  16
+#define MAX_DRVFDS 12
+
+static struct {
+    int fd;
+    int events;
+    long userdata;
+} evfds[MAX_EVFDS];
+static int num_evfds = 0;
+
+static int wakefds[2] = { -1, -1 };
+
+/**
+ ** GrEventAddFd - Adds a fd to be watched by the event loop
+ **
+ ** If the fd was already added its events and userdata are replaced
+ **
+ ** Arguments:
+ **   fd: file descriptor
+ **   events: GR_FD_READ and/or GR_FD_WRITE
+ **   userdata: returned in p3 of the GREV_FDREADY event
+ **
+ ** Returns  0 on success
+ **         -1 on error
+ **/
+
+int GrEventAddFd(int fd, int events, long userdata)
+{
+    int i;
+
+    if (fd < 0) return -1;
+    for (i=0; i<num_evfds; i++)
+        if (evfds[i].fd == fd) break;
+    if (i == num_evfds) {
+        if (num_evfds >= MAX_EVFDS) return -1;
+        num_evfds++;
+    }
+    evfds[i].fd = fd;
+    evfds[i].events = events;
+    evfds[i].userdata = userdata;
+    return 0;
+}
+
+/**
+ ** GrEventRemoveFd - Removes a fd added with GrEventAddFd
+ **
+ ** Returns  0 on success
+ **         -1 if the fd was not added
+ **/
+
+int GrEventRemoveFd(int fd)
+{
+    int i;
+
+    for (i=0; i<num_evfds; i++) {
+        if (evfds[i].fd == fd) {
+            evfds[i] = evfds[--num_evfds];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ ** _GrPollInputs - Polls the driver fds and the user fds
+ **
+ ** Arguments:
+ **   drvfds: driver fds, revents are set on return
+ **   ndrv: number of driver fds (can be 0)
+ **   msec: timeout, forever if < 0
+ **
+ ** Returns the poll result, ready user fds are already enqueued
+ **
+ ** For internal use only
+ **/
+
+int _GrPollInputs(struct pollfd *drvfds, int ndrv, long msec)
+{
+    struct pollfd pfd[MAX_DRVFDS + MAX_EVFDS + 1];
+    char buf[64];
+    int idx[MAX_EVFDS + 1];
+    int i, n, ret, flags;
+
+    if (ndrv > MAX_DRVFDS) ndrv = MAX_DRVFDS;
+    for (i=0; i<ndrv; i++) {
+        pfd[i] = drvfds[i];
+        pfd[i].revents = 0;
+    }
+    n = ndrv;
+    if (wakefds[0] >= 0) {
+        pfd[n].fd = wakefds[0];
+        pfd[n].events = POLLIN;
+        pfd[n].revents = 0;
+        n++;
+    }
+    for (i=0; i<num_evfds; i++) {
+        if (_GrEventQueued(GREV_FDREADY, evfds[i].fd)) continue;
+        idx[n-ndrv] = i;
+        pfd[n].fd = evfds[i].fd;
+        pfd[n].events = 0;
+        if (evfds[i].events & GR_FD_READ) pfd[n].events |= POLLIN;
+        if (evfds[i].events & GR_FD_WRITE) pfd[n].events |= POLLOUT;
+        pfd[n].revents = 0;
+        n++;
+    }
+
+    ret = poll(pfd, n, (msec < 0) ? -1 : (int)msec);
+
+    for (i=0; i<ndrv; i++)
+        drvfds[i].revents = pfd[i].revents;
+    if (ret <= 0) return ret;
+    for (i=ndrv; i<n; i++) {
+        if (pfd[i].revents == 0) continue;
+        if (pfd[i].fd == wakefds[0]) {
+            while (read(wakefds[0], buf, sizeof(buf)) > 0);
+            continue;
+        }
+        flags = 0;
+        if (pfd[i].revents & POLLIN) flags |= GR_FD_READ;
+        if (pfd[i].revents & POLLOUT) flags |= GR_FD_WRITE;
+        if (pfd[i].revents & (POLLERR | POLLHUP | POLLNVAL)) flags |= GR_FD_ERROR;
+        GrEventParEnqueue(GREV_FDREADY, pfd[i].fd, flags,
+                          evfds[idx[i-ndrv]].userdata, 0);
+    }
+    return ret;
+}
+
+/**
+ ** _GrWakeInputsInit - Creates the wake up pipe
+ **
+ ** For internal use only
+ **/
+
+void _GrWakeInputsInit(void)
+{
+    if (wakefds[0] >= 0) return;
+    if (pipe(wakefds) < 0) {
+        wakefds[0] = wakefds[1] = -1;
+        return;
+    }
+    fcntl(wakefds[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakefds[1], F_SETFL, O_NONBLOCK);
+    fcntl(wakefds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(wakefds[1], F_SETFD, FD_CLOEXEC);
+}
+
+/**
+ ** _GrWakeInputs - Wakes up the event loop, from any thread
+ **
+ ** If the pipe is full the event loop is already awake
+ **
+ ** For internal use only
+ **/
+
+void _GrWakeInputs(void)
+{
+    if (wakefds[1] >= 0)
+        if (write(wakefds[1], "", 1) < 0) return;
+}
+
+/**
+ ** _GrWakeInputsDrain - Empties the wake up pipe
+ **
+ ** Called before reading the posted events, so a wake up for events
+ ** already read doesn't end the next wait
+ **
+ ** For internal use only
+ **/
+
+void _GrWakeInputsDrain(void)
+{
+    char buf[64];
+
+    if (wakefds[0] >= 0)
+        while (read(wakefds[0], buf, sizeof(buf)) > 0);
+}
+
+/**
+ ** _GrCheckFds - Checks the user fds without waiting
+ **
+ ** Returns the number of GREV_FDREADY events enqueued
+ **
+ ** For internal use only
+ **/
+
+int _GrCheckFds(void)
+{
+    int n;
+
+    if (num_evfds == 0) return 0;
+    n = _GrPollInputs(NULL, 0, 0);
+    return (n > 0) ? n : 0;
+}
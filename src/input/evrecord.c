@@ -0,0 +1,272 @@
+/**
+ ** evrecord.c ---- MGRX events, record and replay
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Only the events that come from the input driver are recorded (the
+ ** ones below GREV_CLOCK), as the driver enqueues them: before the
+ ** coalescing and the hooks, GREV_PREKEY included, so a replay feeds
+ ** the same input through the same hooks. The program generates the
+ ** rest again when they are replayed.
+ **
+ ** The file is the "MGRXEV01" magic and a record per event: the
+ ** miliseconds since the previous event, type, kbstat and p1 to p4,
+ ** all of them 32 bit little endian integers.
+ **
+ ** While replaying, the events are read from the file instead of the
+ ** input driver.
+ **
+ **/
+
+#include <stdio.h>
+#include <string.h>
+#include "libgrx.h"
+#include "ninput.h"
+
+#define MAGIC "MGRXEV01"
+#define MAGICLEN 8
+#define RECSIZE 28
+
+static FILE *recfile = NULL;
+static long reclasttime;
+
+static FILE *playfile = NULL;
+static int playmode;
+static int playhaveev;          /* next event is read in playev */
+static GrEvent playev;
+static long playnext;           /* time to deliver playev (realtime mode) */
+static long playstart;
+static long playlastdelivery;
+static int playmeasure;         /* the program is processing an event */
+static GrReplayStats playstats;
+
+static void put32(unsigned char *p, long v)
+{
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+}
+
+static long get32(unsigned char *p)
+{
+    return (long)(int)((unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+                       ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24));
+}
+
+/**
+ ** GrEventStartRecord - Starts recording the events to a file
+ **
+ ** Returns  0 on success
+ **         -1 on error
+ **/
+
+int GrEventStartRecord(char *filename)
+{
+    GrEventStopRecord();
+    recfile = fopen(filename, "wb");
+    if (recfile == NULL) return -1;
+    if (fwrite(MAGIC, 1, MAGICLEN, recfile) != MAGICLEN) {
+        fclose(recfile);
+        recfile = NULL;
+        return -1;
+    }
+    reclasttime = GrMsecTime();
+    return 0;
+}
+
+/**
+ ** GrEventStopRecord - Stops recording and closes the file
+ **
+ **/
+
+void GrEventStopRecord(void)
+{
+    if (recfile == NULL) return;
+    fclose(recfile);
+    recfile = NULL;
+}
+
+/**
+ ** GrEventStartReplay - Starts replaying the events of a file
+ **
+ ** A GREV_REPLAYEND event is generated when all the events are replayed
+ **
+ ** Arguments:
+ **   filename: file recorded with GrEventStartRecord
+ **   mode: GR_REPLAY_REALTIME (with the recorded timing) or
+ **         GR_REPLAY_FAST (as fast as the program reads them)
+ **
+ ** Returns  0 on success
+ **         -1 on error
+ **/
+
+int GrEventStartReplay(char *filename, int mode)
+{
+    char magic[MAGICLEN];
+
+    GrEventStopReplay();
+    playfile = fopen(filename, "rb");
+    if (playfile == NULL) return -1;
+    if (fread(magic, 1, MAGICLEN, playfile) != MAGICLEN ||
+        memcmp(magic, MAGIC, MAGICLEN) != 0) {
+        fclose(playfile);
+        playfile = NULL;
+        return -1;
+    }
+    playmode = mode;
+    playhaveev = 0;
+    playmeasure = 0;
+    memset(&playstats, 0, sizeof(GrReplayStats));
+    playstart = playnext = playlastdelivery = GrMsecTime();
+    return 0;
+}
+
+/**
+ ** GrEventStopReplay - Stops replaying, the input driver is used again
+ **
+ **/
+
+void GrEventStopReplay(void)
+{
+    if (playfile == NULL) return;
+    fclose(playfile);
+    playfile = NULL;
+    playstats.msec = GrMsecTime() - playstart;
+}
+
+/**
+ ** GrEventReplayStats - Gets the timing report of the last replay
+ **
+ ** It can be called during the replay too
+ **/
+
+void GrEventReplayStats(GrReplayStats *st)
+{
+    *st = playstats;
+    if (playfile != NULL) st->msec = GrMsecTime() - playstart;
+}
+
+/**
+ ** _GrRecordEvent - Records an event enqueued by the input driver
+ **
+ ** For internal use only
+ **/
+
+void _GrRecordEvent(GrEvent *ev)
+{
+    unsigned char buf[RECSIZE];
+    long t;
+
+    if (recfile == NULL) return;
+    if (ev->type <= GREV_NULL || ev->type >= GREV_CLOCK) return;
+    t = GrMsecTime();
+    put32(buf, t - reclasttime);
+    put32(buf + 4, ev->type);
+    put32(buf + 8, ev->kbstat);
+    put32(buf + 12, ev->p1);
+    put32(buf + 16, ev->p2);
+    put32(buf + 20, ev->p3);
+    put32(buf + 24, ev->p4);
+    reclasttime = t;
+    if (fwrite(buf, 1, RECSIZE, recfile) != RECSIZE)
+        GrEventStopRecord();
+}
+
+/**
+ ** _GrReplaying - Returns true if the events are being replayed
+ **
+ ** For internal use only
+ **/
+
+int _GrReplaying(void)
+{
+    return playfile != NULL;
+}
+
+/* reads the next event, at the end stops and enqueues GREV_REPLAYEND */
+static int readnext(void)
+{
+    unsigned char buf[RECSIZE];
+    long delta;
+
+    if (fread(buf, 1, RECSIZE, playfile) != RECSIZE) {
+        GrEventStopReplay();
+        GrEventParEnqueue(GREV_REPLAYEND, playstats.nevents, 0, 0, 0);
+        return 0;
+    }
+    delta = get32(buf);
+    playev.type = get32(buf + 4);
+    playev.kbstat = get32(buf + 8);
+    playev.p1 = get32(buf + 12);
+    playev.p2 = get32(buf + 16);
+    playev.p3 = get32(buf + 20);
+    playev.p4 = get32(buf + 24);
+    playstats.recmsec += delta;
+    playnext += delta;
+    playhaveev = 1;
+    return 1;
+}
+
+/**
+ ** _GrReplayInputs - Enqueues the replayed events that are due
+ **
+ ** In fast mode one event is enqueued every call
+ **
+ ** For internal use only
+ **/
+
+int _GrReplayInputs(void)
+{
+    long t;
+    int n = 0;
+
+    if (playfile == NULL) return 0;
+    t = GrMsecTime();
+    if (playmeasure) {
+        playstats.evmsec += t - playlastdelivery;
+        if (t - playlastdelivery > playstats.maxevmsec)
+            playstats.maxevmsec = t - playlastdelivery;
+        playmeasure = 0;
+    }
+    while (1) {
+        if (!playhaveev && !readnext()) return n + 1;
+        if (playmode == GR_REPLAY_REALTIME && t - playnext < 0) return n;
+        if (GrEventEnqueue(&playev) < 0) return n;
+        playhaveev = 0;
+        playstats.nevents++;
+        playlastdelivery = t;
+        playmeasure = 1;
+        n++;
+        if (playmode == GR_REPLAY_FAST) return n;
+    }
+}
+
+/**
+ ** _GrReplayWait - Miliseconds to the next replayed event
+ **
+ ** Returns -1 if not replaying
+ **
+ ** For internal use only
+ **/
+
+long _GrReplayWait(void)
+{
+    long t;
+
+    if (playfile == NULL) return -1;
+    if (!playhaveev || playmode == GR_REPLAY_FAST) return 0;
+    t = playnext - GrMsecTime();
+    return (t > 0) ? t : 0;
+}
@@ -18,6 +18,7 @@
  **
  ** Contributions by:
  ** 080120 M.Alvarez, intl support
+ ** 261019 M.Alvarez, the 1 ms yield moved to _GrWaitInputs
  **
  **/
 
@@ -185,10 +186,24 @@ int _GrReadInputs(void)
         nev++;
     }
 
-    if (nev == 0) delay(1); /* yield */
     return nev;
 }
 
+/**
+ ** _GrWaitInputs - Waits for inputs
+ **
+ ** DOS has nothing to block on, the BIOS keyboard and the mouse driver
+ ** must be polled, so it only yields 1 ms and lets the caller poll again
+ **
+ ** For internal use only
+ **/
+
+int _GrWaitInputs(long msec)
+{
+    if (msec != 0) delay(1); /* yield */
+    return 1;
+}
+
 /**
  ** _GrMouseDetect - Returns true if a mouse is detected
  **
@@ -20,6 +20,8 @@
  ** 080120 M.Alvarez, intl support
  ** 190803 M.Alvarez, added support for imps2 mouse protocol (we have the wheel)
  ** 190804 M.Alvarez, changed termio by termios, solve problems with control keys
+ ** 261019 M.Alvarez, _GrWaitInputs polls the keyboard and mouse fds
+ ** 261019 M.Alvarez, evdev pointer devices, legacy mouse only if none
  **
  **/
 
@@ -30,10 +32,12 @@
 #include <fcntl.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <time.h>
 
 #include "libgrx.h"
+#include "liblnx.h"
 #include "ninput.h"
 #include "arith.h"
 #include "memcopy.h"
@@ -48,6 +52,7 @@ static int kbd_isatty;
 static int kbd_lastchr;
 static int kbd_filedsc;
 static enum { normal, test, wait } kbd_mode;
+static int chrspending = 0;
 
 #define PS2_LEFTBUTTON   1
 #define PS2_MIDDLEBUTTON 4
@@ -55,6 +60,7 @@ static enum { normal, test, wait } kbd_mode;
 
 static int mou_filedsc;
 static int mou_buttons;
+static int mou_evdev = FALSE;
 
 int _lnx_waiting_to_switch_console = 0;
 void (*_LnxSwitchConsoleAndWait)(void) = NULL;
@@ -73,6 +79,8 @@ static int _CheckKeyboardHit(void);
 static int _ReadCharFromKeyboard(void);
 static int _TryToSetImps2_Mode(void);
 static int _ReadPS2MouseData(int *mb, int *mx, int *my, int *wh);
+static int _GenMouseEvents(int mb, int wh, long time);
+static int _ReadEvdevMouse(void);
 
 #define update_coord(WHICH,MICKEYS) do {                                    \
         static int fract = 0;                                               \
@@ -128,6 +136,12 @@ int _GrEventInit(void)
 void _GrEventUnInit(void)
 {
     kbd_restore();
+    if (mou_evdev) {
+        /* closed, the next GrEventInit detects the devices again */
+        _LnxEvdevUnInit();
+        mou_evdev = FALSE;
+        MOUINFO->msstatus = 0;
+    }
 }
 
 /**
@@ -156,71 +170,12 @@ int _GrReadInputs(void)
         (*_LnxSwitchConsoleAndWait)();
 
     if (MOUINFO->msstatus == 2) {
-        if (_ReadPS2MouseData(&mb, &mx, &my, &wh)) {
+        if (mou_evdev)
+            nev += _ReadEvdevMouse();
+        else if (_ReadPS2MouseData(&mb, &mx, &my, &wh)) {
             update_coord(x, mx);
             update_coord(y, my);
-            /** NOTE we know PS2_LEFTBUTTON == GRMOUSE_LB_STATUS, etc */
-            MOUINFO->bstatus = mb;
-            GrMouseUpdateCursor();
-            MOUINFO->moved  = TRUE;
-            if (mb != mou_buttons || wh != 0) {
-                evaux.type = GREV_MOUSE;
-                evaux.kbstat = kbd_lastmod;
-                evaux.p2 = MOUINFO->xpos;
-                evaux.p3 = MOUINFO->ypos;
-                if ((mb & PS2_LEFTBUTTON) != (mou_buttons & PS2_LEFTBUTTON)) {
-                    if (mb & PS2_LEFTBUTTON)
-                        evaux.p1 = GRMOUSE_LB_PRESSED;
-                    else
-                        evaux.p1 = GRMOUSE_LB_RELEASED;
-                    GrEventEnqueue(&evaux);
-                    nev++;
-                }
-                if ((mb & PS2_MIDDLEBUTTON) != (mou_buttons & PS2_MIDDLEBUTTON)) {
-                    if (mb & PS2_MIDDLEBUTTON)
-                        evaux.p1 = GRMOUSE_MB_PRESSED;
-                    else
-                        evaux.p1 = GRMOUSE_MB_RELEASED;
-                    GrEventEnqueue(&evaux);
-                    nev++;
-                }
-                if ((mb & PS2_RIGHTBUTTON) != (mou_buttons & PS2_RIGHTBUTTON)) {
-                    if (mb & PS2_RIGHTBUTTON)
-                        evaux.p1 = GRMOUSE_RB_PRESSED;
-                    else
-                        evaux.p1 = GRMOUSE_RB_RELEASED;
-                    GrEventEnqueue(&evaux);
-                    nev++;
-                }
-                if (wh < 0) {
-                    evaux.p1 = GRMOUSE_B4_PRESSED;
-                    GrEventEnqueue(&evaux);
-                    evaux.p1 = GRMOUSE_B4_RELEASED;
-                    GrEventEnqueue(&evaux);
-                    nev += 2;
-                }
-                if (wh > 0) {
-                    evaux.p1 = GRMOUSE_B5_PRESSED;
-                    GrEventEnqueue(&evaux);
-                    evaux.p1 = GRMOUSE_B5_RELEASED;
-                    GrEventEnqueue(&evaux);
-                    nev += 2;
-                }
-                mou_buttons = mb;
-                MOUINFO->moved = FALSE;
-            }
-            else if ((MOUINFO->genmmove == GR_GEN_MMOVE_ALWAYS) ||
-                     ((MOUINFO->genmmove == GR_GEN_MMOVE_IFBUT) &&
-                     (MOUINFO->bstatus != 0))) {
-                evaux.type = GREV_MMOVE;
-                evaux.kbstat = kbd_lastmod;
-                evaux.p1 = MOUINFO->bstatus;
-                evaux.p2 = MOUINFO->xpos;
-                evaux.p3 = MOUINFO->ypos;
-                GrEventEnqueue(&evaux);
-                MOUINFO->moved = FALSE;
-                nev++;
-           }
+            nev += _GenMouseEvents(mb, wh, GrMsecTime());
         }
     }
 
@@ -265,12 +220,46 @@ int _GrReadInputs(void)
 
     if (nev == 0) {
         if (_LnxFlushGraphics) (*_LnxFlushGraphics)();
-        usleep(1000L);   // wait 1 ms to not eat 100% cpu
     }
 
     return nev;
 }
 
+/**
+ ** _GrWaitInputs - Waits for inputs
+ **
+ ** Blocks until the keyboard, the mouse or an user fd have data or
+ ** msec miliseconds passed (forever if msec < 0). A signal (like the
+ ** console switch one) ends the wait too. Without a tty keyboard and
+ ** a mouse it waits 1 ms at most. Returns 0 on timeout
+ **
+ ** For internal use only
+ **/
+
+int _GrWaitInputs(long msec)
+{
+    struct pollfd pfd[12];
+    int n = 0;
+
+    if (chrspending > 0 || (kbd_initted && kbd_lastchr != EOF)) return 1;
+    if (kbd_isatty) {
+        pfd[n].fd = kbd_filedsc;
+        pfd[n].events = POLLIN;
+        pfd[n++].revents = 0;
+    }
+    if (MOUINFO->msstatus == 2 && mou_evdev) {
+        n += _LnxEvdevPollFds(pfd + n, 11);
+    }
+    else if (MOUINFO->msstatus == 2) {
+        pfd[n].fd = mou_filedsc;
+        pfd[n].events = POLLIN;
+        pfd[n++].revents = 0;
+    }
+    /* no keyboard or mouse fd to block on, poll every 1 ms as before */
+    if (n == 0 && (msec < 0 || msec > 1)) msec = 1;
+    return _GrPollInputs(pfd, n, msec) > 0;
+}
+
 /**
  ** _GrMouseDetect - Returns true if a mouse is detected
  **
@@ -280,6 +269,11 @@ int _GrReadInputs(void)
 int _GrMouseDetect(void)
 {
     MOUINFO->msstatus = (-1);        /* assume missing */
+    if (getenv("MGRXNOEVDEV") == NULL && _LnxEvdevInit() > 0) {
+        mou_evdev = TRUE;
+        MOUINFO->msstatus = 1;        /* present, but not initted */
+        return 1;
+    }
     mou_filedsc = open("/dev/input/mice", O_RDWR | O_NDELAY);
     if (mou_filedsc < 0)
         mou_filedsc = open("/dev/psaux", O_RDWR | O_NDELAY);
@@ -372,7 +366,6 @@ static void kbd_init(void)
 
 #define CHRBUFSIZE 30
 
-static int chrspending = 0;
 static int getByte(int remove)
 {
     static unsigned char keybuf[CHRBUFSIZE];
@@ -652,6 +645,99 @@ static int _ReadCharFromKeyboard(void)
 
 /** Internal mouse functions **/
 
+/* generates the mouse events after the position is updated */
+static int _GenMouseEvents(int mb, int wh, long time)
+{
+    GrEvent evaux;
+    int nev = 0;
+
+    /** NOTE we know PS2_LEFTBUTTON == GRMOUSE_LB_STATUS, etc */
+    MOUINFO->bstatus = mb;
+    GrMouseUpdateCursor();
+    MOUINFO->moved  = TRUE;
+    evaux.time = time;
+    if (mb != mou_buttons || wh != 0) {
+        evaux.type = GREV_MOUSE;
+        evaux.kbstat = kbd_lastmod;
+        evaux.p2 = MOUINFO->xpos;
+        evaux.p3 = MOUINFO->ypos;
+        if ((mb & PS2_LEFTBUTTON) != (mou_buttons & PS2_LEFTBUTTON)) {
+            if (mb & PS2_LEFTBUTTON)
+                evaux.p1 = GRMOUSE_LB_PRESSED;
+            else
+                evaux.p1 = GRMOUSE_LB_RELEASED;
+            _GrEventEnqueueTimed(&evaux);
+            nev++;
+        }
+        if ((mb & PS2_MIDDLEBUTTON) != (mou_buttons & PS2_MIDDLEBUTTON)) {
+            if (mb & PS2_MIDDLEBUTTON)
+                evaux.p1 = GRMOUSE_MB_PRESSED;
+            else
+                evaux.p1 = GRMOUSE_MB_RELEASED;
+            _GrEventEnqueueTimed(&evaux);
+            nev++;
+        }
+        if ((mb & PS2_RIGHTBUTTON) != (mou_buttons & PS2_RIGHTBUTTON)) {
+            if (mb & PS2_RIGHTBUTTON)
+                evaux.p1 = GRMOUSE_RB_PRESSED;
+            else
+                evaux.p1 = GRMOUSE_RB_RELEASED;
+            _GrEventEnqueueTimed(&evaux);
+            nev++;
+        }
+        if (wh < 0) {
+            evaux.p1 = GRMOUSE_B4_PRESSED;
+            _GrEventEnqueueTimed(&evaux);
+            evaux.p1 = GRMOUSE_B4_RELEASED;
+            _GrEventEnqueueTimed(&evaux);
+            nev += 2;
+        }
+        if (wh > 0) {
+            evaux.p1 = GRMOUSE_B5_PRESSED;
+            _GrEventEnqueueTimed(&evaux);
+            evaux.p1 = GRMOUSE_B5_RELEASED;
+            _GrEventEnqueueTimed(&evaux);
+            nev += 2;
+        }
+        mou_buttons = mb;
+        MOUINFO->moved = FALSE;
+    }
+    else if ((MOUINFO->genmmove == GR_GEN_MMOVE_ALWAYS) ||
+             ((MOUINFO->genmmove == GR_GEN_MMOVE_IFBUT) &&
+             (MOUINFO->bstatus != 0))) {
+        evaux.type = GREV_MMOVE;
+        evaux.kbstat = kbd_lastmod;
+        evaux.p1 = MOUINFO->bstatus;
+        evaux.p2 = MOUINFO->xpos;
+        evaux.p3 = MOUINFO->ypos;
+        _GrEventEnqueueTimed(&evaux);
+        MOUINFO->moved = FALSE;
+        nev++;
+    }
+    return nev;
+}
+
+/* reads all the evdev reports, stamped with the kernel time */
+static int _ReadEvdevMouse(void)
+{
+    LnxEvdevReport r;
+    int nev = 0;
+
+    while (_LnxEvdevRead(&r)) {
+        if (r.absx >= 0)
+            MOUINFO->xpos = imax(MOUINFO->xmin, imin(MOUINFO->xmax,
+                            (int)((long)r.absx * SCRN->gc_xmax / LNXEV_ABSMAX)));
+        if (r.absy >= 0)
+            MOUINFO->ypos = imax(MOUINFO->ymin, imin(MOUINFO->ymax,
+                            (int)((long)r.absy * SCRN->gc_ymax / LNXEV_ABSMAX)));
+        update_coord(x, r.dx);
+        update_coord(y, r.dy);
+        /* evdev wheel > 0 is up, like imps2 wheel < 0 */
+        nev += _GenMouseEvents(r.buttons, -r.wheel, r.time);
+    }
+    return nev;
+}
+
 static int _TryToSetImps2_Mode(void)
 {
     unsigned char buf_imps2[6] = {0xf3, 0xc8, 0xf3, 0x64, 0xf3, 0x50}; 
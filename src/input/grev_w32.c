@@ -21,6 +21,7 @@
  ** 191112 M.Alvarez, Added code to generate GREV_WMEND events
  ** 211123 M.Alvarez, support window resize
  ** 220318 M.Alvarez, changed ALT09AZ recognition to be more generic
+ ** 261019 M.Alvarez, _GrWaitInputs waits on _W32EventAvailable
  **/
 
 #include <stdlib.h>
@@ -306,10 +307,30 @@ int _GrReadInputs(void)
             break;
         }
     }
-    if (nev == 0) Sleep(1); /* yield */
     return nev;
 }
 
+/**
+ ** _GrWaitInputs - Waits for inputs
+ **
+ ** Blocks until the window thread queues an event or msec miliseconds
+ ** passed (forever if msec < 0). Returns 0 on timeout
+ **
+ ** For internal use only
+ **/
+
+int _GrWaitInputs(long msec)
+{
+    if (_W32EventQueueLength > 0) return 1;
+    if (_W32EventAvailable == NULL) {
+        Sleep((msec < 0) ? INFINITE : (DWORD)msec);
+        return 0;
+    }
+    return WaitForSingleObject(_W32EventAvailable,
+                               (msec < 0) ? INFINITE : (DWORD)msec)
+           == WAIT_OBJECT_0;
+}
+
 /**
  ** _GrMouseDetect - Returns true if a mouse is detected
  **
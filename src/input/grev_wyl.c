@@ -14,11 +14,15 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** Contributions by:
+ ** 261019 M.Alvarez, _GrWaitInputs polls the display fd
+ **
  **/
 
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <poll.h>
 #include <sys/mman.h>
 #include "libgrx.h"
 #include "mgrxkeys.h"
@@ -38,6 +42,7 @@ static int kbd_lastmod = 0;
 static void _WGrEnqueuKeyEvent(uint32_t key, char *buf);
 static int _WGrKeyCode(unsigned int keywyl, unsigned int state, long *p1, long *p2);
 static void _WGrCheckAutoRepeatKey(void);
+static long _WGrAutoRepeatWait(void);
 
 static struct {
     int rate;
@@ -106,11 +111,51 @@ int _GrReadInputs(void)
     if (numgrxeventread == 0) _WGrCheckAutoRepeatKey();
 
     nevents = numgrxeventread;
-    if (nevents == 0) usleep(1000L);   // wait 1 ms to not eat 100% cpu
     numgrxeventread = 0;
     return nevents;
 }
 
+/**
+ ** _GrWaitInputs - Waits for inputs
+ **
+ ** Blocks until the display fd or an user fd has data, the next key
+ ** autorepeat or msec miliseconds passed (forever if msec < 0). Returns 0 on timeout
+ **
+ ** For internal use only
+ **/
+
+int _GrWaitInputs(long msec)
+{
+    struct wl_display *d = _WGrState.wl_display;
+    struct pollfd pfd;
+    long rep;
+    int ret;
+
+    if (d == NULL) return _GrPollInputs(NULL, 0, msec) > 0;
+
+    rep = _WGrAutoRepeatWait();
+    if (rep >= 0 && (msec < 0 || rep < msec)) msec = rep;
+
+    while (wl_display_prepare_read(d) != 0)
+        wl_display_dispatch_pending(d);
+    if (numgrxeventread > 0) {
+        wl_display_cancel_read(d);
+        return 1;
+    }
+    wl_display_flush(d);
+    pfd.fd = wl_display_get_fd(d);
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    ret = _GrPollInputs(&pfd, 1, msec);
+    if (pfd.revents) {
+        wl_display_read_events(d);
+        wl_display_dispatch_pending(d);
+    }
+    else
+        wl_display_cancel_read(d);
+    return ret > 0;
+}
+
 /**
  ** _GrMouseDetect - Returns true if a mouse is detected
  **
@@ -274,8 +319,9 @@ wl_pointer_frame(void *data, struct wl_pointer *wl_pointer)
     struct pointer_event *event = &client_state->pointer_event;
 
     if (event->event_mask & POINTER_EVENT_ENTER) {
-        // Define an invisible cursor
-        wl_pointer_set_cursor(wl_pointer, event->serial, NULL, 0, 0);
+        // The hardware cursor if set, else an invisible one
+        _WGrLastPtrEnterSerial = event->serial;
+        _WGrSetPointerCursor();
     }
 
     if (event->event_mask & POINTER_EVENT_LEAVE) {
@@ -632,6 +678,18 @@ static int _WGrKeyCode(unsigned int keywyl, unsigned int state, long *p1, long *
     return 0;
 }
 
+/* miliseconds to the next key autorepeat, -1 if none */
+
+static long _WGrAutoRepeatWait(void)
+{
+    long t;
+
+    if (repeat_status.status == 0) return -1;
+    t = (repeat_status.status == 1) ? repeat_status.delay : repeat_status.rate;
+    t += 1 - (GrMsecTime() - repeat_status.ev.time);
+    return (t > 0) ? t : 0;
+}
+
 void _WGrCheckAutoRepeatKey(void)
 {
     if (repeat_status.status == 0) return;
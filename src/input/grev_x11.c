@@ -22,10 +22,12 @@
  ** 211215 M.Alvarez, better keycode conversion, using a table 
  **                   for every state instead of a big table
  ** 220206 M.Alvarez, X11 clipboard support
+ ** 261019 M.Alvarez, _GrWaitInputs polls the X connection
  **/
 
 #include <stdlib.h>
 #include <string.h>
+#include <poll.h>
 #include "libgrx.h"
 #include "libxwin.h"
 #include <X11/Xatom.h>
@@ -59,10 +61,6 @@ static int _XGrOpenXIMandXIC(Display *dpy, Window win, XIM *im, XIC *ic);
 
 int _GrEventInit(void)
 {
-    static char cbits[8] = { 0,0,0,0,0,0,0,0, };
-    Pixmap csource, cmask;
-    XColor cfore, cback;
-    Cursor curs;
     char *s;
 
     if (!_XGrDisplay) {
@@ -70,15 +68,7 @@ int _GrEventInit(void)
     }
 
     if (GrMouseDetect()) { // Define an invisible X cursor for _XGrWindow
-        if(_XGrWindowedMode) {
-            csource = cmask = XCreateBitmapFromData(
-                              _XGrDisplay, _XGrWindow, cbits, 8, 8);
-            cfore.red = cfore.green = cfore.blue = 0;
-            cback.red = cback.green = cback.blue = 0;
-            curs = XCreatePixmapCursor(
-                   _XGrDisplay, csource, cmask, &cfore, &cback, 0, 0);
-            XDefineCursor (_XGrDisplay, _XGrWindow, curs);
-        }
+        if(_XGrWindowedMode) _XGrSetBlankCursor();
     }
 
     if (_XGrOpenXIMandXIC(_XGrDisplay, _XGrWindow, &_XGrXim, &_XGrXic)) {
@@ -140,11 +130,7 @@ int _GrReadInputs(void)
     // I think is better the QueuedAfterFlush mode, but...
     //count = XEventsQueued(_XGrDisplay, QueuedAfterReading);
     count = XEventsQueued(_XGrDisplay, QueuedAfterFlush);
-    if (count <= 0) {
-        //XFlush(_XGrDisplay);
-        usleep(1000L);   // wait 1 ms to not eat 100% cpu
-        return 0;
-    }
+    if (count <= 0) return 0;
 
     while (--count >= 0) {
         XNextEvent(_XGrDisplay, &xev);
@@ -383,14 +369,34 @@ int _GrReadInputs(void)
         }
     }
 
-    if (nev == 0) {
-        XFlush(_XGrDisplay);
-        usleep(1000L);   // wait 1 ms to not eat 100% cpu
-    }
+    if (nev == 0) XFlush(_XGrDisplay);
 
     return nev;
 }
 
+/**
+ ** _GrWaitInputs - Waits for inputs
+ **
+ ** Blocks until the X connection or an user fd has data or msec
+ ** miliseconds passed (forever if msec < 0). Returns 0 on timeout
+ **
+ ** For internal use only
+ **/
+
+int _GrWaitInputs(long msec)
+{
+    struct pollfd pfd;
+
+    if (!_XGrDisplay) return _GrPollInputs(NULL, 0, msec) > 0;
+
+    XFlush(_XGrDisplay);
+    if (XEventsQueued(_XGrDisplay, QueuedAlready) > 0) return 1;
+    pfd.fd = ConnectionNumber(_XGrDisplay);
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return _GrPollInputs(&pfd, 1, msec) > 0;
+}
+
 /**
  ** _GrMouseDetect - Returns true if a mouse is detected
  **
@@ -18,6 +18,12 @@
  ** 080113 M.Alvarez, intl support
  ** 191112 Added code to generate GREV_WMEND events
  ** 220222 Added compose key
+ ** 261019 GrEventWait blocks in the input driver, GREV_CLOCK events
+ ** 261019 User timers and fds (GREV_TIMER and GREV_FDREADY events)
+ ** 261019 The event queue is a growable ring buffer
+ ** 261019 Optional GREV_MMOVE and GREV_EXPOSE coalescing
+ ** 261019 GrEventPostFromThread, lock-free queue for other threads
+ ** 261019 Event record and replay
  **/
 
 #include <stdlib.h>
@@ -25,11 +31,33 @@
 #include "libgrx.h"
 #include "mgrxkeys.h"
 #include "ninput.h"
+#include "arith.h"
 
-#define MAX_EVQUEUE 60
+#define INI_EVQUEUE 64
+#define DEF_MAXEVQUEUE 1024
 
-static GrEvent evqueue[MAX_EVQUEUE];
+/* ring buffer, grows up to max_evqueue events */
+static GrEvent *evqueue = NULL;
+static int size_evqueue = 0;
+static int max_evqueue = DEF_MAXEVQUEUE;
+static int first_evqueue = 0;      /* next event to be read */
 static int num_evqueue = 0;
+static long overflows_evqueue = 0;
+
+#define EVQ(i) evqueue[(first_evqueue + (i)) % size_evqueue]
+
+/* bounded lock-free MPSC queue for events posted from other threads,
+   seq is the position it is ready for (relative to the queue lap), so
+   the zeroed static array is a valid empty queue */
+#define MAX_POSTQUEUE 256
+#define POSTLAP(pos) ((pos) & ~(unsigned long)(MAX_POSTQUEUE - 1))
+
+static struct {
+    unsigned long seq;
+    GrEvent ev;
+} postqueue[MAX_POSTQUEUE];
+static unsigned long posthead = 0;  /* next to write, by the posting threads */
+static unsigned long posttail = 0;  /* next to read, by the event loop */
 
 static int kbsysencoding = GRENC_CP437;
 
@@ -38,6 +66,23 @@ static int genwmendevents = GR_GEN_NO;
 static int genframeevents = GR_GEN_NO;
 static int genclockevents = GR_GEN_NO;
 static int msecclockevent = 30;
+static long nextclockevent = 0;
+
+#define MAX_TIMERS 16
+
+static struct {
+    int id;
+    int periodic;
+    long msec;
+    long next;
+    long userdata;
+} timers[MAX_TIMERS];
+static int num_timers = 0;
+static int last_timer_id = 0;
+
+static int coalesce_flags = GR_COALESCE_NO;
+
+static int recinputs = 0;   /* the events enqueued come from the input driver */
 
 static int compose_key = 0; // default no composition
 
@@ -45,6 +90,15 @@ static int compose_key = 0; // default no composition
 static int (*hook_event[MAX_HOOK_FUNCTIONS]) (GrEvent *);
 
 static int preproccess_event(GrEvent *ev);
+static int resizequeue(int size);
+static int coalesce(GrEvent *ev);
+static int readposted(void);
+static int readinputs(void);
+static int readevent(GrEvent *ev);
+static int checkclock(void);
+static int checktimers(void);
+static long waittime(void);
+static int waitinputs(long msec);
 
 /**
  ** GrEventInit - Initializes the input event queue
@@ -58,6 +112,7 @@ int GrEventInit(void)
     int i, ret;
 
     num_evqueue = 0;
+    overflows_evqueue = 0;
     for (i=0; i<MAX_HOOK_FUNCTIONS; i++)
         hook_event[i] = NULL;
     if (GrMouseDetect()) {
@@ -69,6 +124,7 @@ int GrEventInit(void)
         MOUINFO->msstatus = 2;
     }
     ret = _GrEventInit();
+    _GrWakeInputsInit();
     kbsysencoding = _GrGetKbSysEncoding();
     return ret;
 }
@@ -81,6 +137,9 @@ int GrEventInit(void)
 void GrEventUnInit(void)
 {
     num_evqueue = 0;
+    free(evqueue);
+    evqueue = NULL;
+    size_evqueue = 0;
     if (MOUINFO->msstatus > 1) MOUINFO->msstatus = 1;
     _GrEventUnInit();
 }
@@ -120,7 +179,10 @@ void GrSetComposeKey(int compkey)
 
 int GrEventCheck(void)
 {
-    if (num_evqueue > 0 || _GrReadInputs()) return 1;
+    if (num_evqueue > 0 || readinputs() || checkclock() || checktimers() ||
+        _GrCheckFds() || readposted())
+        return 1;
+    waitinputs(1);      // polling loops don't eat 100% cpu
     return 0;
 }
 
@@ -131,7 +193,8 @@ int GrEventCheck(void)
 
 void GrEventFlush(void)
 {
-    while(_GrReadInputs());
+    if (!_GrReplaying())    // the replayed events are not flushed
+        while(_GrReadInputs());
     num_evqueue = 0;
 }
 
@@ -146,29 +209,22 @@ void GrEventFlush(void)
 
 void GrEventRead(GrEvent * ev)
 {
-    while (1) {
-        if (num_evqueue > 0) {
-            num_evqueue--;
-            *ev = evqueue[num_evqueue];
-            if (preproccess_event(ev)) continue;
-            return;
-        }
-        if (_GrReadInputs()) {
-            continue;
-        }
-        ev->type = GREV_NULL;
-        ev->time = GrMsecTime();
-        ev->kbstat = 0;
-        ev->p1 = 0;
-        ev->p2 = 0;
-        ev->p3 = 0;
-        return;
-    }
+    if (readevent(ev)) return;
+    waitinputs(1);      // polling loops don't eat 100% cpu
+    ev->type = GREV_NULL;
+    ev->time = GrMsecTime();
+    ev->kbstat = 0;
+    ev->p1 = 0;
+    ev->p2 = 0;
+    ev->p3 = 0;
 }
 
 /**
  ** GrEventWait - Waits for an event
  **
+ ** The input driver blocks until there are inputs or the next
+ ** GREV_CLOCK event must be generated
+ **
  ** Arguments:
  **   ev: returns the event
  **/
@@ -176,12 +232,8 @@ void GrEventRead(GrEvent * ev)
 
 void GrEventWait(GrEvent * ev)
 {
-    while (1) {
-        GrEventRead(ev);
-        if (ev->type != GREV_NULL) {
-            return;
-        }
-    }
+    while (!readevent(ev))
+        waitinputs(waittime());
 }
 
 /**
@@ -195,7 +247,7 @@ void GrEventWait(GrEvent * ev)
 void GrEventWaitKeyOrClick(GrEvent * ev)
 {
     while (1) {
-        GrEventRead(ev);
+        GrEventWait(ev);
         if (ev->type == GREV_KEY)
            return;
         if (ev->type == GREV_MOUSE && ev->p1 == GRMOUSE_LB_RELEASED)
@@ -214,18 +266,37 @@ void GrEventWaitKeyOrClick(GrEvent * ev)
  **/
 
 int GrEventEnqueue(GrEvent * ev)
+{
+    ev->time = GrMsecTime();
+    return _GrEventEnqueueTimed(ev);
+}
+
+/**
+ ** _GrEventEnqueueTimed - Enqueues an event keeping its time
+ **
+ ** For input drivers that know when the input happened
+ **
+ ** Returns  0 on success
+ **         -1 on error
+ **
+ ** For internal use only
+ **/
+
+int _GrEventEnqueueTimed(GrEvent * ev)
 {
     int i;
 
-    ev->time = GrMsecTime();
-    if (num_evqueue < MAX_EVQUEUE) {
-        for (i=num_evqueue; i>0; i--)
-            evqueue[i] = evqueue[i-1];
-        evqueue[0] = *ev;
-        num_evqueue++;
-        return 0;
+    if (recinputs) _GrRecordEvent(ev);
+    if (coalesce_flags && coalesce(ev)) return 0;
+    if (num_evqueue == size_evqueue && resizequeue(size_evqueue * 2) < 0) {
+        overflows_evqueue++;
+        return -1;
     }
-    return -1;
+    i = first_evqueue + num_evqueue;
+    if (i >= size_evqueue) i -= size_evqueue;
+    evqueue[i] = *ev;
+    num_evqueue++;
+    return 0;
 }
 
 /**
@@ -265,12 +336,14 @@ int GrEventParEnqueue(int type, long p1, long p2, long p3, long p4)
 int GrEventEnqueueFirst(GrEvent * ev)
 {
     ev->time = GrMsecTime();
-    if (num_evqueue < MAX_EVQUEUE) {
-        evqueue[num_evqueue] = *ev;
-        num_evqueue++;
-        return 0;
+    if (num_evqueue == size_evqueue && resizequeue(size_evqueue * 2) < 0) {
+        overflows_evqueue++;
+        return -1;
     }
-    return -1;
+    if (--first_evqueue < 0) first_evqueue += size_evqueue;
+    evqueue[first_evqueue] = *ev;
+    num_evqueue++;
+    return 0;
 }
 
 /**
@@ -418,12 +491,365 @@ int GrEventGenFrame(int gen)
 int GrEventGenClock(int gen, int msec)
 {
     genclockevents = gen;
-    msecclockevent = msec;
+    msecclockevent = (msec > 0) ? msec : 1;
+    nextclockevent = GrMsecTime() + msecclockevent;
     return genclockevents;
 }
 
+/**
+ ** GrEventPostFromThread - Posts an event from another thread
+ **
+ ** It can be called from any thread, the event is moved to the queue
+ ** by the event loop, that is woken up if it is waiting. The rest of
+ ** the MGRX event functions must be used only from the main thread
+ **
+ ** Arguments:
+ **   ev: event to be posted
+ **
+ ** Returns  0 on success
+ **         -1 if the posted events queue is full
+ **/
+
+int GrEventPostFromThread(GrEvent * ev)
+{
+    unsigned long pos, seq;
+    long dif;
+
+    pos = __atomic_load_n(&posthead, __ATOMIC_RELAXED);
+    while (1) {
+        seq = __atomic_load_n(&postqueue[pos % MAX_POSTQUEUE].seq,
+                              __ATOMIC_ACQUIRE);
+        dif = (long)(seq - POSTLAP(pos));
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&posthead, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (dif < 0)
+            return -1;
+        else
+            pos = __atomic_load_n(&posthead, __ATOMIC_RELAXED);
+    }
+    postqueue[pos % MAX_POSTQUEUE].ev = *ev;
+    __atomic_store_n(&postqueue[pos % MAX_POSTQUEUE].seq, POSTLAP(pos) + 1,
+                     __ATOMIC_RELEASE);
+    _GrWakeInputs();
+    return 0;
+}
+
+/**
+ ** GrEventCoalesce - Sets the events to be coalesced when enqueued
+ **
+ ** With GR_COALESCE_MMOVE a GREV_MMOVE replaces the last queued event
+ ** if it is a GREV_MMOVE with the same buttons and kb status. With
+ ** GR_COALESCE_EXPOSE a GREV_EXPOSE is merged with the last queued event
+ ** if it is a GREV_EXPOSE and the areas overlap or touch
+ **
+ ** Arguments:
+ **   flags: GR_COALESCE_NO or GR_COALESCE_MMOVE and/or GR_COALESCE_EXPOSE
+ **
+ ** Returns the previous flags
+ **/
+
+int GrEventCoalesce(int flags)
+{
+    int old = coalesce_flags;
+
+    coalesce_flags = flags;
+    return old;
+}
+
+/**
+ ** GrEventSetQueueSize - Sets the max number of events in the queue
+ **
+ ** The queue grows as needed up to this size (1024 by default), events
+ ** enqueued when it is full are lost and counted as overflows
+ **
+ ** Arguments:
+ **   maxsize: max events
+ **
+ ** Returns  0 on success
+ **         -1 on error (more events queued than maxsize or no memory)
+ **/
+
+int GrEventSetQueueSize(int maxsize)
+{
+    int oldmax = max_evqueue;
+
+    if (maxsize < 1 || maxsize < num_evqueue) return -1;
+    max_evqueue = maxsize;      /* resizequeue clamps to it */
+    if (size_evqueue > maxsize && resizequeue(maxsize) < 0) {
+        max_evqueue = oldmax;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ ** GrEventQueueOverflows - Number of events lost because the queue was full
+ **
+ ** The count is reset by GrEventInit
+ **/
+
+long GrEventQueueOverflows(void)
+{
+    return overflows_evqueue;
+}
+
+/**
+ ** GrEventAddTimer - Adds a timer that generates GREV_TIMER events
+ **
+ ** Arguments:
+ **   msec: miliseconds to expire
+ **   periodic: if true the timer is rearmed, if false it expires once
+ **   userdata: returned in p2 of the GREV_TIMER event
+ **
+ ** Returns the timer id (> 0, returned in p1 of the GREV_TIMER event)
+ **         -1 on error
+ **/
+
+int GrEventAddTimer(long msec, int periodic, long userdata)
+{
+    if (num_timers >= MAX_TIMERS) return -1;
+    if (msec < 1) msec = 1;
+    if (++last_timer_id <= 0) last_timer_id = 1;
+    timers[num_timers].id = last_timer_id;
+    timers[num_timers].periodic = periodic;
+    timers[num_timers].msec = msec;
+    timers[num_timers].next = GrMsecTime() + msec;
+    timers[num_timers].userdata = userdata;
+    num_timers++;
+    return last_timer_id;
+}
+
+/**
+ ** GrEventRemoveTimer - Removes a timer added with GrEventAddTimer
+ **
+ ** GREV_TIMER events already queued are not removed
+ **
+ ** Returns  0 on success
+ **         -1 if the timer doesn't exist (one shot timers are
+ **            removed when they expire)
+ **/
+
+int GrEventRemoveTimer(int id)
+{
+    int i;
+
+    for (i=0; i<num_timers; i++) {
+        if (timers[i].id == id) {
+            timers[i] = timers[--num_timers];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ ** _GrEventQueued - Checks if an event is in the queue
+ **
+ ** Returns true if an event of the type with this p1 is queued
+ **
+ ** For internal use only
+ **/
+
+int _GrEventQueued(int type, long p1)
+{
+    int i;
+
+    for (i=0; i<num_evqueue; i++)
+        if (EVQ(i).type == type && EVQ(i).p1 == p1) return 1;
+    return 0;
+}
+
 /* Internal functions */
 
+/* coalesces the event with the last queued one, returns 1 if done */
+static int coalesce(GrEvent *ev)
+{
+    GrEvent *last;
+    long x2, y2;
+
+    if (num_evqueue == 0) return 0;
+    last = &EVQ(num_evqueue - 1);
+    if (ev->type != last->type) return 0;
+
+    if (ev->type == GREV_MMOVE && (coalesce_flags & GR_COALESCE_MMOVE)) {
+        if (ev->p1 != last->p1 || ev->kbstat != last->kbstat) return 0;
+        *last = *ev;
+        return 1;
+    }
+
+    if (ev->type == GREV_EXPOSE && (coalesce_flags & GR_COALESCE_EXPOSE)) {
+        if (ev->p1 > last->p1 + last->p3 || last->p1 > ev->p1 + ev->p3 ||
+            ev->p2 > last->p2 + last->p4 || last->p2 > ev->p2 + ev->p4)
+            return 0;
+        x2 = imax(ev->p1 + ev->p3, last->p1 + last->p3);
+        y2 = imax(ev->p2 + ev->p4, last->p2 + last->p4);
+        last->p1 = imin(ev->p1, last->p1);
+        last->p2 = imin(ev->p2, last->p2);
+        last->p3 = x2 - last->p1;
+        last->p4 = y2 - last->p2;
+        last->kbstat = ev->kbstat;   // the count of the expose that follow
+        last->time = ev->time;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* moves the posted events to the queue, returns how many */
+static int readposted(void)
+{
+    unsigned long seq;
+    int n = 0;
+
+    /* before reading, a post made meanwhile leaves the pipe full */
+    _GrWakeInputsDrain();
+    while (1) {
+        seq = __atomic_load_n(&postqueue[posttail % MAX_POSTQUEUE].seq,
+                              __ATOMIC_ACQUIRE);
+        if (seq != POSTLAP(posttail) + 1) return n;
+        if (GrEventEnqueue(&postqueue[posttail % MAX_POSTQUEUE].ev) < 0) {
+            /* the queue is full, the posts left must wake the next wait */
+            _GrWakeInputs();
+            return n;
+        }
+        __atomic_store_n(&postqueue[posttail % MAX_POSTQUEUE].seq,
+                         POSTLAP(posttail) + MAX_POSTQUEUE, __ATOMIC_RELEASE);
+        posttail++;
+        n++;
+    }
+}
+
+/* reallocs the queue, keeping the queued events in order */
+static int resizequeue(int size)
+{
+    GrEvent *q;
+    int i;
+
+    if (size < INI_EVQUEUE) size = INI_EVQUEUE;
+    if (size > max_evqueue) size = max_evqueue;
+    if (size <= num_evqueue) return -1;
+    q = malloc(size * sizeof(GrEvent));
+    if (q == NULL) return -1;
+    for (i=0; i<num_evqueue; i++)
+        q[i] = EVQ(i);
+    free(evqueue);
+    evqueue = q;
+    size_evqueue = size;
+    first_evqueue = 0;
+    return 0;
+}
+
+/* enqueues a GREV_CLOCK event if it is time */
+static int checkclock(void)
+{
+    long t;
+
+    if (genclockevents != GR_GEN_YES) return 0;
+    t = GrMsecTime();
+    if (t - nextclockevent < 0) return 0;
+    nextclockevent += msecclockevent;
+    if (t - nextclockevent >= 0) // too late, don't catch up
+        nextclockevent = t + msecclockevent;
+    return GrEventParEnqueue(GREV_CLOCK, 0, 0, 0, 0) == 0;
+}
+
+/* enqueues the GREV_TIMER events of the expired timers */
+static int checktimers(void)
+{
+    long t;
+    int i, n = 0;
+
+    if (num_timers == 0) return 0;
+    t = GrMsecTime();
+    for (i=0; i<num_timers; i++) {
+        if (t - timers[i].next < 0) continue;
+        if (GrEventParEnqueue(GREV_TIMER, timers[i].id,
+                              timers[i].userdata, 0, 0) != 0) break;
+        n++;
+        if (timers[i].periodic) {
+            timers[i].next += timers[i].msec;
+            if (t - timers[i].next >= 0) // too late, don't catch up
+                timers[i].next = t + timers[i].msec;
+        }
+        else {
+            timers[i--] = timers[--num_timers];
+        }
+    }
+    return n;
+}
+
+/* miliseconds to the next GREV_CLOCK, GREV_TIMER or replayed event, -1 if none */
+static long waittime(void)
+{
+    long next = 0, t;
+    int i, have = 0;
+
+    if (genclockevents == GR_GEN_YES) {
+        next = nextclockevent;
+        have = 1;
+    }
+    if ((t = _GrReplayWait()) >= 0) {
+        t += GrMsecTime();
+        if (!have || t - next < 0) next = t;
+        have = 1;
+    }
+    for (i=0; i<num_timers; i++) {
+        if (!have || timers[i].next - next < 0) next = timers[i].next;
+        have = 1;
+    }
+    if (!have) return -1;
+    t = next - GrMsecTime();
+    return (t > 0) ? t : 0;
+}
+
+/* reads the input driver, or the replayed events */
+static int readinputs(void)
+{
+    int n;
+
+    if (_GrReplaying()) return _GrReplayInputs();
+    recinputs = 1;
+    n = _GrReadInputs();
+    recinputs = 0;
+    return n;
+}
+
+/* waits for inputs, some drivers enqueue the events read meanwhile */
+static int waitinputs(long msec)
+{
+    int n;
+
+    recinputs = !_GrReplaying();
+    n = _GrWaitInputs(msec);
+    recinputs = 0;
+    return n;
+}
+
+/* gets an event without waiting, returns 0 if none */
+static int readevent(GrEvent *ev)
+{
+    int n;
+
+    while (1) {
+        if (num_evqueue > 0) {
+            *ev = evqueue[first_evqueue];
+            if (++first_evqueue == size_evqueue) first_evqueue = 0;
+            num_evqueue--;
+            if (preproccess_event(ev)) continue;
+            return 1;
+        }
+        n = readinputs();
+        n += checkclock();
+        n += checktimers();
+        n += _GrCheckFds();
+        n += readposted();
+        if (n == 0) return 0;
+    }
+}
+
 static int hexvalue(int value)
 {
     switch (value) {
@@ -496,7 +922,7 @@ static int preproccess_event(GrEvent *ev)
     if (ev->type == GREV_WSZCHG) {
         for (i=0; i<num_evqueue; i++) {
             // ignore the event if there are more GREV_WSZCHG
-            if (evqueue[i].type == GREV_WSZCHG) return 1;
+            if (EVQ(i).type == GREV_WSZCHG) return 1;
         }
     }
 
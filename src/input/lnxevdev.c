@@ -0,0 +1,425 @@
+/**
+ ** lnxevdev.c ---- MGRX events, Linux evdev pointer devices
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Mice, touchpads, touchscreens and tablets are read from the
+ ** /dev/input/event* devices with EV_REL or EV_ABS axes. The input
+ ** events are read in batches and grouped until SYN_REPORT in a report,
+ ** stamped with the kernel time (CLOCK_MONOTONIC, like GrMsecTime).
+ ** Absolute axes (touchscreens, tablets) are scaled to 0..LNXEV_ABSMAX,
+ ** touchpads give relative motion while touched (the pad width is about
+ ** 400 mickeys), tapping is not recognized. Devices plugged later are
+ ** opened when inotify reports them, removed devices are closed when
+ ** read fails with ENODEV. Keyboards are not used, the tty gives the
+ ** keys with the console keymap applied.
+ **
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/inotify.h>
+#include <linux/input.h>
+
+#include "libgrx.h"
+#include "liblnx.h"
+
+#define EVDEV_DIR   "/dev/input"
+#define MAX_DEVS    8
+#define EVBUFSIZE   64
+#define MAX_REPORTS 64
+
+#define NBITS(x) ((((x) - 1) / (8 * sizeof(long))) + 1)
+#define TESTBIT(b, a) (((a)[(b) / (8 * sizeof(long))] >> ((b) % (8 * sizeof(long)))) & 1)
+
+#define PADMICKEYS  400
+
+typedef struct {
+    int fd;
+    int num;                /* N of /dev/input/eventN */
+    int isabs;              /* absolute axes */
+    int ispad;              /* touchpad, absolute axes give relative motion */
+    int absmin[2], absmax[2];
+    int padlast[2];         /* last touchpad position, -1 not touched */
+    int dropped;            /* SYN_DROPPED, skip until SYN_REPORT */
+    LnxEvdevReport cur;     /* report being built */
+    int havedata;
+    struct input_event pend[EVBUFSIZE];  /* read, not processed yet */
+    int firstpend, npend;
+} EvdevDev;
+
+static EvdevDev devs[MAX_DEVS];
+static int ndevs = 0;
+static int inotifyfd = -1;
+static int buttons = 0;     /* merged buttons of all the devices */
+
+static LnxEvdevReport reports[MAX_REPORTS];
+static int firstreport = 0;
+static int nreports = 0;
+
+static void scandevs(void);
+
+/* time of an input event in the GrMsecTime base */
+static long evtime(struct input_event *ie)
+{
+    struct timespec now;
+    long long nowus, evus;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    nowus = (long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+    evus = (long long)ie->input_event_sec * 1000000 + ie->input_event_usec;
+    if (evus > nowus) evus = nowus;
+    return GrMsecTime() - (long)((nowus - evus) / 1000);
+}
+
+static int isopen(int num)
+{
+    int i;
+
+    for (i=0; i<ndevs; i++)
+        if (devs[i].num == num) return 1;
+    return 0;
+}
+
+/* opens the device if it is a pointer, returns 1 if it is */
+static int opendev(int num)
+{
+    unsigned long evbits[NBITS(EV_MAX + 1)];
+    unsigned long relbits[NBITS(REL_MAX + 1)];
+    unsigned long absbits[NBITS(ABS_MAX + 1)];
+    unsigned long keybits[NBITS(KEY_MAX + 1)];
+    unsigned long propbits[NBITS(INPUT_PROP_MAX + 1)];
+    struct input_absinfo ai;
+    char name[32];
+    EvdevDev *d;
+    int fd, clk = CLOCK_MONOTONIC;
+
+    if (ndevs >= MAX_DEVS) return 0;
+    sprintf(name, EVDEV_DIR "/event%d", num);
+    fd = open(name, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return 0;
+    memset(evbits, 0, sizeof(evbits));
+    memset(relbits, 0, sizeof(relbits));
+    memset(absbits, 0, sizeof(absbits));
+    memset(keybits, 0, sizeof(keybits));
+    memset(propbits, 0, sizeof(propbits));
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(evbits)), evbits) < 0) goto notpointer;
+    ioctl(fd, EVIOCGBIT(EV_REL, sizeof(relbits)), relbits);
+    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbits)), absbits);
+    ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybits)), keybits);
+    ioctl(fd, EVIOCGPROP(sizeof(propbits)), propbits);
+
+    d = &devs[ndevs];
+    memset(d, 0, sizeof(EvdevDev));
+    if (TESTBIT(EV_REL, evbits) && TESTBIT(REL_X, relbits) &&
+        TESTBIT(REL_Y, relbits)) {
+        d->isabs = 0;
+    }
+    else if (TESTBIT(EV_ABS, evbits) && TESTBIT(ABS_X, absbits) &&
+             TESTBIT(ABS_Y, absbits) &&
+             (TESTBIT(BTN_TOUCH, keybits) || TESTBIT(BTN_LEFT, keybits))) {
+        d->isabs = 1;
+        if (ioctl(fd, EVIOCGABS(ABS_X), &ai) < 0) goto notpointer;
+        d->absmin[0] = ai.minimum;
+        d->absmax[0] = ai.maximum;
+        if (ioctl(fd, EVIOCGABS(ABS_Y), &ai) < 0) goto notpointer;
+        d->absmin[1] = ai.minimum;
+        d->absmax[1] = ai.maximum;
+        if (d->absmax[0] <= d->absmin[0] || d->absmax[1] <= d->absmin[1])
+            goto notpointer;
+        if (TESTBIT(INPUT_PROP_POINTER, propbits) &&
+            !TESTBIT(INPUT_PROP_DIRECT, propbits)) {
+            d->isabs = 0;
+            d->ispad = 1;
+        }
+    }
+    else
+        goto notpointer;
+
+    ioctl(fd, EVIOCSCLOCKID, &clk);
+    d->fd = fd;
+    d->num = num;
+    d->cur.absx = d->cur.absy = -1;
+    d->padlast[0] = d->padlast[1] = -1;
+    ndevs++;
+    return 1;
+
+notpointer:
+    close(fd);
+    return 0;
+}
+
+static void closedev(int i)
+{
+    close(devs[i].fd);
+    devs[i] = devs[--ndevs];
+}
+
+static void scandevs(void)
+{
+    struct dirent *de;
+    DIR *dir;
+    int num;
+
+    dir = opendir(EVDEV_DIR);
+    if (dir == NULL) return;
+    while ((de = readdir(dir)) != NULL) {
+        if (strncmp(de->d_name, "event", 5) != 0) continue;
+        num = atoi(de->d_name + 5);
+        if (!isopen(num)) opendev(num);
+    }
+    closedir(dir);
+}
+
+static int scaleabs(EvdevDev *d, int axis, int value)
+{
+    long v;
+
+    v = (long)(value - d->absmin[axis]) * LNXEV_ABSMAX /
+        (d->absmax[axis] - d->absmin[axis]);
+    if (v < 0) v = 0;
+    if (v > LNXEV_ABSMAX) v = LNXEV_ABSMAX;
+    return (int)v;
+}
+
+static void addreport(EvdevDev *d)
+{
+    int i;
+
+    d->cur.buttons = buttons;
+    if (nreports < MAX_REPORTS) {
+        i = firstreport + nreports;
+        if (i >= MAX_REPORTS) i -= MAX_REPORTS;
+        reports[i] = d->cur;
+        nreports++;
+    }
+    d->cur.dx = d->cur.dy = d->cur.wheel = 0;
+    d->havedata = 0;
+}
+
+/* the button state after a SYN_DROPPED */
+static void resyncbuttons(EvdevDev *d)
+{
+    unsigned long keys[NBITS(KEY_MAX + 1)];
+
+    memset(keys, 0, sizeof(keys));
+    if (ioctl(d->fd, EVIOCGKEY(sizeof(keys)), keys) < 0) return;
+    buttons = 0;
+    if (TESTBIT(BTN_LEFT, keys) || TESTBIT(BTN_TOUCH, keys))
+        buttons |= LNXEV_LEFTBUTTON;
+    if (TESTBIT(BTN_RIGHT, keys)) buttons |= LNXEV_RIGHTBUTTON;
+    if (TESTBIT(BTN_MIDDLE, keys)) buttons |= LNXEV_MIDDLEBUTTON;
+}
+
+static void setbutton(int bit, int pressed)
+{
+    if (pressed)
+        buttons |= bit;
+    else
+        buttons &= ~bit;
+}
+
+/* processes a batch of input events of a device, it stops when the
+   reports are full, returns the number of input events processed */
+static int processevents(EvdevDev *d, struct input_event *ie, int n)
+{
+    int i, axis, delta;
+
+    for (i=0; i<n; i++, ie++) {
+        if (ie->type == EV_SYN) {
+            if (ie->code == SYN_DROPPED) {
+                d->dropped = 1;
+            }
+            else if (ie->code == SYN_REPORT) {
+                if (d->dropped) {
+                    d->dropped = 0;
+                    d->cur.dx = d->cur.dy = d->cur.wheel = 0;
+                    resyncbuttons(d);
+                    d->havedata = 1;
+                }
+                if (d->havedata) {
+                    d->cur.time = evtime(ie);
+                    addreport(d);
+                    if (nreports == MAX_REPORTS) return i + 1;
+                }
+            }
+            continue;
+        }
+        if (d->dropped) continue;
+        switch (ie->type) {
+          case EV_REL:
+            if (ie->code == REL_X) d->cur.dx += ie->value;
+            else if (ie->code == REL_Y) d->cur.dy += ie->value;
+            else if (ie->code == REL_WHEEL) d->cur.wheel += ie->value;
+            else continue;
+            break;
+          case EV_ABS:
+            if (ie->code != ABS_X && ie->code != ABS_Y) continue;
+            axis = (ie->code == ABS_X) ? 0 : 1;
+            if (d->ispad) {
+                if (d->padlast[axis] >= 0) {
+                    delta = (long)(ie->value - d->padlast[axis]) * PADMICKEYS /
+                            (d->absmax[axis] - d->absmin[axis]);
+                    if (axis == 0) d->cur.dx += delta; else d->cur.dy += delta;
+                }
+                d->padlast[axis] = ie->value;
+            }
+            else if (axis == 0)
+                d->cur.absx = scaleabs(d, 0, ie->value);
+            else
+                d->cur.absy = scaleabs(d, 1, ie->value);
+            break;
+          case EV_KEY:
+            if (ie->code == BTN_TOUCH && d->ispad) {
+                if (ie->value == 0) d->padlast[0] = d->padlast[1] = -1;
+                continue;
+            }
+            if (ie->code == BTN_LEFT || ie->code == BTN_TOUCH)
+                setbutton(LNXEV_LEFTBUTTON, ie->value);
+            else if (ie->code == BTN_RIGHT)
+                setbutton(LNXEV_RIGHTBUTTON, ie->value);
+            else if (ie->code == BTN_MIDDLE)
+                setbutton(LNXEV_MIDDLEBUTTON, ie->value);
+            else continue;
+            break;
+          default:
+            continue;
+        }
+        d->havedata = 1;
+    }
+    return n;
+}
+
+static void readdevs(void)
+{
+    char buf[1024];
+    EvdevDev *d;
+    int i, n;
+
+    if (inotifyfd >= 0 && read(inotifyfd, buf, sizeof(buf)) > 0) {
+        while (read(inotifyfd, buf, sizeof(buf)) > 0);
+        scandevs();
+    }
+    for (i=0; i<ndevs; i++) {
+        d = &devs[i];
+        /* the events left when the reports got full go first */
+        while (nreports < MAX_REPORTS) {
+            if (d->npend == 0) {
+                n = read(d->fd, d->pend, sizeof(d->pend));
+                if (n < 0 && errno == ENODEV) {
+                    closedev(i--);
+                    break;
+                }
+                if (n < (int)sizeof(struct input_event)) break;
+                d->firstpend = 0;
+                d->npend = n / sizeof(struct input_event);
+            }
+            n = processevents(d, &d->pend[d->firstpend], d->npend);
+            d->firstpend += n;
+            d->npend -= n;
+        }
+    }
+}
+
+/**
+ ** _LnxEvdevInit - Opens the evdev pointer devices
+ **
+ ** Returns the number of devices opened
+ **
+ ** For internal use only
+ **/
+
+int _LnxEvdevInit(void)
+{
+    if (inotifyfd < 0) {
+        inotifyfd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyfd >= 0 &&
+            inotify_add_watch(inotifyfd, EVDEV_DIR, IN_CREATE | IN_ATTRIB) < 0) {
+            close(inotifyfd);
+            inotifyfd = -1;
+        }
+    }
+    scandevs();
+    if (ndevs == 0 && inotifyfd >= 0) {
+        close(inotifyfd);
+        inotifyfd = -1;
+    }
+    return ndevs;
+}
+
+/**
+ ** _LnxEvdevUnInit - Closes the devices
+ **
+ ** For internal use only
+ **/
+
+void _LnxEvdevUnInit(void)
+{
+    while (ndevs > 0) closedev(ndevs - 1);
+    if (inotifyfd >= 0) close(inotifyfd);
+    inotifyfd = -1;
+    nreports = 0;
+    buttons = 0;
+}
+
+/**
+ ** _LnxEvdevPollFds - Fills the fds to be polled
+ **
+ ** Returns the number of fds
+ **
+ ** For internal use only
+ **/
+
+int _LnxEvdevPollFds(struct pollfd *pfd, int max)
+{
+    int i, n = 0;
+
+    if (inotifyfd >= 0 && n < max) {
+        pfd[n].fd = inotifyfd;
+        pfd[n].events = POLLIN;
+        pfd[n++].revents = 0;
+    }
+    for (i=0; i<ndevs && n<max; i++) {
+        pfd[n].fd = devs[i].fd;
+        pfd[n].events = POLLIN;
+        pfd[n++].revents = 0;
+    }
+    return n;
+}
+
+/**
+ ** _LnxEvdevRead - Gets the next report, without waiting
+ **
+ ** Returns 1 if a report is returned
+ **
+ ** For internal use only
+ **/
+
+int _LnxEvdevRead(LnxEvdevReport *r)
+{
+    if (nreports == 0) readdevs();
+    if (nreports == 0) return 0;
+    *r = reports[firstreport];
+    if (++firstreport == MAX_REPORTS) firstreport = 0;
+    nreports--;
+    return 1;
+}
@@ -35,6 +35,12 @@ static void draw_mouse(void);
 static void erase_mouse(void);
 static int block(GrContext *c, int x1, int y1, int x2, int y2);
 static void unblock(int flags);
+static int show_hwcursor(void);
+static void move_hwcursor(void);
+
+static int usehwcursor = TRUE;
+static int batchlevel = 0;          /* nested GrMouseBeginBatch calls */
+static int batchflags = 0;          /* block flags to undo at the end */
 
 int GrMouseDetect(void)
 {
@@ -61,8 +67,12 @@ void _GrInitMouseCursor(void)
     if (MSCURSOR && MSCURSOR->displayed) {
         GrEraseCursor(MSCURSOR);
     }
+    if (MOUINFO->hwcursor && VDRV && VDRV->setcursor) {
+        (*VDRV->setcursor)(NULL);
+    }
     MOUINFO->cursmode  = GR_M_CUR_NORMAL;
     MOUINFO->displayed = FALSE;
+    MOUINFO->hwcursor  = FALSE;
     MOUINFO->blockflag = 0;
     MOUINFO->docheck   = FALSE;
     MOUINFO->block     = block;
@@ -71,6 +81,10 @@ void _GrInitMouseCursor(void)
 
 void GrMouseUpdateCursor(void)
 {
+    if (MOUINFO->displayed && MOUINFO->hwcursor) {
+        move_hwcursor();
+        return;
+    }
     if (MOUINFO->displayed && !MOUINFO->blockflag) {
         move_mouse();
     }
@@ -86,6 +100,13 @@ void GrMouseDisplayCursor(void)
     if (MOUINFO->msstatus != 2) return;
     if (MOUINFO->cursor == NULL) return;
     if (MOUINFO->displayed != FALSE) return;
+    if (show_hwcursor()) {
+        /* the framebuffer is never touched, so nothing to check */
+        MOUINFO->displayed = TRUE;
+        MOUINFO->docheck = FALSE;
+        MOUINFO->blockflag = 0;
+        return;
+    }
     move_mouse();
     draw_mouse();
     MOUINFO->displayed = TRUE;
@@ -101,9 +122,51 @@ void GrMouseEraseCursor(void)
     if (MOUINFO->blockflag != 0) return;
     MOUINFO->displayed = FALSE;
     MOUINFO->docheck = FALSE;
+    if (MOUINFO->hwcursor) {
+        (*VDRV->setcursor)(NULL);
+        MOUINFO->hwcursor = FALSE;
+        return;
+    }
     erase_mouse();
 }
 
+/* docheck out of a batch: the cursor is drawn in the framebuffer */
+static int needcheck(void)
+{
+    return (MOUINFO->displayed && !MOUINFO->hwcursor &&
+            !(MOUINFO->blockflag & ERASED));
+}
+
+void GrMouseBeginBatch(GrContext *c, int x1, int y1, int x2, int y2)
+{
+    if (batchlevel++ == 0) batchflags = 0;
+    if (needcheck()) {
+        /* the cursor is still drawn, erase it if it is in the region */
+        MOUINFO->docheck = TRUE;
+        batchflags |= block(c, x1, y1, x2, y2);
+    }
+    MOUINFO->docheck = FALSE;
+}
+
+void GrMouseEndBatch(void)
+{
+    if (batchlevel == 0) return;
+    if (--batchlevel > 0) return;
+    /* the cursor can be displayed or erased meanwhile */
+    if (batchflags) unblock(batchflags);
+    batchflags = 0;
+    MOUINFO->docheck = needcheck();
+    GrMouseUpdateCursor();
+}
+
+int GrMouseUseHwCursor(int use)
+{
+    int old = usehwcursor;
+
+    if (!MOUINFO->displayed) usehwcursor = use;
+    return old;
+}
+
 void GrMouseSetCursor(GrCursor *C)
 {
     if (!MOUINFO->displayed && C && (C != MSCURSOR) && COMPATIBLE(C)) {
@@ -210,6 +273,28 @@ void GrMouseSetCursorMode(int mode,...)
     va_end(ap);
 }
 
+static int show_hwcursor(void)
+{
+    if (!usehwcursor || SPECIALMODE) return FALSE;
+    if (VDRV == NULL || VDRV->setcursor == NULL) return FALSE;
+    if (!(*VDRV->setcursor)(MSCURSOR)) return FALSE;
+    MOUINFO->hwcursor = TRUE;
+    MSCURSOR->xcord = -1;
+    move_hwcursor();
+    return TRUE;
+}
+
+static void move_hwcursor(void)
+{
+    if ((MOUINFO->xpos != MSCURSOR->xcord) ||
+        (MOUINFO->ypos != MSCURSOR->ycord)) {
+        MSCURSOR->xcord = MOUINFO->xpos;
+        MSCURSOR->ycord = MOUINFO->ypos;
+        if (VDRV->movecursor != NULL)
+            (*VDRV->movecursor)(MOUINFO->xpos, MOUINFO->ypos);
+    }
+}
+
 static void draw_special(void)
 {
     int xpos  = MSCURSOR->xcord;
@@ -217,6 +217,16 @@ int _GrRecode_ISO88591_UCS2(unsigned char src, long *des)
 
 int _GrRecode_UTF8_UCS2(const unsigned char *src, long *des)
 {
+/* Code points out of the BMP are changed to 0xFFFD, but with the
+ * correct byte count */
+    int nb = _GrRecode_UTF8_UCS4(src, des);
+
+    if (*des > 0xFFFF) *des = 0xFFFD;
+    return nb;
+}
+
+int _GrRecode_UTF8_UCS4(const unsigned char *src, long *des)
+{
 /* When converting any illformed UCP will be changed to 0xFFFD,
  * see Unicode stardard, conformance D92 */
     int nb = 1;
@@ -257,8 +267,6 @@ int _GrRecode_UTF8_UCS2(const unsigned char *src, long *des)
         return 3;
     }
     if (src[0] >= 0xF0 && src[0] <= 0xF4) { /* four bytes */
-    /* NOTE, because 4 bytes are out of UCS2 range even if they are well
-     * formed we will return 0xFFFD ever, but with the correct byte count */
         if (src[0] == 0xF0) {
             if (src[1] < 0x90 || src[1] > 0xBF) {
                 goto ILLFORMED;
@@ -280,7 +288,10 @@ int _GrRecode_UTF8_UCS2(const unsigned char *src, long *des)
             nb = 3;
             goto ILLFORMED;
         }
-        *des = (unsigned int)0xFFFD;
+        *des = (((unsigned int)(src[0]) & 0x07) << 18) |
+               (((unsigned int)(src[1]) & 0x3f) << 12) |
+               (((unsigned int)(src[2]) & 0x3f) << 6) |
+               ((unsigned int)(src[3]) & 0x3f);
         return 4;
     }
 
@@ -744,7 +755,14 @@ int _GrRecode_UCS2_UTF8(long src, unsigned char *des)
         des[2] = 0x80 | (src & 0x3f);
         return 3;
     }
-    /* out of BMP range or surrogates returns 0xFFFD */
+    if (src >= 0x10000 && src <= 0x10FFFF) { /* four bytes */
+        des[0] = 0xf0 | (src >> 18);
+        des[1] = 0x80 | ((src >> 12) & 0x3f);
+        des[2] = 0x80 | ((src >> 6) & 0x3f);
+        des[3] = 0x80 | (src & 0x3f);
+        return 4;
+    }
+    /* out of Unicode range or surrogates returns 0xFFFD */
     des[0] = 0xEF;
     des[1] = 0xBF;
     des[2] = 0xBD;
@@ -1324,6 +1342,7 @@ int GrStrLen(const void *text, int chrtype)
   int length = 0;
   unsigned char *cs;
   unsigned short *ss;
+  unsigned int *ls;
     
   switch (chrtype) {
     case GR_BYTE_TEXT:
@@ -1349,6 +1368,13 @@ int GrStrLen(const void *text, int chrtype)
         ss++;
       }
       return length;
+    case GR_UCS4_TEXT:
+      ls = (unsigned int *)text;
+      while(*ls) {
+        length++;
+        ls++;
+      }
+      return length;
     default:
       return 0;
   }
@@ -34,3 +34,16 @@ long GrMsecTime( void )
   return (uclock()/(UCLOCKS_PER_SEC/1000));
 }
 
+long long GrUsecTime( void )
+{
+  return GrNsecTime() / 1000LL;
+}
+
+long long GrNsecTime( void )
+{
+  uclock_t t = uclock();
+
+  return ((t / UCLOCKS_PER_SEC) * 1000000000LL) +
+         ((t % UCLOCKS_PER_SEC) * 1000000000LL / UCLOCKS_PER_SEC);
+}
+
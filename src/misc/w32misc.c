@@ -36,3 +36,19 @@ long GrMsecTime( void )
   return ((long)clock() * (1000 / CLOCKS_PER_SEC));
 }
 
+long long GrUsecTime( void )
+{
+  return GrNsecTime() / 1000LL;
+}
+
+long long GrNsecTime( void )
+{
+  static LARGE_INTEGER freq = { 0 };
+  LARGE_INTEGER count;
+
+  if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return ((count.QuadPart / freq.QuadPart) * 1000000000LL) +
+         ((count.QuadPart % freq.QuadPart) * 1000000000LL / freq.QuadPart);
+}
+
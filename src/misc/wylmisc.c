@@ -42,12 +42,27 @@ void GrSleep( int msec )
   return ((long)times(NULL) * (1000L / sysconf(_SC_CLK_TCK)));
 }*/
 
+static time_t orig = 0;
+
 long GrMsecTime( void )
 {
-  static time_t orig = 0;
   struct timespec tp;
   
   clock_gettime(CLOCK_MONOTONIC, &tp);
   if (orig == 0) orig = tp.tv_sec;
   return (((long)(tp.tv_sec - orig) * 1000L) + ((long)tp.tv_nsec / 1000000L));
 }
+
+long long GrUsecTime( void )
+{
+  return GrNsecTime() / 1000LL;
+}
+
+long long GrNsecTime( void )
+{
+  struct timespec tp;
+
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  if (orig == 0) orig = tp.tv_sec;
+  return (((long long)(tp.tv_sec - orig) * 1000000000LL) + (long long)tp.tv_nsec);
+}
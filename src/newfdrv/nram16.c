@@ -26,6 +26,10 @@
 #include "allocate.h"
 #include "ndrvr16.h"
 
+#define STRCH_PIXEL GR_int16u
+static
+#include "fdrivers/generic/strchblt.c"
+
 /* the linear in-memory frambe buffer */
 
 GrFrameDriver _GrFrameDriverNRAM16 = {
@@ -49,7 +53,8 @@ GrFrameDriver _GrFrameDriverNRAM16 = {
     NULL,
     NULL,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
 
 /* the linear video frame buffer */
@@ -75,5 +80,6 @@ GrFrameDriver _GrFrameDriverNLFB16 = {
     bitbltnoo,
     bitbltnoo,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
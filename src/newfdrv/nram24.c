@@ -26,6 +26,9 @@
 #include "allocate.h"
 #include "ndrvr24.h"
 
+static
+#include "fdrivers/generic/strchblt.c"
+
 /* the linear in-memory frambe buffer */
 
 GrFrameDriver _GrFrameDriverNRAM24 = {
@@ -49,7 +52,8 @@ GrFrameDriver _GrFrameDriverNRAM24 = {
     NULL,
     NULL,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
 
 /* the linear video frame buffer */
@@ -75,5 +79,6 @@ GrFrameDriver _GrFrameDriverNLFB24 = {
     bitbltnoo,
     bitbltnoo,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt
 };
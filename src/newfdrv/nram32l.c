@@ -30,6 +30,12 @@
 
 #include "ndrvr32.h"
 
+#define STRCH_PIXEL GR_int32u
+static
+#include "fdrivers/generic/strchblt.c"
+static
+#include "fdrivers/generic/coverage.c"
+
 /* the linear in-memory frambe buffer */
 
 GrFrameDriver _GrFrameDriverNRAM32L = {
@@ -53,7 +59,9 @@ GrFrameDriver _GrFrameDriverNRAM32L = {
     NULL,
     NULL,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt,
+    drawcoverage
 };
 
 /* the linear video frame buffer */
@@ -79,5 +87,7 @@ GrFrameDriver _GrFrameDriverNLFB32L = {
     bitbltnoo,
     bitbltnoo,
     getscanline,
-    putscanline
+    putscanline,
+    stretchblt,
+    drawcoverage
 };
@@ -14,6 +14,9 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, inverse color map cache for GrAllocColor in palette
+ **                   modes
+ **
  **/
 
 #include "libgrx.h"
@@ -21,8 +24,111 @@
 
 static void (*DACload)(int c,int r,int g,int b) = NULL;
 
+/*
+ * Inverse color map cache for palette modes. The RGB cube is divided in
+ * cells, every cell holds the list of table entries that can be the
+ * nearest color for some point of the cell, so GrAllocColor only checks
+ * a few entries. Cells are built on demand and are valid while their
+ * generation equals icgen, any change in the color table increments it.
+ */
+
+#define ICBITS          4               /* bits per component for indexing */
+#define ICSIZE          (1 << (3 * ICBITS))
+#define ICWIDTH         (256 >> ICBITS) /* cell width in component units */
+#define ICMAXCAND       13              /* max candidates per cell */
+#define ICFULL          255             /* too many candidates, full scan */
+
+typedef struct {
+	GR_int16u gen;                  /* generation when built */
+	GR_int8u  ncand;                /* number of candidates or ICFULL */
+	GR_int8u  cand[ICMAXCAND];      /* candidates in table order */
+} iccell;
+
+static iccell    *icache   = NULL;
+static GR_int16u  icgen    = 1;
+static GR_int16u  iccangen = 0;
+static int        iccanalloc;
+static int        icreach;
+
+void _GrColorCacheInvalidate(void)
+{
+	if(++icgen == 0) {
+	    /* wrapped around, old cells could look valid */
+	    if(icache) memset(icache,0,sizeof(iccell) * ICSIZE);
+	    icgen = 1;
+	    iccangen = 0;
+	}
+}
+
+#define MATCHABLE(i) (CLRINFO->ctable[i].defined && !CLRINFO->ctable[i].writable)
+
+static void icbuildcell(iccell *c,int r,int g,int b)
+{
+	GR_int32u dmin[256],dmax,maxlimit = 0xffffffffUL;
+	int lo[3],v[3],i,k,d1,d2;
+	lo[0] = r & ~(ICWIDTH - 1);
+	lo[1] = g & ~(ICWIDTH - 1);
+	lo[2] = b & ~(ICWIDTH - 1);
+	/* an entry can't be the nearest if it is farther from the whole */
+	/* cell than other entry from the farthest point of the cell     */
+	for(i = 0; i < (int)CLRINFO->ncolors; i++) {
+	    if(!MATCHABLE(i)) continue;
+	    v[0] = CLRINFO->ctable[i].r;
+	    v[1] = CLRINFO->ctable[i].g;
+	    v[2] = CLRINFO->ctable[i].b;
+	    dmin[i] = dmax = 0;
+	    for(k = 0; k < 3; k++) {
+		d1 = (v[k] < lo[k]) ? lo[k] - v[k] :
+		     (v[k] > lo[k] + ICWIDTH - 1) ? v[k] - lo[k] - ICWIDTH + 1 : 0;
+		d2 = imax(iabs(v[k] - lo[k]),iabs(v[k] - lo[k] - ICWIDTH + 1));
+		dmin[i] += d1 * d1;
+		dmax    += d2 * d2;
+	    }
+	    if(dmax < maxlimit) maxlimit = dmax;
+	}
+	c->ncand = 0;
+	for(i = 0; i < (int)CLRINFO->ncolors; i++) {
+	    if(!MATCHABLE(i) || (dmin[i] > maxlimit)) continue;
+	    if(c->ncand == ICMAXCAND) {
+		c->ncand = ICFULL;
+		break;
+	    }
+	    c->cand[c->ncand++] = i;
+	}
+	c->gen = icgen;
+}
+
+/* true if GrAllocColor can use a new entry instead of the nearest one, */
+/* icreach is set to the last entry checked by the full scan, it stops  */
+/* when it has seen a free entry and all the used ones                  */
+static int iccanallocate(void)
+{
+	int i,allfree = (-1);
+	int ndef = (int)CLRINFO->ncolors - (int)CLRINFO->nfree;
+	if(iccangen != icgen) {
+	    iccanalloc = FALSE;
+	    icreach = (int)CLRINFO->ncolors - 1;
+	    for(i = 0; i < (int)CLRINFO->ncolors; i++) {
+		if(!CLRINFO->ctable[i].defined ||
+		   (!CLRINFO->ctable[i].writable && !CLRINFO->ctable[i].nused))
+		    iccanalloc = TRUE;
+		if(CLRINFO->ctable[i].defined) {
+		    if(CLRINFO->ctable[i].nused) ndef--;
+		}
+		else if(allfree < 0) allfree = i;
+		if((allfree >= 0) && (ndef <= 0)) {
+		    icreach = i;
+		    break;
+		}
+	    }
+	    iccangen = icgen;
+	}
+	return(iccanalloc);
+}
+
 static void loadcolor(int c,int r,int g,int b)
 {
+	_GrColorCacheInvalidate();
 	CLRINFO->ctable[c].r = (r &= CLRINFO->mask[0]);
 	CLRINFO->ctable[c].g = (g &= CLRINFO->mask[1]);
 	CLRINFO->ctable[c].b = (b &= CLRINFO->mask[2]);
@@ -84,6 +190,7 @@ int _GrResetColors(void)
 	    firsttime = FALSE;
 	}
 	sttzero(CLRINFO);
+	_GrColorCacheInvalidate();
 	if(DRVINFO->actmode.extinfo->mode == GR_frameText) {
 		if ( infosave ) {
 //			memcpy(CLRINFO,infosave,sizeof(infosave));
@@ -185,7 +292,33 @@ GrColor GrAllocColor(int r,int g,int b)
 	    int i;
 	    int free_ = (-1),allfree = (-1),best = (-1);
 	    int ndef = (int)CLRINFO->ncolors - (int)CLRINFO->nfree;
+	    iccell *c;
             DBGPRINTF(DBG_COLOR,("Allocating color: r=%d, g=%d, b=%d\n",r,g,b));
+	    if(icache == NULL) icache = calloc(ICSIZE,sizeof(iccell));
+	    if(icache != NULL) {
+		c = &icache[((r >> (8 - ICBITS)) << (2 * ICBITS)) |
+			    ((g >> (8 - ICBITS)) << ICBITS) |
+			     (b >> (8 - ICBITS))];
+		if(c->gen != icgen) icbuildcell(c,r,g,b);
+		if(c->ncand != ICFULL) {
+		    for(i = 0; i < c->ncand; i++) {
+			int k = c->cand[i];
+			GR_int32u err = (r - CLRINFO->ctable[k].r) * (r - CLRINFO->ctable[k].r) +
+					(g - CLRINFO->ctable[k].g) * (g - CLRINFO->ctable[k].g) +
+					(b - CLRINFO->ctable[k].b) * (b - CLRINFO->ctable[k].b);
+			if(err < minerr) {
+			    best = k;
+			    if((minerr = err) == 0) break;
+			}
+		    }
+		    /* exact match (where the full scan finds it), or the */
+		    /* nearest if no entry can be allocated               */
+		    if(!iccanallocate()) goto foundbest;
+		    if((minerr == 0) && (best <= icreach)) goto foundbest;
+		    minerr = 1000;
+		    best = (-1);
+		}
+	    }
 	    for(i = 0; i < (int)CLRINFO->ncolors; i++) {
 		if(CLRINFO->ctable[i].defined) {
 		    if(!CLRINFO->ctable[i].writable) {
@@ -238,7 +371,10 @@ GrColor GrAllocColor(int r,int g,int b)
 	  foundbest:
 	    if(best >= 0) {
                 DBGPRINTF(DBG_COLOR,("Using best %d\n", best));
-		if(!CLRINFO->ctable[best].nused) CLRINFO->nfree--;
+		if(!CLRINFO->ctable[best].nused) {
+		    CLRINFO->nfree--;
+		    _GrColorCacheInvalidate();
+		}
 		CLRINFO->ctable[best].nused++;
 		res = best;
                 goto done;
@@ -278,6 +414,7 @@ void GrFreeColor(GrColor c)
 	    !CLRINFO->ctable[(int)(c)].writable &&
 	    CLRINFO->ctable[(int)(c)].defined &&
 	    (--CLRINFO->ctable[(int)(c)].nused == 0)) {
+		_GrColorCacheInvalidate();
 		CLRINFO->nfree++;
 		CLRINFO->ctable[(int)(c)].defined  = FALSE;
 		CLRINFO->ctable[(int)(c)].writable = FALSE;
@@ -290,6 +427,7 @@ void GrFreeCell(GrColor c)
         GRX_ENTER();
 	if(!CLRINFO->RGBmode && ((GrColor)(c) < CLRINFO->ncolors)) {
 	    if(CLRINFO->ctable[(int)(c)].writable) {
+		_GrColorCacheInvalidate();
 		CLRINFO->nfree++;
 		CLRINFO->ctable[(int)(c)].defined  = FALSE;
 		CLRINFO->ctable[(int)(c)].writable = FALSE;
@@ -303,6 +441,7 @@ void GrSetColor(GrColor c,int r,int g,int b)
 {
         GRX_ENTER();
 	if(!CLRINFO->RGBmode && ((GrColor)(c) < CLRINFO->ncolors)) {
+	    _GrColorCacheInvalidate();
 	    if(!CLRINFO->ctable[(int)(c)].defined) {
 		CLRINFO->ctable[(int)(c)].defined  = TRUE;
 		CLRINFO->ctable[(int)(c)].nused    = 0;
@@ -362,6 +501,7 @@ void GrRestoreColors(void *buffer)
 	colorsave *cp = (colorsave *)buffer;
 	if((cp->magic == CSAVE_MAGIC) && (cp->nc == GrNumColors())) {
 	    sttcopy(CLRINFO,&cp->info);
+	    _GrColorCacheInvalidate();
 	    GrRefreshColors();
 	}
 }
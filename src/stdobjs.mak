@@ -25,11 +25,13 @@ STD_1 = $(OP)draw/bitblt$(OX)       \
 	$(OP)draw/plot$(OX)         \
 	$(OP)draw/putscl$(OX)       \
 	$(OP)draw/flodspil$(OX)     \
-	$(OP)draw/strchblt$(OX)
+	$(OP)draw/strchblt$(OX)     \
+	$(OP)draw/strchflt$(OX)
 
 STD_2 = $(OP)fdrivers/dotab8$(OX)   \
 	$(OP)fdrivers/ftable$(OX)   \
 	$(OP)fdrivers/genblit$(OX)  \
+	$(OP)fdrivers/gencover$(OX) \
 	$(OP)fdrivers/gengiscl$(OX) \
 	$(OP)fdrivers/genptscl$(OX) \
 	$(OP)fdrivers/genstrch$(OX) \
@@ -50,10 +52,12 @@ STD_2 = $(OP)fdrivers/dotab8$(OX)   \
 	$(OP)newfdrv/nram32h$(OX)   \
 	$(OP)fdrivers/rblit_14$(OX)
 
-STD_3 = $(OP)fonts/fdv_bgi$(OX)     \
+STD_3 = $(OP)fonts/fdv_bdf$(OX)     \
+	$(OP)fonts/fdv_bgi$(OX)     \
 	$(OP)fonts/fdv_grx$(OX)     \
 	$(OP)fonts/fdv_raw$(OX)     \
 	$(OP)fonts/fdv_fna$(OX)     \
+	$(OP)fonts/fdv_mfn$(OX)     \
 	$(OP)fonts/fdv_win$(OX)     \
 	$(OP)fonts/fdtable$(OX)     \
 	$(OP)fonts/pc6x8$(OX)       \
@@ -64,7 +68,11 @@ STD_3 = $(OP)fonts/fdv_bgi$(OX)     \
 	$(OP)fonts/px11x22$(OX)     \
 	$(OP)fonts/px14x28$(OX)     \
 	$(OP)gformats/ctx2pnm$(OX)  \
-	$(OP)gformats/pnm2ctx$(OX)
+	$(OP)gformats/pnm2ctx$(OX)  \
+	$(OP)gformats/ctx2qoi$(OX)  \
+	$(OP)gformats/qoi2ctx$(OX)  \
+	$(OP)gformats/dither$(OX)   \
+	$(OP)gformats/optpal$(OX)
 
 STD_4 = $(OP)gcursors/bldcurs$(OX)  \
 	$(OP)gcursors/drawcurs$(OX) \
@@ -72,6 +80,7 @@ STD_4 = $(OP)gcursors/bldcurs$(OX)  \
 	$(OP)input/mouinlne$(OX)    \
 	$(OP)input/mscursor$(OX)    \
 	$(OP)input/grevent$(OX)     \
+	$(OP)input/evrecord$(OX)    \
 	$(OP)input/recode$(OX)      \
 	$(OP)input/auxintl$(OX)     \
 	$(OP)input/uperlowr$(OX)    \
@@ -152,20 +161,28 @@ STD_7 = $(OP)shape/circle1$(OX)     \
 STD_8 = $(OP)text/buildaux$(OX)     \
 	$(OP)text/buildfnt$(OX)     \
 	$(OP)text/convfont$(OX)     \
+	$(OP)text/covfont$(OX)      \
 	$(OP)text/drawstrg$(OX)     \
 	$(OP)text/drawtext$(OX)     \
 	$(OP)text/drwstrg$(OX)      \
 	$(OP)text/dumpfna$(OX)      \
 	$(OP)text/dumpfont$(OX)     \
 	$(OP)text/dumpgrx$(OX)      \
+	$(OP)text/dumpmfn$(OX)      \
 	$(OP)text/epatstrg$(OX)     \
+	$(OP)text/fntcache$(OX)     \
 	$(OP)text/fntinlne$(OX)     \
 	$(OP)text/fontinfo$(OX)     \
 	$(OP)text/fontpath$(OX)     \
 	$(OP)text/frecode$(OX)      \
+	$(OP)text/glycache$(OX)     \
+	$(OP)text/glyphmap$(OX)     \
 	$(OP)text/loadfont$(OX)     \
 	$(OP)text/pattstrg$(OX)     \
+	$(OP)text/rotstrg$(OX)      \
+	$(OP)text/strkfont$(OX)     \
 	$(OP)text/strsize$(OX)      \
+	$(OP)text/textrun$(OX)      \
 	$(OP)text/unloadfn$(OX)
 
 STD_9 = $(OP)user/ubox$(OX)     \
@@ -224,7 +241,8 @@ STD_10= $(OP)user/upcirca$(OX)      \
 	$(OP)user/utextxy$(OX)      \
 	$(OP)user/uvline$(OX)
 
-STD_11= $(OP)utils/resize$(OX)      \
+STD_11= $(OP)utils/framstat$(OX)    \
+	$(OP)utils/resize$(OX)      \
 	$(OP)utils/ordswap$(OX)     \
 	$(OP)utils/shiftscl$(OX)    \
 	$(OP)utils/strmatch$(OX)    \
@@ -15,6 +15,7 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 220715 M.Alvarez, fonts can be sparse
+ ** 261019 M.Alvarez, fonts can have a glyph map
  **
  **/
 
@@ -23,11 +24,11 @@
 
 char *GrBuildAuxiliaryBitmap(GrFont *f,unsigned int chr,int dir,int ul)
 {
-    unsigned int idx = (unsigned int)chr - f->h.minchar;
+    int  idx = GrFontCharGlyph(f,chr);
     unsigned int bpos,rbpos,size,rsize,w,h;
     int  boff,rboff,rbinc;
     char *stdmap,*cvtmap;
-    if(idx >= f->h.numchars) return(NULL);
+    if(idx < 0) return(NULL);
     if(f->chrinfo[idx].width == 0) return(NULL); // a sparse font
     stdmap = &f->bitmap[f->chrinfo[idx].offset];
     dir = (dir & 3) + ((ul && (f->h.ulheight > 0)) ? 4 : 0);
@@ -37,7 +38,8 @@ char *GrBuildAuxiliaryBitmap(GrFont *f,unsigned int chr,int dir,int ul)
         if(offs > 0) return(&f->auxmap[offs - 1]);
     }
     else {
-        size = sizeof(f->auxoffs[0][0]) * f->h.numchars;
+        size = sizeof(f->auxoffs[0][0]) *
+               (f->glyphmap ? f->numglyphs : f->h.numchars);
         f->auxoffs[dir] = malloc(size);
         if(f->auxoffs[dir] == NULL) return(NULL);
         memset(f->auxoffs[dir],0,size);
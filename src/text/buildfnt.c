@@ -15,6 +15,7 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 220715 M.Alvarez, fonts can be sparse
+ ** 261019 M.Alvarez, glyph map for big sparse fonts
  **
  **/
 
@@ -205,7 +206,8 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
     unsigned long totwdt = 0L;
     unsigned long bmplen = 0L;
     unsigned int  bmpofs = 0;
-    unsigned int  numch,i,chr;
+    unsigned int  numch,nglyph,ninfo,i,chr;
+    int  idx;
     char  *bmp = NULL;
     conv  cv;
 
@@ -231,10 +233,25 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
         hgt = h->height;
     }
     numch = cmax - cmin + 1;
-    i = sizeof(GrFont) + ((numch - 1) * sizeof(GrFontChrInfo));
+    nglyph = 0;
+    for(chr = cmin,i = 0; i < numch; chr++,i++) {
+        int  oldw = (*charwdt)(chr);
+        if(oldw < 0) goto error;
+        if(oldw > 0) nglyph++;
+        else if(!h->sparse) goto error;
+    }
+    ninfo = numch;
+    if(h->sparse && (nglyph > 0) && _GrFontUseGlyphMap(numch,nglyph)) ninfo = nglyph;
+    i = sizeof(GrFont) + ((ninfo - 1) * sizeof(GrFontChrInfo));
     f = malloc(i);
     if(!f) goto error;
     memset(f,0,i);
+    f->h.minchar  = cmin;
+    f->h.numchars = numch;
+    if(ninfo != numch) {
+        if(!_GrFontNewGlyphMap(f)) goto error;
+        f->numglyphs = ninfo;
+    }
     f->h.name   = malloc(strlen(h->name)   + 1);
     f->h.family = malloc(strlen(h->family) + 1);
     if(!f->h.name || !f->h.family) goto error;
@@ -242,19 +259,24 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
     strcpy(f->h.family,h->family);
     f->minwidth = 0x7fff;
     f->maxwidth = 0;
-    for(chr = cmin,i = 0; i < numch; chr++,i++) {
+    for(chr = cmin,i = 0,idx = 0; i < numch; chr++,i++) {
         int  oldw = (*charwdt)(chr);
         if(oldw < 0) goto error;
-        f->chrinfo[i].width = oldw;
+        if(f->glyphmap) {
+            if(oldw == 0) continue;
+            if(!_GrFontSetGlyph(f,i,idx)) goto error;
+        }
+        else idx = i;
+        f->chrinfo[idx].width = oldw;
         if (oldw == 0) {
-            if (!h->sparse) goto error;
-            f->chrinfo[i].offset = 0;
+            f->chrinfo[idx].offset = 0;
         } else {
             unsigned int neww = urscale(oldw,wdt,h->width);
             if(f->minwidth > neww) f->minwidth = neww;
             if(f->maxwidth < neww) f->maxwidth = neww;
             bmplen += ((neww + 7) >> 3) * hgt;
         }
+        idx++;
     }
     cv.oldhgt = scaled ? hgt : h->height;
     cv.newhgt = hgt;
@@ -273,14 +295,14 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
     if((cvt & GR_FONTCVT_FIXIFY) && fprop) {
         bmpcv     |= GR_FONTCVT_FIXIFY;
         cv.fixwdt  = f->maxwidth;
-        bmplen     = umul32((hgt * ((cv.fixwdt + 7) >> 3)),numch);
+        bmplen     = umul32((hgt * ((cv.fixwdt + 7) >> 3)),ninfo);
         cv.dofix   = TRUE;
         fprop      = FALSE;
     }
     if((cvt & GR_FONTCVT_PROPORTION) && !fprop) {
         bmpcv     |= GR_FONTCVT_PROPORTION;
         cv.propgap = imax(0,(PROPGAP(wdt) - cv.italwdt));
-        bmplen     = umul32((hgt * ((wdt + cv.propgap + 7) >> 3)),numch);
+        bmplen     = umul32((hgt * ((wdt + cv.propgap + 7) >> 3)),ninfo);
         cv.doprop  = TRUE;
         fprop      = TRUE;
     }
@@ -296,10 +318,11 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
     f->minwidth = 0x7fff;
     f->maxwidth = 0;
     for(chr = cmin,i = 0; i < numch; chr++,i++) {
-        unsigned int oldw = f->chrinfo[i].width;
+        unsigned int oldw,neww,size;
+        if((idx = GrFontCharGlyph(f,chr)) < 0) continue;
+        oldw = f->chrinfo[idx].width;
         if (oldw == 0) continue;  // a sparse font
-        unsigned int neww = imax(urscale(oldw,wdt,h->width),1);
-        unsigned int size;
+        neww = imax(urscale(oldw,wdt,h->width),1);
         if(scaled) {
             unsigned int raww = neww - cv.boldwdt - cv.italwdt;
             if(!(*bitmap)(chr,raww,hgt,bmp)) goto error;
@@ -313,8 +336,8 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
         if(f->maxwidth < neww) f->maxwidth = neww;
         size = ((neww + 7) >> 3) * hgt;
         memcpy(&f->bitmap[bmpofs],bmp,size);
-        f->chrinfo[i].width  = neww;
-        f->chrinfo[i].offset = bmpofs;
+        f->chrinfo[idx].width  = neww;
+        f->chrinfo[idx].offset = bmpofs;
         bmpofs += size;
         totwdt += neww;
     }
@@ -324,7 +347,7 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
     f->h.modified     = h->modified | chrcv | bmpcv;
     f->h.minchar      = cmin;
     f->h.numchars     = numch;
-    f->h.width        = (cv.dofix || cv.doprop) ? (unsigned int)(totwdt / numch) : wdt;
+    f->h.width        = (cv.dofix || cv.doprop) ? (unsigned int)(totwdt / ninfo) : wdt;
     f->h.height       = hgt;
     f->h.baseline     = urscale(h->baseline,hgt,h->height);
     f->h.ulpos        = urscale(h->ulpos,   hgt,h->height);
@@ -341,6 +364,7 @@ GrFont *_GrBuildFont(const GrFontHeader *h, int  cvt, int  wdt, int  hgt,
         if(f->h.name)   free(f->h.name);
         if(f->h.family) free(f->h.family);
         if(f->bitmap)   free(f->bitmap);
+        _GrFontFreeGlyphMap(f);
         free(f);
         f = NULL;
     }
@@ -15,6 +15,8 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 220715 M.Alvarez, fonts can be sparse
+ ** 261019 M.Alvarez, keep the coverage map if the glyphs aren't changed
+ ** 261019 M.Alvarez, fonts can have a glyph map
  **
  **/
 
@@ -26,30 +28,45 @@ static const GrFont *cvfont;
 
 static int charwdt(int chr)
 {
-    chr -= cvfont->h.minchar;
-    if ((unsigned int)chr >= cvfont->h.numchars) return(-1);
-    return (cvfont->chrinfo[chr].width);
+    int g;
+    if ((unsigned int)chr - cvfont->h.minchar >= cvfont->h.numchars) return(-1);
+    if ((g = GrFontCharGlyph(cvfont,chr)) < 0) return(0); // a sparse font
+    return (cvfont->chrinfo[g].width);
 }
 
 static int bitmap(int chr,int w,int h,char *buffer)
 {
-    chr -= cvfont->h.minchar;
-    if ((unsigned int)chr >= cvfont->h.numchars)       return (FALSE);
-    if (cvfont->chrinfo[chr].width == 0)               return (FALSE); // a sparse font
-    if ((unsigned int)w != cvfont->chrinfo[chr].width) return (FALSE);
-    if ((unsigned int)h != cvfont->h.height)           return (FALSE);
+    int g = GrFontCharGlyph(cvfont,chr);
+    if (g < 0)                                       return (FALSE);
+    if (cvfont->chrinfo[g].width == 0)               return (FALSE); // a sparse font
+    if ((unsigned int)w != cvfont->chrinfo[g].width) return (FALSE);
+    if ((unsigned int)h != cvfont->h.height)         return (FALSE);
     memcpy(
         buffer,
-        &cvfont->bitmap[cvfont->chrinfo[chr].offset],
+        &cvfont->bitmap[cvfont->chrinfo[g].offset],
         ((w + 7) >> 3) * h
     );
     return (TRUE);
 }
 
+static int coverage(int chr,int w,int h,unsigned char *buffer)
+{
+    unsigned char *cov = GrFontCharCoverage(cvfont,chr);
+    if (cov == NULL) return (FALSE);
+    if ((unsigned int)w != (unsigned int)GrFontCharWidth(cvfont,chr)) return (FALSE);
+    if ((unsigned int)h != cvfont->h.height) return (FALSE);
+    memcpy(buffer, cov, ((w + 7) & ~7) * h);
+    return (TRUE);
+}
+
 GrFont *GrBuildConvertedFont(const GrFont *from,int cvt,int w,int h,int minch,int maxch)
 {
+    GrFont *f;
+
     cvfont = from;
     if (!cvfont) return(NULL);
-    return (_GrBuildFont(&from->h,cvt,w,h,minch,maxch,charwdt,bitmap,FALSE));
+    f = _GrBuildFont(&from->h,cvt,w,h,minch,maxch,charwdt,bitmap,FALSE);
+    if (f && from->covmap) _GrBuildFontCoverage(f,coverage);
+    return (f);
 }
 
@@ -0,0 +1,180 @@
+/**
+ ** covfont.c ---- anti-aliased (8 bit coverage) fonts
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** An anti-aliased font is a normal font (its 1 bpp bitmap is used for
+ ** rotated, underlined or pattern filled text and in palette modes)
+ ** plus a coverage map with a byte per pixel. Glyph rows in the coverage
+ ** map are (width + 7) & ~7 bytes, so glyph offsets are the bitmap ones
+ ** times 8 and no more tables are needed.
+ **
+ **/
+
+#include <string.h>
+#include "libgrx.h"
+#include "grfontdv.h"
+#include "arith.h"
+
+/*
+ * _GrBuildFontCoverage - fills the coverage map of a font just built by
+ * _GrBuildFont, nothing is done if the glyphs were converted (scalable
+ * fonts can be resized, the driver renders them at any size). Returns 0
+ * if done, -1 on error (the font is usable anyway, without coverage).
+ * Most fonts have no coverage, so the first glyph is asked for before
+ * allocating the map.
+ */
+int _GrBuildFontCoverage(GrFont *f,
+                         int (*coverage)(int chr,int w,int h,unsigned char *buffer))
+{
+    unsigned long size = 0;
+    unsigned int i, end, ninfo, cvtok, first, psize;
+    unsigned char *probe;
+    int g = -1;
+
+    cvtok = GR_FONTCVT_SKIPCHARS;
+    if (f->h.scalable) cvtok |= GR_FONTCVT_RESIZE;
+    if (f->h.modified & ~cvtok) return(-1);
+    ninfo = f->glyphmap ? f->numglyphs : f->h.numchars;
+    for (i = 0; i < ninfo; i++) {
+        if (f->chrinfo[i].width == 0) continue; /* a sparse font */
+        end = f->chrinfo[i].offset +
+              ((f->chrinfo[i].width + 7) >> 3) * f->h.height;
+        if (end > size) size = end;
+    }
+    if (size == 0) return(-1);
+    for (first = 0; first < f->h.numchars; first++) {
+        g = GrFontCharGlyph(f, f->h.minchar + first);
+        if (g >= 0 && f->chrinfo[g].width != 0) break;
+    }
+    if (first == f->h.numchars) return(-1);
+    psize = ((f->chrinfo[g].width + 7) & ~7) * f->h.height;
+    probe = calloc(psize, 1);
+    if (probe == NULL) return(-1);
+    if (!(*coverage)(f->h.minchar + first, f->chrinfo[g].width, f->h.height,
+                     probe)) {
+        free(probe);
+        return(-1);
+    }
+    f->covmap = calloc(size, 8);
+    if (f->covmap == NULL) {
+        free(probe);
+        return(-1);
+    }
+    memcpy(&f->covmap[f->chrinfo[g].offset << 3], probe, psize);
+    free(probe);
+    for (i = first + 1; i < f->h.numchars; i++) {
+        if ((g = GrFontCharGlyph(f, f->h.minchar + i)) < 0) continue;
+        if (f->chrinfo[g].width == 0) continue;
+        if (!(*coverage)(f->h.minchar + i, f->chrinfo[g].width, f->h.height,
+                         &f->covmap[f->chrinfo[g].offset << 3])) {
+            free(f->covmap);
+            f->covmap = NULL;
+            return(-1);
+        }
+    }
+    return(0);
+}
+
+/* box filter of a font scale times bigger */
+
+static const GrFont *bgfont;
+static int bgscale;
+
+static int charwdt(int chr)
+{
+    if (!GrFontCharPresent(bgfont, chr)) return (0); /* sparse font */
+    return ((GrFontCharWidth(bgfont, chr) + bgscale - 1) / bgscale);
+}
+
+static int boxsum(const char *bmp, int bw, int bh, int x, int y)
+{
+    int pitch = (bw + 7) >> 3;
+    int xx, yy, n = 0;
+
+    for (yy = y * bgscale; yy < (y + 1) * bgscale && yy < bh; yy++) {
+        for (xx = x * bgscale; xx < (x + 1) * bgscale && xx < bw; xx++) {
+            if (bmp[yy * pitch + (xx >> 3)] & (0x80 >> (xx & 7))) n++;
+        }
+    }
+    return n;
+}
+
+static int coverage(int chr,int w,int h,unsigned char *buffer)
+{
+    const char *bmp = GrFontCharBitmap(bgfont, chr);
+    int bw = GrFontCharWidth(bgfont, chr);
+    int bh = bgfont->h.height;
+    int area = bgscale * bgscale;
+    int x, y, pitch = (w + 7) & ~7;
+
+    if (bmp == NULL) return (FALSE);
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++)
+            buffer[y * pitch + x] = (boxsum(bmp, bw, bh, x, y) * 255 + area / 2) / area;
+    }
+    return (TRUE);
+}
+
+/* the bitmap has the pixels covered at least by half */
+static int bitmap(int chr,int w,int h,char *buffer)
+{
+    const char *bmp = GrFontCharBitmap(bgfont, chr);
+    int bw = GrFontCharWidth(bgfont, chr);
+    int bh = bgfont->h.height;
+    int area = bgscale * bgscale;
+    int x, y, pitch = (w + 7) >> 3;
+
+    if (bmp == NULL) return (FALSE);
+    memset(buffer, 0, pitch * h);
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            if (boxsum(bmp, bw, bh, x, y) * 2 >= area)
+                buffer[y * pitch + (x >> 3)] |= (0x80 >> (x & 7));
+        }
+    }
+    return (TRUE);
+}
+
+/*
+** GrBuildCoverageFont - Builds an anti-aliased font from a font scale
+** times bigger, every pixel is the average of a scale x scale box
+**
+** Returns the new font or NULL on error
+*/
+
+GrFont *GrBuildCoverageFont(const GrFont *from,int scale)
+{
+    GrFontHeader hdr;
+    GrFont *f;
+
+    if (from == NULL || scale < 1) return(NULL);
+    bgfont = from;
+    bgscale = scale;
+    hdr = from->h;
+    hdr.width    = (from->h.width  + scale - 1) / scale;
+    hdr.height   = (from->h.height + scale - 1) / scale;
+    hdr.baseline = from->h.baseline / scale;
+    hdr.ulheight = imax(1, from->h.ulheight / scale);
+    hdr.ulpos    = hdr.height - hdr.ulheight;
+    hdr.preloaded = FALSE;
+    hdr.modified  = GR_FONTCVT_NONE;
+    f = _GrBuildFont(&hdr, GR_FONTCVT_NONE, 0, 0, 0, 0, charwdt, bitmap, FALSE);
+    if (f == NULL) return(NULL);
+    if (_GrBuildFontCoverage(f, coverage) < 0) {
+        GrUnloadFont(f);
+        return(NULL);
+    }
+    return(f);
+}
@@ -19,15 +19,21 @@
  ** 080125 M.Alvarez, UTF-8 support
  ** 170706 M.Alvarez, rewrite for font encoding functionality
  ** 200620 M.Alvarez, solved an old bug
+ ** 261019 M.Alvarez, glyph cache when drawing with the frame driver
+ ** 261019 M.Alvarez, no memory allocation for strings up to 256 chars
+ ** 261019 M.Alvarez, anti-aliased fonts are blended in RGB modes
+ ** 261019 M.Alvarez, chars out of the BMP
+ ** 261019 M.Alvarez, _GrDrawWordText is used by the text runs
  **
  **/
 
 #include "libgrx.h"
+#include "grdriver.h"
 #include "clipping.h"
 #include "text/text.h"
 
-static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
-                   const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm)
+void _GrDrawWordText(const unsigned int *text,int length,int x,int y,
+                     const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm)
 {
   GrFont *f;
   int    x1;
@@ -48,6 +54,7 @@ static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
     int     hh    = (x1 &  rotat) | (y1 & ~rotat);
     int     x2, y2;
     int     oldx, oldy;
+    int     aa    = 0;
     switch(opt->txo_xalign) {
       case GR_ALIGN_RIGHT:
         x -= ww - 1;
@@ -67,6 +74,11 @@ static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
         y -= (hh >> 1);
         break;
     }
+    /* the coverage map is used for plain colors, else the 1bpp bitmap */
+    if((dbm == NULL) && f->covmap && CLRINFO->RGBmode && !undl &&
+       (opt->txo_direct == GR_TEXT_DEFAULT) && (C_OPER(fgcv) == C_WRITE) &&
+       ((bgcv == GrNOCOLOR) || (C_OPER(bgcv) == C_WRITE)))
+      aa = 1;
     mouse_block(CURC,x,y,(x + ww - 1),(y + hh - 1));
     oldx = x + CURC->gc_xoffset;
     oldy = y + CURC->gc_yoffset;
@@ -87,9 +99,10 @@ static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
         break;
     }
     while(--length >= 0) {
-      unsigned short chr;
+      unsigned int chr;
       int xx,yy,cw,ch;
       char *bmp;
+      unsigned char *cov;
       chr = text[0];
       text = text + 1;
       x1 = GrFontCharWidth(f,chr);
@@ -103,8 +116,39 @@ static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
       x += (cw & dxpost);
       y += (ch & dypost);
       clip_ordbox_(CURC,x1,y1,x2,y2,continue,CLIP_EMPTY_MACRO_ARG);
+      cov = aa ? GrFontCharCoverage(f,chr) : NULL;
+      if((dbm == NULL) && ((cov == NULL) || (bgcv != GrNOCOLOR)) &&
+         _GrGlyphCacheDraw(f,chr,opt->txo_direct,cw,ch,
+                           fgcv,bgcv,cov,
+                           (x1 + CURC->gc_xoffset),
+                           (y1 + CURC->gc_yoffset),
+                           (x1 - xx),(y1 - yy),
+                           (x2 - x1 + 1),(y2 - y1 + 1)))
+        continue;
+      if(cov) {
+        (*(FDRV->drawcoverage ? FDRV->drawcoverage : _GrFrDrvGenericDrawCoverage))(
+          (x1 + CURC->gc_xoffset),
+          (y1 + CURC->gc_yoffset),
+          (x2 - x1 + 1),
+          (y2 - y1 + 1),
+          cov + (x1 - xx) + ((y1 - yy) * ((cw + 7) & ~7)),
+          ((cw + 7) & ~7),
+          fgcv,bgcv
+          );
+        continue;
+      }
       bmp = GrFontCharAuxBmp(f,chr,opt->txo_direct,undl);
-      if(bmp) (*dbm)(
+      if(bmp && (dbm == NULL)) (*FDRV->drawbitmap)(
+        (x1 + CURC->gc_xoffset),
+        (y1 + CURC->gc_yoffset),
+        (x2 - x1 + 1),
+        (y2 - y1 + 1),
+        bmp,
+        ((cw + 7) >> 3),
+        ((x1 - xx) + ((y1 - yy) * ((cw + 7) & ~7))),
+        fgcv,bgcv
+        );
+      else if(bmp) (*dbm)(
         (x1 + CURC->gc_xoffset),
         (y1 + CURC->gc_yoffset),
         (x2 - x1 + 1),
@@ -132,21 +176,27 @@ static void _GrDrawWordText(const unsigned short *text,int length,int x,int y,
 void _GrDrawString(const void *text, int length, int x, int y,
                    const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm)
 {
-  unsigned short *text2;
+  unsigned int buf[TEXT_LOCALBUF];
+  unsigned int *text2;
 
   GRX_ENTER();
   if (text == NULL) return;
   if (length <= 0) length = GrStrLen(text, opt->txo_chrtype);
-  text2 = GrFontTextRecode(opt->txo_font, text, length, opt->txo_chrtype);
-  if (text2 == NULL) return;
+  if (length <= 0) return;
+  text2 = buf;
+  if (length > TEXT_LOCALBUF) {
+    text2 = malloc(length * sizeof(unsigned int));
+    if (text2 == NULL) return;
+  }
+  _GrFontTextRecodeBuf(opt->txo_font, text, length, opt->txo_chrtype, text2);
   _GrDrawWordText(text2, length, x, y, opt, p, dbm);
-  free(text2);
+  if (text2 != buf) free(text2);
 }
 
 void _GrDrawChar(long chr, int x, int y,
                  const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm)
 {
-  unsigned short schr;
+  unsigned int schr;
 
   GRX_ENTER();
   schr = GrFontCharRecode(opt->txo_font, chr, opt->txo_chrtype);
@@ -17,6 +17,7 @@
  ** Contributions by:
  ** 080125 M.Alvarez, UTF-8 support
  ** 170706 M.Alvarez, rewrite for font encoding functionality
+ ** 261019 M.Alvarez, GrDrawStrings
  **
  **/
 
@@ -25,25 +26,37 @@
 #include "clipping.h"
 #include "text/text.h"
 
-static void FdrvDrawBitmap(int x,int y,int w,int h,int ox, int oy,
-                           char *bmp,int pitch,int start,
-                           GrColor fg,GrColor bg,GrPattern *p)
+void GrDrawString(void *text,int length,int x,int y,const GrTextOption *opt)
 {
     GRX_ENTER();
-    (*FDRV->drawbitmap)(x,y,w,h,bmp,pitch,start,fg,bg);
+    _GrDrawString(text,length,x,y,opt,NULL,NULL);
     GRX_LEAVE();
 }
 
-void GrDrawString(void *text,int length,int x,int y,const GrTextOption *opt)
+/*
+ * GrDrawStrings - draws nitems strings, items with a NULL opt use the
+ * common one. The mouse cursor is blocked only once for all of them.
+ */
+void GrDrawStrings(const GrTextItem *items,int nitems,const GrTextOption *opt)
 {
+    const GrTextOption *o;
+    int i;
     GRX_ENTER();
-    _GrDrawString(text,length,x,y,opt,NULL,FdrvDrawBitmap);
+    mouse_block(CURC,CURC->gc_xcliplo,CURC->gc_ycliplo,
+                     CURC->gc_xcliphi,CURC->gc_ycliphi);
+    for (i = 0; i < nitems; i++) {
+        o = (items[i].opt != NULL) ? items[i].opt : opt;
+        if (o == NULL) continue;
+        _GrDrawString(items[i].text,items[i].length,items[i].x,items[i].y,
+                      o,NULL,NULL);
+    }
+    mouse_unblock();
     GRX_LEAVE();
 }
 
 void GrDrawChar(long chr,int x,int y,const GrTextOption *opt)
 {
     GRX_ENTER();
-    _GrDrawChar(chr,x,y,opt,NULL,FdrvDrawBitmap);
+    _GrDrawChar(chr,x,y,opt,NULL,NULL);
     GRX_LEAVE();
 }
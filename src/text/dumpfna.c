@@ -15,6 +15,7 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 220715 M.Alvarez, fonts can be sparse
+ ** 261019 M.Alvarez, anti-aliased fonts are written with "coverage 4"
  **
  **/
 
@@ -26,8 +27,9 @@
 int GrDumpFnaFont(const GrFont *f, char *fileName)
 {
     int chr;
-    int x, y, width, bytes;
+    int x, y, v, width, bytes;
     char *buffer;
+    unsigned char *cov;
 
     if (f->h.sparse) return 0; // .fna format can not store sparse fonts
     FILE *fp = fopen(fileName, "w");
@@ -48,19 +50,30 @@ int GrDumpFnaFont(const GrFont *f, char *fileName)
     fprintf(fp, "maxchar %d\n", f->h.minchar + f->h.numchars - 1);
     fprintf(fp, "baseline %d\n", f->h.baseline);
     fprintf(fp, "undwidth %d\n", f->h.ulheight);
+    if(f->covmap) fprintf(fp, "coverage 4\n");
     /* write characters */
     for(chr = f->h.minchar; chr < f->h.minchar + f->h.numchars; chr++) {
         width = GrFontCharWidth(f, chr);
         bytes = (width - 1) / 8 + 1;
         buffer = GrFontCharBitmap(f, chr);
+        cov = GrFontCharCoverage(f, chr);
         /* write character header */
         fprintf(fp, "\n; character %d", chr);
         if(isgraph(chr)) fprintf(fp, " (%c)", chr);
         fprintf(fp, " width = %d\n", width);
         /* write character data */
         for(y = 0; y < f->h.height; y++) {
-            for(x = 0; x < width; x++)
-                putc(buffer[x >> 3] & (1 << (7 - (x & 7))) ? '#' : '.', fp);
+            if(cov) {
+                for(x = 0; x < width; x++) {
+                    v = (cov[x] + 8) / 17;
+                    putc(v == 0 ? '.' : v == 15 ? '#' : "0123456789abcdef"[v], fp);
+                }
+                cov += (width + 7) & ~7;
+            }
+            else {
+                for(x = 0; x < width; x++)
+                    putc(buffer[x >> 3] & (1 << (7 - (x & 7))) ? '#' : '.', fp);
+            }
             putc('\n', fp);
             buffer += bytes;
         }
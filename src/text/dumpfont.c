@@ -15,6 +15,7 @@
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
  ** 220715 M.Alvarez, fonts can be sparse
+ ** 261019 M.Alvarez, dump the coverage map of anti-aliased fonts
  **
  **/
 
@@ -75,6 +76,9 @@ static char fonthdr[] =
 "        0,                          /* allocated size of auxiliary bitmap */\n"
 "        0,                          /* free space in auxiliary bitmap */\n"
 "        {  0\t\t"      "},          /* converted character bitmap offsets */\n"
+"        (unsigned char *)%-11s"     "/* coverage map */\n"
+"        0,                          /* glyphs in chrinfo */\n"
+"        0,                          /* char to glyph map */\n"
 "        {{ %d,\t0\t"   "}}          /* first character info */\n"
 "    },\n"
 "    {\n";
@@ -91,6 +95,32 @@ static char fontend[] =
 "};\n\n";
 
 /* ----------------------------------------------------------------------- */
+static char coveragehdr[] =
+
+"};\n"
+"\n"
+"static unsigned char %s[] = {\n";
+
+/* ----------------------------------------------------------------------- */
+
+static void dumpbytes(FILE *fp,const unsigned char *bmp,int len,int last)
+{
+    int  pos = 0,j;
+
+    fputs("    ",fp);
+    for(j = 0; j < len; j++) {
+        fprintf(fp,"0x%02x",(bmp[j] & 0xff));
+        if((j + 1) != len) {
+            putc(',',fp);
+            if(++pos != 12) continue;
+            fputs("\n    ",fp);
+            pos = 0;
+        }
+    }
+    if(!last) {
+        fputs(",\n",fp);
+    }
+}
 
 int GrDumpFont(const GrFont *f,char *CsymbolName,char *fileName)
 {
@@ -100,6 +130,7 @@ int GrDumpFont(const GrFont *f,char *CsymbolName,char *fileName)
     char fntname[200];
     char famname[200];
     char bitname[200];
+    char covname[200];
     char *p;
 
     FILE *fp = fopen(fileName,"w");
@@ -112,6 +143,7 @@ int GrDumpFont(const GrFont *f,char *CsymbolName,char *fileName)
     strcat(fntname,"\",");
     sprintf(famname,"\"%s\",",f->h.family);
     sprintf(bitname,"%s_bits",CsymbolName);
+    strcpy(covname,"0,");
     fprintf(fp,
         bitmaphdr,
         filname,
@@ -122,21 +154,22 @@ int GrDumpFont(const GrFont *f,char *CsymbolName,char *fileName)
         int  chr = i + f->h.minchar;
         int  len = GrFontCharBitmapSize(f,chr);
         if (len == 0) continue; // a sparse font
-        int  pos = 0,j;
-        char *bmp = GrFontCharBitmap(f,chr);
-        fprintf(fp,"    /* character %d */\n    ",chr);
-        for(j = 0; j < len; j++) {
-            fprintf(fp,"0x%02x",(bmp[j] & 0xff));
-            if((j + 1) != len) {
-                putc(',',fp);
-                if(++pos != 12) continue;
-                fputs("\n    ",fp);
-                pos = 0;
-            }
-        }
-        if((i + 1) != f->h.numchars) {
-            fputs(",\n",fp);
+        fprintf(fp,"    /* character %d */\n",chr);
+        dumpbytes(fp,(unsigned char *)GrFontCharBitmap(f,chr),len,
+                  ((i + 1) == f->h.numchars));
+    }
+    if(f->covmap) {
+        sprintf(covname,"%s_cov",CsymbolName);
+        fprintf(fp,coveragehdr,covname);
+        for(i = 0; i < f->h.numchars; i++) {
+            int  chr = i + f->h.minchar;
+            int  len = GrFontCharBitmapSize(f,chr) * 8;
+            if (len == 0) continue;
+            fprintf(fp,"    /* character %d */\n",chr);
+            dumpbytes(fp,GrFontCharCoverage(f,chr),len,
+                      ((i + 1) == f->h.numchars));
         }
+        strcat(covname,",");
     }
     fprintf(fp,
         fonthdr,
@@ -161,13 +194,14 @@ int GrDumpFont(const GrFont *f,char *CsymbolName,char *fileName)
         (strcat(bitname,","),bitname),
         f->minwidth,
         f->maxwidth,
-        GrFontCharWidth(f,f->h.minchar));
+        covname,
+        GrFontCharPresent(f,f->h.minchar) ? GrFontCharWidth(f,f->h.minchar) : 0);
     offset = GrFontCharBitmapSize(f,f->h.minchar);
     for(i = 1; i < f->h.numchars; i++) {
         int chr = i + f->h.minchar;
         fprintf(fp,
             charinfo,
-            GrFontCharWidth(f,chr),
+            GrFontCharPresent(f,chr) ? GrFontCharWidth(f,chr) : 0,
             offset,
             ((i == (f->h.numchars - 1)) ? ' ' : ','),
             chr);
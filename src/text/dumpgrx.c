@@ -74,6 +74,8 @@ int GrDumpGrxFont(const GrFont *f,char *fileName)
 
     isfixed = f->h.proportional ? FALSE : TRUE;
     if (isfixed && f->h.sparse) return 0;
+    /* chars are 16 bit in GRX font files */
+    if (f->h.minchar + f->h.numchars > 0x10000) return 0;
 
     fp = fopen(fileName,"w");
     if (!fp) return 0;
@@ -101,7 +103,8 @@ int GrDumpGrxFont(const GrFont *f,char *fileName)
             return 0;
         }
         for (i=0; i<f->h.numchars; i++) {
-            w = f->chrinfo[i].width;
+            w = GrFontCharPresent(f, f->h.minchar + i) ?
+                GrFontCharWidth(f, f->h.minchar + i) : 0;
             wtable[i] = w;
             if (w > 0)
                 bmpsize += ((w + 7) >> 3) * f->h.height;
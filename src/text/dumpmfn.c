@@ -0,0 +1,129 @@
+/**
+ ** dumpmfn.c ---- write a mappable font file from a font in memory
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "fonts/fdv_mfn.h"
+
+static void put32(FILE *fp, GR_int32u v)
+{
+    putc(v & 0xff, fp);
+    putc((v >> 8) & 0xff, fp);
+    putc((v >> 16) & 0xff, fp);
+    putc((v >> 24) & 0xff, fp);
+}
+
+static void pad8(FILE *fp, unsigned long pos)
+{
+    while (pos++ & 7) putc(0, fp);
+}
+
+/* glyph of the char minchar + i, NULL if not present */
+static const GrFontChrInfo *glyph(const GrFont *f, unsigned int i)
+{
+    int g = GrFontCharGlyph(f, f->h.minchar + i);
+
+    if (g < 0 || f->chrinfo[g].width == 0) return NULL;
+    return &f->chrinfo[g];
+}
+
+
+int GrDumpMfnFont(const GrFont *f, char *fileName)
+{
+    FILE *fp;
+    char name[MFN_NAMEWIDTH];
+    const GrFontChrInfo *ci;
+    unsigned long nranges, nglyphs, bmpsize, pos;
+    unsigned int i, j, g, size;
+
+    nranges = nglyphs = bmpsize = 0;
+    for (i = 0; i < f->h.numchars; i++) {
+        if ((ci = glyph(f, i)) == NULL) continue;
+        if (i == 0 || glyph(f, i - 1) == NULL) nranges++;
+        nglyphs++;
+        bmpsize += ((ci->width + 7) >> 3) * f->h.height;
+    }
+    if (nglyphs == 0) return 0;
+
+    fp = fopen(fileName, "wb");
+    if (!fp) return 0;
+
+    pos = sizeof(GrFontFileHeaderMFN) + 12 * nranges + 8 * nglyphs;
+    put32(fp, MFN_FONTMAGIC);
+    put32(fp, sizeof(GrFontFileHeaderMFN));
+    put32(fp, f->h.width);
+    put32(fp, f->h.height);
+    put32(fp, f->h.baseline);
+    put32(fp, f->h.ulpos);
+    put32(fp, f->h.ulheight);
+    put32(fp, f->h.minchar);
+    put32(fp, f->h.numchars);
+    put32(fp, f->h.proportional);
+    put32(fp, f->h.encoding);
+    put32(fp, f->h.usedefg);
+    put32(fp, f->h.defglyph);
+    put32(fp, f->minwidth);
+    put32(fp, f->maxwidth);
+    put32(fp, nranges);
+    put32(fp, nglyphs);
+    put32(fp, (pos + 7) & ~7UL);
+    put32(fp, bmpsize);
+    put32(fp, f->covmap ? ((((pos + 7) & ~7UL) + bmpsize + 7) & ~7UL) : 0);
+    memset(name, 0, MFN_NAMEWIDTH);
+    strncpy(name, f->h.name, MFN_NAMEWIDTH - 1);
+    fwrite(name, MFN_NAMEWIDTH, 1, fp);
+    memset(name, 0, MFN_NAMEWIDTH);
+    strncpy(name, f->h.family, MFN_NAMEWIDTH - 1);
+    fwrite(name, MFN_NAMEWIDTH, 1, fp);
+
+    /* ranges */
+    for (i = 0, g = 0; i < f->h.numchars; i = j) {
+        if (glyph(f, i) == NULL) { j = i + 1; continue; }
+        for (j = i; j < f->h.numchars && glyph(f, j) != NULL; j++);
+        put32(fp, f->h.minchar + i);
+        put32(fp, j - i);
+        put32(fp, g);
+        g += j - i;
+    }
+    /* glyphs, the bitmap is written packed in char order */
+    for (i = 0, size = 0; i < f->h.numchars; i++) {
+        if ((ci = glyph(f, i)) == NULL) continue;
+        put32(fp, ci->width);
+        put32(fp, size);
+        size += ((ci->width + 7) >> 3) * f->h.height;
+    }
+    pad8(fp, pos);
+    for (i = 0; i < f->h.numchars; i++) {
+        if ((ci = glyph(f, i)) == NULL) continue;
+        fwrite(&f->bitmap[ci->offset],
+               ((ci->width + 7) >> 3) * f->h.height, 1, fp);
+    }
+    if (f->covmap) {
+        pad8(fp, bmpsize);
+        for (i = 0; i < f->h.numchars; i++) {
+            if ((ci = glyph(f, i)) == NULL) continue;
+            fwrite(&f->covmap[ci->offset << 3],
+                   ((ci->width + 7) & ~7) * f->h.height, 1, fp);
+        }
+    }
+    i = !ferror(fp);
+    if (fclose(fp) != 0) i = 0;
+    return i;
+}
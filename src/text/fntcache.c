@@ -0,0 +1,310 @@
+/**
+ ** fntcache.c ---- cache of loaded fonts and index of the font dirs
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Fonts loaded from files are kept with a reference count, keyed by
+ ** the file path and the conversion parameters, so loading a font again
+ ** returns the same GrFont and GrUnloadFont frees it only when the last
+ ** reference is released. The requested name is kept too, it finds the
+ ** font without searching the font path again until the path changes.
+ ** Sizes built from scalable (BGI) fonts are slow to make, the last
+ ** MAXIDLE of them are kept after the last reference is released, until
+ ** GrFlushFontCache is called.
+ **
+ ** The _fonts.dir file of every font path dir is read once, a dir with
+ ** this file is not searched for fonts not listed in it.
+ **
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "libgrx.h"
+#include "grfontdv.h"
+
+#define MAXIDLE 8                       /* unused scalable fonts kept */
+
+typedef struct _cachedfont {
+    struct _cachedfont *next;
+    GrFont *font;
+    char   *name;                       /* requested name or NULL */
+    char   *path;                       /* font file */
+    int     cvt, w, h, minc, maxc;
+    int     refcnt;
+    int     detached;                   /* modified, not found any more */
+    long    idle;                       /* release order if refcnt == 0 */
+} cachedfont;
+
+typedef struct _fontdir {
+    struct _fontdir *next;
+    char   *dir;
+    int     nfiles;                     /* -1 if there is no _fonts.dir */
+    char  **files;
+} fontdir;
+
+static cachedfont *fonts = NULL;
+static fontdir *dirs = NULL;
+static long idleclock = 0;
+
+static char *newstr(const char *s)
+{
+    char *p = malloc(strlen(s) + 1);
+
+    if (p != NULL) strcpy(p, s);
+    return p;
+}
+
+static cachedfont *find(const char *name, const char *path,
+                        int cvt, int w, int h, int minc, int maxc)
+{
+    cachedfont *cf;
+
+    for (cf = fonts; cf != NULL; cf = cf->next) {
+        if (cf->detached) continue;
+        if (cf->cvt != cvt || cf->w != w || cf->h != h ||
+            cf->minc != minc || cf->maxc != maxc) continue;
+        if (path != NULL) {
+            if (strcmp(cf->path, path) == 0) return cf;
+        }
+        else if (cf->name != NULL && strcmp(cf->name, name) == 0)
+            return cf;
+    }
+    return NULL;
+}
+
+/*
+ * _GrFontCacheFind - returns the font loaded from path (or from name if
+ * path is NULL) with the same conversion parameters adding a reference,
+ * or NULL. A font found by path is found by name from now on.
+ */
+GrFont *_GrFontCacheFind(const char *name, const char *path,
+                         int cvt, int w, int h, int minc, int maxc)
+{
+    cachedfont *cf;
+
+    cf = find(name, path, cvt, w, h, minc, maxc);
+    if (cf == NULL) return NULL;
+    /* the name resolves to this font from now on */
+    if (name != NULL && cf->name == NULL) cf->name = newstr(name);
+    cf->refcnt++;
+    cf->idle = 0;
+    return cf->font;
+}
+
+/*
+ * _GrFontCacheAdd - adds a font just loaded, if there is no memory it is
+ * not cached and GrUnloadFont will free it as usual
+ */
+void _GrFontCacheAdd(GrFont *f, const char *name, const char *path,
+                     int cvt, int w, int h, int minc, int maxc)
+{
+    cachedfont *cf;
+
+    cf = malloc(sizeof(cachedfont));
+    if (cf == NULL) return;
+    cf->path = newstr(path);
+    cf->name = (name != NULL) ? newstr(name) : NULL;
+    if (cf->path == NULL) {
+        free(cf->name);
+        free(cf);
+        return;
+    }
+    cf->font = f;
+    cf->cvt = cvt;
+    cf->w = w;
+    cf->h = h;
+    cf->minc = minc;
+    cf->maxc = maxc;
+    cf->refcnt = 1;
+    cf->detached = 0;
+    cf->idle = 0;
+    cf->next = fonts;
+    fonts = cf;
+}
+
+/* frees the oldest unused fonts until there are only n */
+static void trimidle(int n)
+{
+    cachedfont **pcf, **pold, *cf;
+    int nidle;
+
+    for (;;) {
+        nidle = 0;
+        pold = NULL;
+        for (pcf = &fonts; (cf = *pcf) != NULL; pcf = &cf->next) {
+            if (cf->refcnt > 0) continue;
+            nidle++;
+            if (pold == NULL || cf->idle < (*pold)->idle) pold = pcf;
+        }
+        if (nidle <= n) return;
+        cf = *pold;
+        *pold = cf->next;
+        _GrFontFree(cf->font);
+        free(cf->name);
+        free(cf->path);
+        free(cf);
+    }
+}
+
+/*
+ * _GrFontCacheRelease - releases a reference to f, returns non zero if
+ * the font is still in use or kept by the cache, 0 if it must be freed
+ */
+int _GrFontCacheRelease(GrFont *f)
+{
+    cachedfont **pcf, *cf;
+
+    for (pcf = &fonts; (cf = *pcf) != NULL; pcf = &cf->next) {
+        if (cf->font != f) continue;
+        if (cf->refcnt == 0) return 1;  /* already unused */
+        if (--cf->refcnt > 0) return cf->refcnt;
+        if (f->h.scalable && !cf->detached) {
+            cf->idle = ++idleclock;
+            trimidle(MAXIDLE);
+            return 1;
+        }
+        *pcf = cf->next;
+        free(cf->name);
+        free(cf->path);
+        free(cf);
+        return 0;
+    }
+    return 0;
+}
+
+/*
+ * _GrFontCacheDetach - the font is going to be modified, it is not
+ * returned by the next loads (the references taken are still counted)
+ */
+void _GrFontCacheDetach(GrFont *f)
+{
+    cachedfont *cf;
+
+    for (cf = fonts; cf != NULL; cf = cf->next)
+        if (cf->font == f) cf->detached = 1;
+}
+
+/*
+ * GrFlushFontCache - frees the unused scalable fonts kept by the cache
+ */
+void GrFlushFontCache(void)
+{
+    trimidle(0);
+}
+
+/*
+ * _GrFontCacheNewPath - the font path changed, names must be searched
+ * again (the fonts are still found by file path)
+ */
+void _GrFontCacheNewPath(void)
+{
+    cachedfont *cf;
+
+    for (cf = fonts; cf != NULL; cf = cf->next) {
+        free(cf->name);
+        cf->name = NULL;
+    }
+}
+
+static int cmpfiles(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+static void readindex(fontdir *fd)
+{
+    char line[200], fname[200];
+    FILE *fp;
+    char **files;
+    int n, size;
+
+    fd->nfiles = -1;
+    fd->files = NULL;
+    strcpy(fname, fd->dir);
+    strcat(fname, "_fonts.dir");
+    fp = fopen(fname, "r");
+    if (fp == NULL) return;
+    n = size = 0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[0] == '#' || sscanf(line, "%199s", fname) != 1) continue;
+        if (n == size) {
+            size = size ? 2 * size : 64;
+            files = realloc(fd->files, size * sizeof(char *));
+            if (files == NULL) goto error;
+            fd->files = files;
+        }
+        if ((fd->files[n] = newstr(fname)) == NULL) goto error;
+        n++;
+    }
+    fclose(fp);
+    qsort(fd->files, n, sizeof(char *), cmpfiles);
+    fd->nfiles = n;
+    return;
+error:
+    /* no index, the dir is always searched */
+    fclose(fp);
+    while (--n >= 0) free(fd->files[n]);
+    free(fd->files);
+    fd->files = NULL;
+}
+
+/*
+ * _GrFontDirMayHave - returns FALSE if dir has a _fonts.dir index and
+ * fname isn't in it, with or without extension. It is only a hint, the
+ * dirs that return FALSE are searched after the others
+ */
+int _GrFontDirMayHave(const char *dir, const char *fname)
+{
+    fontdir *fd;
+    char **lo;
+    int len, i;
+
+    if (strchr(fname, '/') != NULL || strchr(fname, '\\') != NULL) return TRUE;
+    for (fd = dirs; fd != NULL; fd = fd->next) {
+        if (strcmp(fd->dir, dir) == 0) break;
+    }
+    if (fd == NULL) {
+        fd = malloc(sizeof(fontdir));
+        if (fd == NULL) return TRUE;
+        fd->dir = newstr(dir);
+        if (fd->dir == NULL) {
+            free(fd);
+            return TRUE;
+        }
+        readindex(fd);
+        fd->next = dirs;
+        dirs = fd;
+    }
+    if (fd->nfiles < 0) return TRUE;
+
+    /* "name" sorts just before "name.ext" */
+    len = strlen(fname);
+    lo = fd->files;
+    for (i = fd->nfiles; i > 0; ) {
+        if (strcmp(lo[i / 2], fname) < 0) {
+            lo += i / 2 + 1;
+            i -= i / 2 + 1;
+        }
+        else
+            i /= 2;
+    }
+    for (; lo < fd->files + fd->nfiles && strncmp(*lo, fname, len) == 0; lo++) {
+        if ((*lo)[len] == '\0') return TRUE;
+        if ((*lo)[len] == '.' && strchr(&(*lo)[len + 1], '.') == NULL) return TRUE;
+    }
+    return FALSE;
+}
@@ -18,6 +18,11 @@
 
 #include "libgrx.h"
 
+int (GrFontCharGlyph)(const GrFont *font,unsigned int chr)
+{
+	return(GrFontCharGlyph(font,chr));
+}
+
 int (GrFontCharPresent)(const GrFont *font,unsigned int chr)
 {
 	return(GrFontCharPresent(font,chr));
@@ -53,3 +58,8 @@ char *(GrFontCharAuxBmp)(GrFont *font,unsigned int chr,int dir,int ul)
 	return(GrFontCharAuxBmp(font,chr,dir,ul));
 }
 
+unsigned char *(GrFontCharCoverage)(const GrFont *font,unsigned int chr)
+{
+	return(GrFontCharCoverage(font,chr));
+}
+
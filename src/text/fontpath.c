@@ -77,6 +77,7 @@ void GrSetFontPath(char *p)
     if(_GrFontFileInfo.path != NULL) free(_GrFontFileInfo.path);
     _GrFontFileInfo.path  = NULL;
     _GrFontFileInfo.npath = npath;
+    _GrFontCacheNewPath();
     if(npath > 0) {
         _GrFontFileInfo.path = malloc((sizeof(char *) * npath) + totlen);
         if(_GrFontFileInfo.path == NULL) goto error;
@@ -16,38 +16,49 @@
  **/
 
 #include "libgrx.h"
+#include "grfontdv.h"
 #include "text/text.h"
  
 void GrFontSetEncoding(GrFont *font,int fontencoding)
 {
   if (font == NULL) return;
-  if (fontencoding >= 0 && fontencoding <= GR_FONTENC_LASTENC)
+  if (fontencoding >= 0 && fontencoding <= GR_FONTENC_LASTENC &&
+      fontencoding != font->h.encoding) {
+    /* the next loads of the font file must not get the changed font */
+    _GrFontCacheDetach(font);
     font->h.encoding = fontencoding;
+  }
 }
 
-int GrFontNeedRecode(const GrFont *font,int chrtype)
+static int needrecode(int fontenc,int chrtype)
 {
-  if (font == NULL) return 0;
-  if (font->h.encoding == GR_FONTENC_UNKNOWN) return 0;
+  if (fontenc == GR_FONTENC_UNKNOWN) return 0;
   if (chrtype == GR_BYTE_TEXT) return 0;
   if (chrtype == GR_WORD_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_CP437 &&
+  if (fontenc == GR_FONTENC_CP437 &&
       chrtype == GR_CP437_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_CP850 &&
+  if (fontenc == GR_FONTENC_CP850 &&
       chrtype == GR_CP850_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_ISO_8859_1 &&
+  if (fontenc == GR_FONTENC_ISO_8859_1 &&
       chrtype == GR_ISO_8859_1_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_CP1251 &&
+  if (fontenc == GR_FONTENC_CP1251 &&
       chrtype == GR_CP1251_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_CP1252 &&
+  if (fontenc == GR_FONTENC_CP1252 &&
       chrtype == GR_CP1252_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_CP1253 &&
+  if (fontenc == GR_FONTENC_CP1253 &&
       chrtype == GR_CP1253_TEXT) return 0;
-  if (font->h.encoding == GR_FONTENC_UNICODE &&
-      (chrtype == GR_UTF8_TEXT || chrtype == GR_UCS2_TEXT)) return 0;
+  if (fontenc == GR_FONTENC_UNICODE &&
+      (chrtype == GR_UTF8_TEXT || chrtype == GR_UCS2_TEXT ||
+       chrtype == GR_UCS4_TEXT)) return 0;
   return 1;
 }
 
+int GrFontNeedRecode(const GrFont *font,int chrtype)
+{
+  if (font == NULL) return 0;
+  return needrecode(font->h.encoding, chrtype);
+}
+
 static unsigned int _GrCharRecode(int fontenc,long chr,int chrtype)
 {
   long aux, aux2;
@@ -75,6 +86,7 @@ static unsigned int _GrCharRecode(int fontenc,long chr,int chrtype)
     break;
   case GR_UTF8_TEXT:
   case GR_UCS2_TEXT:
+  case GR_UCS4_TEXT:
     aux = chr;
     break;
   }
@@ -124,9 +136,8 @@ unsigned int GrFontCharRecode(const GrFont *font,long chr,int chrtype)
   long aux;
   
   if (chrtype == GR_UTF8_TEXT) {
-    aux = GrUTF8ToUCS2((unsigned char *)(&chr));
+    _GrRecode_UTF8_UCS4((unsigned char *)(&chr), &aux);
     chr = aux;
-//    chrtype = GR_UCS2_TEXT;
   }
 
   if (!GrFontNeedRecode(font, chrtype)) return chr;
@@ -134,14 +145,20 @@ unsigned int GrFontCharRecode(const GrFont *font,long chr,int chrtype)
   return _GrCharRecode(font->h.encoding, chr, chrtype);
 }
 
-unsigned short *GrFontTextRecode(const GrFont *font,const void *text,int length,int chrtype)
+/*
+ * _GrTextRecodeBuf - recodes length chars of text to buf for a font
+ * encoding, without allocating memory. Returns a pointer to the next
+ * char of text, so long strings can be recoded in pieces.
+ */
+const void *_GrTextRecodeBuf(int fontenc,const void *text,int length,
+                             int chrtype,unsigned int *buf)
 {
-  unsigned short *buf, *buf2;
-  int i, len2;
+  const unsigned char *s;
+  long des;
+  int i, nb;
 
-  if (length <= 0) length = 0;
+  if (length <= 0) return text;
 
-  buf = NULL;
   switch (chrtype) {
   case GR_BYTE_TEXT:
   case GR_CP437_TEXT:
@@ -150,43 +167,73 @@ unsigned short *GrFontTextRecode(const GrFont *font,const void *text,int length,
   case GR_CP1252_TEXT:
   case GR_CP1253_TEXT:
   case GR_ISO_8859_1_TEXT:
-    buf = calloc(length+1, sizeof(unsigned short));
-    if (buf == NULL) return NULL;
     for (i=0; i<length; i++) buf[i] = ((unsigned char *)text)[i];
+    text = (unsigned char *)text + length;
     break;
   case GR_WORD_TEXT:
   case GR_UCS2_TEXT:
-    buf = calloc(length+1, sizeof(unsigned short));
-    if (buf == NULL) return NULL;
     for (i=0; i<length; i++) buf[i] = ((unsigned short *)text)[i];
+    text = (unsigned short *)text + length;
+    break;
+  case GR_UCS4_TEXT:
+    for (i=0; i<length; i++) buf[i] = ((unsigned int *)text)[i];
+    text = (unsigned int *)text + length;
     break;
   case GR_UTF8_TEXT:
-    if (length == 0) {
-        buf = calloc(1, sizeof(unsigned short));
-        break;
-    }
-    buf = GrUTF8StrToUCS2Str((unsigned char *)text, &len2, length);
-    if (buf == NULL) return NULL;
-    if (len2 < length) { /* better that return NULL we add '?' */
-                         /* so programmer can see he has a bug */
-      buf2 = realloc(buf, (length+1) * sizeof(unsigned short));
-      if (buf2 == NULL) {
-          free(buf);
-          return NULL;
+    s = text;
+    for (i=0; i<length && *s != '\0'; i++) {
+      des = 0;
+      nb = _GrRecode_UTF8_UCS4(s, &des);
+      if (nb == 0) {
+        des = '?';
+        nb = 1;
       }
-      buf = buf2;
-      for (i=len2; i<length; i++) buf[i] = '?';
-      buf[length] = 0;
+      buf[i] = des;
+      s += nb;
     }
+    /* better that return NULL we add '?' */
+    /* so programmer can see he has a bug */
+    for (; i<length; i++) buf[i] = '?';
+    text = s;
     break;
+  default:
+    for (i=0; i<length; i++) buf[i] = 0;
+    return text;
   }
-  
-  if (!GrFontNeedRecode(font, chrtype)) return buf;
+
+  if (!needrecode(fontenc, chrtype)) return text;
 
   for (i=0; i<length; i++) {
-    buf[i] = _GrCharRecode(font->h.encoding, buf[i], chrtype);
+    buf[i] = _GrCharRecode(fontenc, buf[i], chrtype);
   }
-  
+
+  return text;
+}
+
+const void *_GrFontTextRecodeBuf(const GrFont *font,const void *text,int length,
+                                 int chrtype,unsigned int *buf)
+{
+  if (font == NULL) return _GrTextRecodeBuf(GR_FONTENC_UNKNOWN, text, length, chrtype, buf);
+  return _GrTextRecodeBuf(font->h.encoding, text, length, chrtype, buf);
+}
+
+unsigned short *GrFontTextRecode(const GrFont *font,const void *text,int length,int chrtype)
+{
+  unsigned int aux[TEXT_LOCALBUF];
+  unsigned short *buf;
+  int i, j, n;
+
+  if (length <= 0) length = 0;
+
+  buf = calloc(length+1, sizeof(unsigned short));
+  if (buf == NULL) return NULL;
+  for (i=0; i<length; i+=n) {
+    n = (length - i < TEXT_LOCALBUF) ? length - i : TEXT_LOCALBUF;
+    text = _GrFontTextRecodeBuf(font, text, n, chrtype, aux);
+    /* out of the BMP there is no room in 16 bits */
+    for (j=0; j<n; j++) buf[i+j] = (aux[j] > 0xFFFF) ? 0xFFFD : aux[j];
+  }
+
   return buf;
 }
 
@@ -256,6 +303,7 @@ static long _GrCharReverseRecode(int fontenc,unsigned int chr,int chrtype)
     _GrRecode_UCS2_UTF8(aux, (unsigned char *)&aux2);
     return aux2;
   case GR_UCS2_TEXT:
+  case GR_UCS4_TEXT:
     return aux;
   }
   
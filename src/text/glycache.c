@@ -0,0 +1,234 @@
+/**
+ ** glycache.c ---- cache of glyphs expanded to the frame pixel format
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Every glyph is expanded once (with the frame driver drawbitmap) to a
+ ** small RAM frame for a given font, direction, colors and destination
+ ** frame driver, then drawing it is a blit. Glyphs with transparent
+ ** background are kept as lists of foreground spans drawn with drawhline
+ ** (image blits are done pixel by pixel by most drivers). When the cache
+ ** is full it is flushed completely, text output usually reuses a small
+ ** set of glyphs and colors so it fills again quickly. Anti-aliased
+ ** glyphs with opaque background are blended once too.
+ **
+ **/
+
+#include <stdlib.h>
+#include "libgrx.h"
+#include "grdriver.h"
+#include "text/text.h"
+
+#define NBUCKETS        1024            /* must be a power of 2 */
+#define MAXGLYPHS       8192
+#define MAXBYTES        (4L * 1024L * 1024L)
+
+typedef struct _glyph {
+    struct _glyph *next;
+    GrFont        *font;
+    GrFrameDriver *fdrv;                /* destination frame driver */
+    GrColor        fg, bg;
+    unsigned int   chr;
+    int            dir;
+    GrContext     *ctx;                 /* expanded glyph, opaque background */
+    short         *spans;               /* y,x,len triplets, transparent bg */
+    int            nspans;
+    void (*blt)(GrFrame*,int,int,GrFrame*,int,int,int,int,GrColor);
+} glyph;
+
+static glyph *buckets[NBUCKETS];
+static long nglyphs = 0;
+static long nbytes = 0;
+
+static unsigned int hash(GrFont *f, unsigned int chr, int dir, GrColor fg, GrColor bg)
+{
+    unsigned long h = (unsigned long)f >> 4;
+
+    h = h * 31 + chr;
+    h = h * 31 + fg;
+    h = h * 31 + bg;
+    h = h * 31 + dir;
+    return (unsigned int)(h ^ (h >> 10)) & (NBUCKETS - 1);
+}
+
+/*
+ * _GrGlyphCacheFlush - removes the glyphs of font f from the cache,
+ * all of them if f is NULL
+ */
+void _GrGlyphCacheFlush(GrFont *f)
+{
+    glyph **pg, *g;
+    int i;
+
+    for (i=0; i<NBUCKETS; i++) {
+        pg = &buckets[i];
+        while ((g = *pg) != NULL) {
+            if (f == NULL || g->font == f) {
+                *pg = g->next;
+                if (g->ctx) {
+                    nbytes -= (long)g->ctx->gc_lineoffset * (g->ctx->gc_ymax + 1);
+                    GrDestroyContext(g->ctx);
+                }
+                if (g->spans) {
+                    nbytes -= (long)g->nspans * 3 * sizeof(short);
+                    free(g->spans);
+                }
+                free(g);
+                nglyphs--;
+            }
+            else
+                pg = &g->next;
+        }
+    }
+}
+
+/* foreground runs of the glyph bitmap, returns -1 on memory error */
+static int buildspans(glyph *g, char *bmp, int w, int h)
+{
+    int pitch = (w + 7) >> 3;
+    int x, y, x0, n, pass;
+
+    for (pass=0; pass<2; pass++) {
+        for (y=0,n=0; y<h; y++) {
+            unsigned char *row = (unsigned char *)&bmp[y * pitch];
+            for (x=0; x<w; ) {
+                if (!(row[x >> 3] & (0x80 >> (x & 7)))) { x++; continue; }
+                for (x0=x; x<w && (row[x >> 3] & (0x80 >> (x & 7))); x++);
+                if (pass) {
+                    g->spans[3*n]   = y;
+                    g->spans[3*n+1] = x0;
+                    g->spans[3*n+2] = x - x0;
+                }
+                n++;
+            }
+        }
+        if (pass == 0) {
+            g->nspans = n;
+            if (n == 0) return 0;
+            g->spans = malloc(n * 3 * sizeof(short));
+            if (g->spans == NULL) return -1;
+        }
+    }
+    nbytes += (long)n * 3 * sizeof(short);
+    return 0;
+}
+
+static glyph *expand(GrFont *f, unsigned int chr, int dir, int w, int h,
+                     GrColor fg, GrColor bg, const unsigned char *cov)
+{
+    GrContext save;
+    glyph *g;
+    char *bmp;
+
+    g = malloc(sizeof(glyph));
+    if (g == NULL) return NULL;
+    g->font = f;
+    g->fdrv = FDRV;
+    g->fg = fg;
+    g->bg = bg;
+    g->chr = chr;
+    g->dir = dir;
+    g->ctx = NULL;
+    g->spans = NULL;
+    g->nspans = 0;
+
+    bmp = GrFontCharAuxBmp(f, chr, dir, (fg & GR_UNDERLINE_TEXT) ? 1 : 0);
+    if (cov != NULL && bg == GrNOCOLOR) {
+        free(g);
+        return NULL;
+    }
+    if (bmp != NULL && bg == GrNOCOLOR) {
+        if (buildspans(g, bmp, w, h) < 0) {
+            free(g);
+            return NULL;
+        }
+    }
+    else if (bmp != NULL || cov != NULL) {
+        g->ctx = GrCreateFrameContext(FDRV->is_video ? FDRV->rmode : FDRV->mode,
+                                      w, h, NULL, NULL);
+        if (g->ctx == NULL) {
+            free(g);
+            return NULL;
+        }
+        if (g->ctx->gc_driver->mode == FDRV->mode)
+            g->blt = FDRV->bitblt;
+        else if (g->ctx->gc_driver->mode == FDRV->rmode)
+            g->blt = FDRV->bltr2v;
+        else {
+            GrDestroyContext(g->ctx);
+            free(g);
+            return NULL;
+        }
+        GrSaveContext(&save);
+        GrSetContext(g->ctx);
+        if (cov != NULL)
+            (*(FDRV->drawcoverage ? FDRV->drawcoverage :
+               _GrFrDrvGenericDrawCoverage))(0, 0, w, h, cov, (w + 7) & ~7, fg, bg);
+        else
+            (*FDRV->drawbitmap)(0, 0, w, h, bmp, (w + 7) >> 3, 0, fg, bg);
+        GrSetContext(&save);
+        nbytes += (long)g->ctx->gc_lineoffset * h;
+    }
+    nglyphs++;
+    return g;
+}
+
+/*
+ * _GrGlyphCacheDraw - draws the w x h area at sx,sy of the cw x ch glyph
+ * for chr at x,y (frame coordinates of the current context). cov is the
+ * glyph coverage map if it must be drawn anti-aliased. Returns 0 if the
+ * glyph can't be cached, then it must be drawn as usual.
+ */
+int _GrGlyphCacheDraw(GrFont *f, unsigned int chr, int dir, int cw, int ch,
+                      GrColor fg, GrColor bg, const unsigned char *cov, int x, int y,
+                      int sx, int sy, int w, int h)
+{
+    unsigned int hv;
+    glyph *g;
+
+    /* only plain writes can be expanded in advance */
+    if (C_OPER(fg) != C_WRITE) return 0;
+    if (bg != GrNOCOLOR && C_OPER(bg) != C_WRITE) return 0;
+    if (FDRV->num_planes != 1) return 0;
+
+    hv = hash(f, chr, dir, fg, bg);
+    for (g = buckets[hv]; g != NULL; g = g->next) {
+        if (g->chr == chr && g->font == f && g->fg == fg && g->bg == bg &&
+            g->dir == dir && g->fdrv == FDRV) break;
+    }
+    if (g == NULL) {
+        if (nglyphs >= MAXGLYPHS || nbytes >= MAXBYTES) _GrGlyphCacheFlush(NULL);
+        g = expand(f, chr, dir, cw, ch, fg, bg, cov);
+        if (g == NULL) return 0;
+        g->next = buckets[hv];
+        buckets[hv] = g;
+    }
+
+    if (g->ctx != NULL)
+        (*g->blt)(&CURC->gc_frame, x, y, &g->ctx->gc_frame, sx, sy, w, h, GrWRITE);
+    else if (g->spans != NULL) {
+        short *sp = g->spans;
+        int n, x1, x2;
+        for (n=g->nspans; n>0; n--, sp+=3) {
+            if (sp[0] < sy || sp[0] >= sy + h) continue;
+            x1 = (sp[1] > sx) ? sp[1] : sx;
+            x2 = (sp[1] + sp[2] < sx + w) ? sp[1] + sp[2] : sx + w;
+            if (x1 < x2)
+                (*FDRV->drawhline)(x + x1 - sx, y + sp[0] - sy, x2 - x1, fg);
+        }
+    }
+    else if (bg != GrNOCOLOR)
+        (*FDRV->drawblock)(x, y, w, h, bg);
+    return 1;
+}
@@ -0,0 +1,74 @@
+/**
+ ** glyphmap.c ---- two level char to glyph map of sparse fonts
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Fonts with few glyphs in a big range of chars (a Unicode font with
+ ** some scripts, or with chars out of the BMP) don't have a chrinfo entry
+ ** for every char. The glyph map has a pointer for every 256 chars (from
+ ** minchar) to a page with the chrinfo index + 1 of every char, 0 if the
+ ** char is not in the font. Pages without chars are not allocated.
+ **
+ **/
+
+#include "libgrx.h"
+#include "grfontdv.h"
+
+#define PAGESIZE 256
+
+/*
+ * _GrFontUseGlyphMap - returns TRUE if a sparse font with numchars chars
+ * and nglyphs glyphs would use less memory with a glyph map
+ */
+int _GrFontUseGlyphMap(unsigned int numchars, unsigned int nglyphs)
+{
+    return (numchars > PAGESIZE) && (nglyphs < numchars / 2);
+}
+
+/*
+ * _GrFontNewGlyphMap - allocates an empty glyph map for f, returns FALSE
+ * if there is no memory
+ */
+int _GrFontNewGlyphMap(GrFont *f)
+{
+    f->glyphmap = calloc((f->h.numchars + PAGESIZE - 1) / PAGESIZE,
+                         sizeof(unsigned int *));
+    return (f->glyphmap != NULL);
+}
+
+/*
+ * _GrFontSetGlyph - maps the char minchar + idx to chrinfo[glyph]
+ */
+int _GrFontSetGlyph(GrFont *f, unsigned int idx, unsigned int glyph)
+{
+    unsigned int **page = &f->glyphmap[idx / PAGESIZE];
+
+    if (*page == NULL) {
+        *page = calloc(PAGESIZE, sizeof(unsigned int));
+        if (*page == NULL) return FALSE;
+    }
+    (*page)[idx % PAGESIZE] = glyph + 1;
+    return TRUE;
+}
+
+void _GrFontFreeGlyphMap(GrFont *f)
+{
+    unsigned int i;
+
+    if (f->glyphmap == NULL) return;
+    for (i = 0; i < (f->h.numchars + PAGESIZE - 1) / PAGESIZE; i++)
+        free(f->glyphmap[i]);
+    free(f->glyphmap);
+    f->glyphmap = NULL;
+}
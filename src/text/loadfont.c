@@ -16,6 +16,10 @@
  **
  ** 220715 M.Alvarez, added GrLoadFontFile function that bypass the
  **                   normal MGRX algo to find a font
+ ** 261019 M.Alvarez, load the coverage map of anti-aliased fonts
+ ** 261019 M.Alvarez, loaded fonts are cached, font dirs are indexed
+ ** 261019 M.Alvarez, drivers can give the font without building it
+ ** 261019 M.Alvarez, anti-aliased scalable fonts, GrLoadStrokeFont
  **
  **/
 
@@ -50,6 +54,19 @@ static GrFont *doit(char *fname,char *path,int cvt,int w,int h,int lo,int hi)
             strcpy(&pathname[plen],(*fd)->ext);
             if(!((*fd)->openfile)(pathname)) continue;
         }
+        f = _GrFontCacheFind(fname,pathname,cvt,w,h,lo,hi);
+        if(f) {
+            (*fd)->cleanup();
+            res = f;
+            break;
+        }
+        if((cvt == GR_FONTCVT_NONE) && (*fd)->mapfont &&
+           ((f = ((*fd)->mapfont)()) != NULL)) {
+            (*fd)->cleanup();
+            _GrFontCacheAdd(f,fname,pathname,cvt,w,h,lo,hi);
+            res = f;
+            break;
+        }
         if(!((*fd)->header)(&hdr)) {
             DBGPRINTF(DBG_FONT,("fd->header failed for %s\n", pathname));
             (*fd)->cleanup();
@@ -69,19 +86,51 @@ static GrFont *doit(char *fname,char *path,int cvt,int w,int h,int lo,int hi)
             (*fd)->cleanup();
             continue;
         }
+        if((*fd)->coverage &&
+           (!(*fd)->scalable || (cvt & GR_FONTCVT_ANTIALIAS)))
+            _GrBuildFontCoverage(f,(*fd)->coverage);
         (*fd)->cleanup();
+        _GrFontCacheAdd(f,fname,pathname,cvt,w,h,lo,hi);
         res = f;
         break;
     }
     GRX_RETURN(res);
 }
 
-GrFont *GrLoadConvertedFont(char *name,int cvt,int w,int h,int minc,int maxc)
+static GrStrokeFont *dostroke(char *fname,char *path)
+{
+    GrFontDriver **fd;
+    GrFontHeader hdr;
+    GrStrokeFont *f;
+    char pathname[200];
+    char tempstring[200];
+    int  plen;
+
+    strcpy(pathname,path);
+    strcat(pathname,fname);
+    plen = strlen(pathname);
+    hdr.name   = &tempstring[0];
+    hdr.family = &tempstring[100];
+    for(fd = _GrFontDriverTable; (*fd) != NULL; fd++) {
+        if(!(*fd)->strokes) continue;
+        pathname[plen] = '\0';
+        if(!((*fd)->openfile)(pathname)) {
+            strcpy(&pathname[plen],(*fd)->ext);
+            if(!((*fd)->openfile)(pathname)) continue;
+        }
+        f = NULL;
+        if(((*fd)->header)(&hdr))
+            f = _GrBuildStrokeFont(&hdr,(*fd)->charwdt,(*fd)->strokes);
+        (*fd)->cleanup();
+        if(f) return(f);
+    }
+    return(NULL);
+}
+
+/* copies the font name as it is searched, returns TRUE if it has a path */
+static int fontname(char *name,char *fname)
 {
-    GrFont *f;
     int  chr,len,abspath;
-    char fname[200];
-    GRX_ENTER();
     len = 0;
     abspath = FALSE;
 
@@ -111,19 +160,42 @@ GrFont *GrLoadConvertedFont(char *name,int cvt,int w,int h,int minc,int maxc)
         fname[len++] = chr;
     }
     fname[len] = '\0';
-    f = doit(fname,"",cvt,w,h,minc,maxc);
-    if((f == NULL) && !abspath) {
-        if(_GrFontFileInfo.npath < 0) {
-            char *fPath = getenv("MGRXFONT");
+    return(abspath);
+}
+
+static void initpath(void)
+{
+    if(_GrFontFileInfo.npath < 0) {
+        char *fPath = getenv("MGRXFONT");
 #ifdef MGRX_DEFAULT_FONT_PATH
-            if (!fPath) fPath = MGRX_DEFAULT_FONT_PATH;
+        if (!fPath) fPath = MGRX_DEFAULT_FONT_PATH;
 #endif            
-            GrSetFontPath(fPath);
-        }
+        GrSetFontPath(fPath);
+    }
+}
+
+GrFont *GrLoadConvertedFont(char *name,int cvt,int w,int h,int minc,int maxc)
+{
+    GrFont *f;
+    int  len,abspath;
+    char fname[200];
+    GRX_ENTER();
+    abspath = fontname(name,fname);
+    f = _GrFontCacheFind(fname,NULL,cvt,w,h,minc,maxc);
+    if(f != NULL) GRX_RETURN(f);
+    f = doit(fname,"",cvt,w,h,minc,maxc);
+    if((f == NULL) && !abspath) {
+        initpath();
         for(len = 0; len < _GrFontFileInfo.npath; len++) {
+            if(!_GrFontDirMayHave(_GrFontFileInfo.path[len],fname)) continue;
             f = doit(fname,_GrFontFileInfo.path[len],cvt,w,h,minc,maxc);
             if(f != NULL) break;
         }
+        /* the index is only a hint, probe the dirs skipped */
+        for(len = 0; (f == NULL) && (len < _GrFontFileInfo.npath); len++) {
+            if(_GrFontDirMayHave(_GrFontFileInfo.path[len],fname)) continue;
+            f = doit(fname,_GrFontFileInfo.path[len],cvt,w,h,minc,maxc);
+        }
     }
     GRX_RETURN(f);
 }
@@ -133,6 +205,30 @@ GrFont *GrLoadFont(char *name)
     return(GrLoadConvertedFont(name,GR_FONTCVT_NONE,0,0,0,0));
 }
 
+GrStrokeFont *GrLoadStrokeFont(char *name)
+{
+    GrStrokeFont *f;
+    int  len,abspath;
+    char fname[200];
+    GRX_ENTER();
+    abspath = fontname(name,fname);
+    f = dostroke(fname,"");
+    if((f == NULL) && !abspath) {
+        initpath();
+        for(len = 0; len < _GrFontFileInfo.npath; len++) {
+            if(!_GrFontDirMayHave(_GrFontFileInfo.path[len],fname)) continue;
+            f = dostroke(fname,_GrFontFileInfo.path[len]);
+            if(f != NULL) break;
+        }
+        /* the index is only a hint, probe the dirs skipped */
+        for(len = 0; (f == NULL) && (len < _GrFontFileInfo.npath); len++) {
+            if(_GrFontDirMayHave(_GrFontFileInfo.path[len],fname)) continue;
+            f = dostroke(fname,_GrFontFileInfo.path[len]);
+        }
+    }
+    GRX_RETURN(f);
+}
+
 GrFont *GrLoadFontFile(char *name, char *driver)
 {
     GrFontDriver **fd;
@@ -148,6 +244,11 @@ GrFont *GrLoadFontFile(char *name, char *driver)
     for(fd = _GrFontDriverTable; (*fd) != NULL; fd++) {
         if (strcmp(driver, (*fd)->name) == 0) {
             if(!((*fd)->openfile)(name)) break;
+            if((*fd)->mapfont && ((f = ((*fd)->mapfont)()) != NULL)) {
+                (*fd)->cleanup();
+                res = f;
+                break;
+            }
             if(!((*fd)->header)(&hdr)) {
                 DBGPRINTF(DBG_FONT,("fd->header failed for %s\n", name));
                 (*fd)->cleanup();
@@ -162,6 +263,8 @@ GrFont *GrLoadFontFile(char *name, char *driver)
                 (*fd)->cleanup();
                 break;
             }
+            if((*fd)->coverage && !(*fd)->scalable)
+                _GrBuildFontCoverage(f,(*fd)->coverage);
             (*fd)->cleanup();
             res = f;
             break;
@@ -0,0 +1,328 @@
+/**
+ ** rotstrg.c ---- text drawn at any angle
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** Glyphs are rotated from the font bitmap (or coverage map) with a
+ ** bilinear sampler to a coverage map, cropped and cached by font, char
+ ** and angle, rounded to whole degrees. Plain colors are blended with the
+ ** coverage in RGB modes, else the pixels covered more than half are
+ ** drawn. The background and the underline are drawn once for the whole
+ ** string as filled polygons. When the cache is full it is flushed
+ ** completely, like the glyph cache of drawstrg.c.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "grdriver.h"
+#include "clipping.h"
+#include "text/text.h"
+
+#define ANGLESTEP       10              /* tenths of degree per bucket */
+#define NBUCKETS        512             /* must be a power of 2 */
+#define MAXGLYPHS       4096
+#define MAXBYTES        (2L * 1024L * 1024L)
+
+typedef struct _rglyph {
+    struct _rglyph *next;
+    GrFont        *font;
+    unsigned int   chr;
+    int            angle;               /* angle bucket */
+    int            ox, oy;              /* top left, from the pen position */
+    int            w, h;
+    unsigned char  cov[1];              /* w x h coverage (not act. size) */
+} rglyph;
+
+static rglyph *buckets[NBUCKETS];
+static long nglyphs = 0;
+static long nbytes = 0;
+
+static unsigned int hash(GrFont *f, unsigned int chr, int angle)
+{
+    unsigned long h = (unsigned long)f >> 4;
+
+    h = h * 31 + chr;
+    h = h * 31 + angle;
+    return (unsigned int)(h ^ (h >> 9)) & (NBUCKETS - 1);
+}
+
+/*
+ * _GrRotGlyphCacheFlush - removes the rotated glyphs of font f from the
+ * cache, all of them if f is NULL
+ */
+void _GrRotGlyphCacheFlush(GrFont *f)
+{
+    rglyph **pg, *g;
+    int i;
+
+    for (i=0; i<NBUCKETS; i++) {
+        pg = &buckets[i];
+        while ((g = *pg) != NULL) {
+            if (f == NULL || g->font == f) {
+                *pg = g->next;
+                nbytes -= (long)g->w * g->h;
+                free(g);
+                nglyphs--;
+            }
+            else
+                pg = &g->next;
+        }
+    }
+}
+
+static int iround(double v)
+{
+    return (v >= 0) ? (int)(v + 0.5) : -(int)(0.5 - v);
+}
+
+static int ifloor(double v)
+{
+    int i = (int)v;
+
+    return (v < i) ? i - 1 : i;
+}
+
+/* source pixel coverage, 0 out of the glyph */
+static int srcpix(const char *bmp, const unsigned char *cov, int w, int h,
+                  int x, int y)
+{
+    if ((unsigned int)x >= (unsigned int)w || (unsigned int)y >= (unsigned int)h)
+        return 0;
+    if (cov) return cov[y * ((w + 7) & ~7) + x];
+    return (bmp[y * ((w + 7) >> 3) + (x >> 3)] & (0x80 >> (x & 7))) ? 255 : 0;
+}
+
+static rglyph *rotate(GrFont *f, unsigned int chr, int angle)
+{
+    char *bmp;
+    unsigned char *cov, *tmp, *p;
+    double sn, cs, fx, fy, tx, ty, minx, maxx, miny, maxy;
+    long u, v, du, dv;
+    int w, h, x0, y0, rw, rh, x, y, ix, iy, a, b, top, bot, i;
+    int cx1, cy1, cx2, cy2;
+    rglyph *g;
+
+    bmp = GrFontCharBitmap(f, chr);
+    w = GrFontCharWidth(f, chr);
+    h = f->h.height;
+    if (bmp == NULL || w <= 0 || h <= 0) return NULL;
+    cov = GrFontCharCoverage(f, chr);
+    _GrSinCos10(angle * ANGLESTEP, &sn, &cs);
+    /* bounding box of the rotated cell */
+    minx = miny = 1e9;
+    maxx = maxy = -1e9;
+    for (i=0; i<4; i++) {
+        fx = (i & 1) ? w : 0;
+        fy = (i & 2) ? h : 0;
+        tx = fx * cs + fy * sn;
+        ty = fy * cs - fx * sn;
+        if (tx < minx) minx = tx;
+        if (tx > maxx) maxx = tx;
+        if (ty < miny) miny = ty;
+        if (ty > maxy) maxy = ty;
+    }
+    x0 = ifloor(minx) - 1;
+    y0 = ifloor(miny) - 1;
+    rw = ifloor(maxx) + 2 - x0;
+    rh = ifloor(maxy) + 2 - y0;
+    tmp = malloc((size_t)rw * rh);
+    if (tmp == NULL) return NULL;
+    /* source coordinates of the pixel centers, 16.16 biased to be positive */
+    du = (long)(cs * 65536.0);
+    dv = (long)(sn * 65536.0);
+    cx1 = rw; cy1 = rh; cx2 = cy2 = -1;
+    for (y=0, p=tmp; y<rh; y++) {
+        tx = x0 + 0.5;
+        ty = y0 + y + 0.5;
+        u = (long)((tx * cs - ty * sn - 0.5 + 4096.0) * 65536.0);
+        v = (long)((tx * sn + ty * cs - 0.5 + 4096.0) * 65536.0);
+        for (x=0; x<rw; x++, p++, u+=du, v+=dv) {
+            ix = (int)(u >> 16) - 4096;
+            iy = (int)(v >> 16) - 4096;
+            *p = 0;
+            if (ix < -1 || ix >= w || iy < -1 || iy >= h) continue;
+            a = (int)(u >> 8) & 255;
+            b = (int)(v >> 8) & 255;
+            top = srcpix(bmp, cov, w, h, ix, iy) * (256 - a) +
+                  srcpix(bmp, cov, w, h, ix + 1, iy) * a;
+            bot = srcpix(bmp, cov, w, h, ix, iy + 1) * (256 - a) +
+                  srcpix(bmp, cov, w, h, ix + 1, iy + 1) * a;
+            *p = (unsigned char)((top * (256 - b) + bot * b + 32768) >> 16);
+            if (*p == 0) continue;
+            if (x < cx1) cx1 = x;
+            if (x > cx2) cx2 = x;
+            if (y < cy1) cy1 = y;
+            if (y > cy2) cy2 = y;
+        }
+    }
+    if (cx2 < 0) cx1 = cy1 = 0, cx2 = cy2 = -1;        /* blank glyph */
+    g = malloc(sizeof(rglyph) + (size_t)(cx2 - cx1 + 1) * (cy2 - cy1 + 1));
+    if (g == NULL) {
+        free(tmp);
+        return NULL;
+    }
+    g->font = f;
+    g->chr = chr;
+    g->angle = angle;
+    g->ox = x0 + cx1;
+    g->oy = y0 + cy1;
+    g->w = cx2 - cx1 + 1;
+    g->h = cy2 - cy1 + 1;
+    for (y=0; y<g->h; y++)
+        memcpy(&g->cov[y * g->w], &tmp[(cy1 + y) * rw + cx1], g->w);
+    free(tmp);
+    nglyphs++;
+    nbytes += (long)g->w * g->h;
+    return g;
+}
+
+static rglyph *getglyph(GrFont *f, unsigned int chr, int angle)
+{
+    unsigned int hv;
+    rglyph *g;
+
+    hv = hash(f, chr, angle);
+    for (g = buckets[hv]; g != NULL; g = g->next) {
+        if (g->chr == chr && g->font == f && g->angle == angle) return g;
+    }
+    if (nglyphs >= MAXGLYPHS || nbytes >= MAXBYTES) _GrRotGlyphCacheFlush(NULL);
+    g = rotate(f, chr, angle);
+    if (g == NULL) return NULL;
+    g->next = buckets[hv];
+    buckets[hv] = g;
+    return g;
+}
+
+static void drawglyph(rglyph *g, int x, int y, GrColor fg, int aa)
+{
+    int x1, y1, x2, y2, xx, yy, i, j, j0;
+    unsigned char *row;
+
+    x1 = xx = x + g->ox;
+    y1 = yy = y + g->oy;
+    x2 = x1 + g->w - 1;
+    y2 = y1 + g->h - 1;
+    clip_ordbox_(CURC,x1,y1,x2,y2,return,CLIP_EMPTY_MACRO_ARG);
+    if (aa) {
+        (*(FDRV->drawcoverage ? FDRV->drawcoverage : _GrFrDrvGenericDrawCoverage))(
+            (x1 + CURC->gc_xoffset),
+            (y1 + CURC->gc_yoffset),
+            (x2 - x1 + 1),
+            (y2 - y1 + 1),
+            &g->cov[(x1 - xx) + (y1 - yy) * g->w],
+            g->w,
+            fg,GrNOCOLOR
+            );
+        return;
+    }
+    for (i = y1; i <= y2; i++) {
+        row = &g->cov[(i - yy) * g->w];
+        for (j = x1; j <= x2; ) {
+            if (row[j - xx] < 128) { j++; continue; }
+            for (j0 = j; j <= x2 && row[j - xx] >= 128; j++);
+            (*FDRV->drawhline)(j0 + CURC->gc_xoffset, i + CURC->gc_yoffset,
+                               j - j0, fg);
+        }
+    }
+}
+
+void GrDrawRotatedString(const void *text,int length,int x,int y,int angle,
+                         const GrTextOption *opt)
+{
+    static int dirangle[4] = { 0, 2700, 1800, 900 };
+    unsigned int buf[TEXT_LOCALBUF];
+    GrFont *f = opt->txo_font;
+    GrColor fg, bg;
+    rglyph *g;
+    const void *t;
+    double sn, cs, ax, ay, fx, fy;
+    int box[4][2], xmin, ymin, xmax, ymax;
+    long width, pen;
+    int aa, i, n, len;
+
+    GRX_ENTER();
+    if (text == NULL || f == NULL) { GRX_LEAVE(); return; }
+    if (length <= 0) length = GrStrLen(text, opt->txo_chrtype);
+    if (length <= 0) { GRX_LEAVE(); return; }
+    width = 0;
+    for (t = text, len = length; len > 0; len -= n) {
+        n = (len < TEXT_LOCALBUF) ? len : TEXT_LOCALBUF;
+        t = _GrFontTextRecodeBuf(f, t, n, opt->txo_chrtype, buf);
+        width += _GrFontWordTextWidth(f, buf, n);
+    }
+    if (width == 0) { GRX_LEAVE(); return; }
+    angle = (angle + dirangle[opt->txo_direct & 3]) % GR_MAX_ANGLE_VALUE;
+    if (angle < 0) angle += GR_MAX_ANGLE_VALUE;
+    angle = ((angle + ANGLESTEP / 2) / ANGLESTEP) % (GR_MAX_ANGLE_VALUE / ANGLESTEP);
+    _GrSinCos10(angle * ANGLESTEP, &sn, &cs);
+    /* the reference point in the unrotated text box */
+    ax = ay = 0;
+    switch (opt->txo_xalign) {
+      case GR_ALIGN_RIGHT:  ax = width - 1; break;
+      case GR_ALIGN_CENTER: ax = width >> 1; break;
+    }
+    switch (opt->txo_yalign) {
+      case GR_ALIGN_BASELINE: ay = f->h.baseline; break;
+      case GR_ALIGN_BOTTOM:   ay = f->h.height - 1; break;
+      case GR_ALIGN_CENTER:   ay = f->h.height >> 1; break;
+    }
+    fg = opt->txo_fgcolor & ~GR_UNDERLINE_TEXT;
+    bg = opt->txo_bgcolor;
+    aa = CLRINFO->RGBmode && (C_OPER(fg) == C_WRITE);
+    /* pixel centers of the text box corners */
+    for (i = 0; i < 4; i++) {
+        fx = ((i == 1 || i == 2) ? width - 1 : 0) - ax;
+        fy = ((i >= 2) ? f->h.height - 1 : 0) - ay;
+        box[i][0] = x + iround(fx * cs + fy * sn);
+        box[i][1] = y + iround(fy * cs - fx * sn);
+    }
+    xmin = xmax = box[0][0];
+    ymin = ymax = box[0][1];
+    for (i = 1; i < 4; i++) {
+        if (box[i][0] < xmin) xmin = box[i][0];
+        if (box[i][0] > xmax) xmax = box[i][0];
+        if (box[i][1] < ymin) ymin = box[i][1];
+        if (box[i][1] > ymax) ymax = box[i][1];
+    }
+    mouse_block(CURC,xmin - 1,ymin - 1,xmax + 1,ymax + 1);
+    if (bg != GrNOCOLOR) GrFilledConvexPolygon(4, box, bg);
+    pen = 0;
+    for (t = text, len = length; len > 0; len -= n) {
+        n = (len < TEXT_LOCALBUF) ? len : TEXT_LOCALBUF;
+        t = _GrFontTextRecodeBuf(f, t, n, opt->txo_chrtype, buf);
+        for (i = 0; i < n; i++) {
+            fx = pen - ax;
+            fy = -ay;
+            pen += GrFontCharWidth(f, buf[i]);
+            g = getglyph(f, buf[i], angle);
+            if (g == NULL || g->w <= 0) continue;
+            drawglyph(g, x + iround(fx * cs + fy * sn),
+                      y + iround(fy * cs - fx * sn), fg, aa);
+        }
+    }
+    if ((opt->txo_fgcolor & GR_UNDERLINE_TEXT) && f->h.ulheight > 0) {
+        for (i = 0; i < 4; i++) {
+            fx = ((i == 1 || i == 2) ? width - 1 : 0) - ax;
+            fy = f->h.ulpos + ((i >= 2) ? f->h.ulheight - 1 : 0) - ay;
+            box[i][0] = x + iround(fx * cs + fy * sn);
+            box[i][1] = y + iround(fy * cs - fx * sn);
+        }
+        GrFilledConvexPolygon(4, box, fg);
+    }
+    mouse_unblock();
+    GRX_LEAVE();
+}
@@ -0,0 +1,212 @@
+/**
+ ** strkfont.c ---- stroke (vector) fonts drawn at any size and angle
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** A stroke font keeps the vectors of a scalable font (in font units,
+ ** from the top left of the char cell) instead of bitmaps. Strings are
+ ** scaled to the requested cell height, rotated around the aligned
+ ** reference point and drawn with GrPolyLine, one call per stroke.
+ **
+ **/
+
+#include <string.h>
+
+#include "libgrx.h"
+#include "grfontdv.h"
+#include "text/text.h"
+
+#define MAXPTS  64                      /* points per GrPolyLine call */
+
+/*
+ * _GrSinCos10 - sine and cosine of an angle in tenths of degree, without
+ * libm (every program loading fonts links this file)
+ */
+void _GrSinCos10(int angle, double *sn, double *cs)
+{
+    double x, x2, s, c;
+
+    angle %= GR_MAX_ANGLE_VALUE;
+    if (angle < 0) angle += GR_MAX_ANGLE_VALUE;
+    x = (angle % 900) * (3.14159265358979 / 1800);
+    x2 = x * x;
+    s = x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110)))));
+    c = 1 - x2 / 2 * (1 - x2 / 12 * (1 - x2 / 30 * (1 - x2 / 56 * (1 - x2 / 90))));
+    switch (angle / 900) {
+      case 0: *sn =  s; *cs =  c; break;
+      case 1: *sn =  c; *cs = -s; break;
+      case 2: *sn = -s; *cs = -c; break;
+      default: *sn = -c; *cs =  s; break;
+    }
+}
+
+static int iround(double v)
+{
+    return (v >= 0) ? (int)(v + 0.5) : -(int)(0.5 - v);
+}
+
+/*
+ * _GrBuildStrokeFont - makes a stroke font with the vectors given by a
+ * font driver, chars without vectors or width are not present
+ */
+GrStrokeFont *_GrBuildStrokeFont(const GrFontHeader *h,
+                                 int (*charwdt)(int chr),
+                                 int (*strokes)(int chr,GrFontStroke *buffer))
+{
+    GrStrokeFont *f;
+    unsigned int i, total;
+    int n, w;
+
+    if (h->numchars == 0 || h->height == 0) return NULL;
+    total = 0;
+    for (i = 0; i < h->numchars; i++) {
+        n = (*strokes)(h->minchar + i, NULL);
+        if (n > 0) total += n;
+    }
+    i = sizeof(GrStrokeFont) + h->numchars * sizeof(GrFontChrInfo);
+    f = malloc(i);
+    if (f == NULL) return NULL;
+    memset(f, 0, i);
+    f->h = *h;
+    f->h.name = malloc(strlen(h->name) + 1);
+    f->h.family = malloc(strlen(h->family) + 1);
+    f->strokes = malloc((total > 0 ? total : 1) * sizeof(GrFontStroke));
+    if (f->h.name == NULL || f->h.family == NULL || f->strokes == NULL)
+        goto error;
+    strcpy(f->h.name, h->name);
+    strcpy(f->h.family, h->family);
+    f->h.preloaded = FALSE;
+    f->h.modified = GR_FONTCVT_NONE;
+    total = 0;
+    for (i = 0; i < h->numchars; i++) {
+        w = (*charwdt)(h->minchar + i);
+        f->chrinfo[i].width = (w > 0) ? w : 0;
+        f->chrinfo[i].offset = total;
+        if (w <= 0) continue;
+        n = (*strokes)(h->minchar + i, &f->strokes[total]);
+        if (n > 0) total += n;
+    }
+    f->chrinfo[h->numchars].offset = total;
+    return f;
+error:
+    GrUnloadStrokeFont(f);
+    return NULL;
+}
+
+void GrUnloadStrokeFont(GrStrokeFont *f)
+{
+    if (f == NULL) return;
+    free(f->h.name);
+    free(f->h.family);
+    free(f->strokes);
+    free(f);
+}
+
+/* width of a string in font units */
+static long unitswidth(const GrStrokeFont *f, const void *text, int length,
+                       int chrtype)
+{
+    unsigned int buf[TEXT_LOCALBUF];
+    unsigned int idx;
+    long w = 0;
+    int i, n;
+
+    for (; length > 0; length -= n) {
+        n = (length < TEXT_LOCALBUF) ? length : TEXT_LOCALBUF;
+        text = _GrTextRecodeBuf(f->h.encoding, text, n, chrtype, buf);
+        for (i = 0; i < n; i++) {
+            idx = buf[i] - f->h.minchar;
+            if (idx < f->h.numchars) w += f->chrinfo[idx].width;
+        }
+    }
+    return w;
+}
+
+int GrStrokeStringWidth(const void *text, int length, const GrStrokeTextOption *opt)
+{
+    GrStrokeFont *f = opt->sto_font;
+
+    if (f == NULL || opt->sto_height <= 0) return 0;
+    if (length <= 0) length = GrStrLen(text, opt->sto_chrtype);
+    return (int)((unitswidth(f, text, length, opt->sto_chrtype) *
+                  opt->sto_height + (f->h.height >> 1)) / f->h.height);
+}
+
+void GrDrawStrokeString(const void *text, int length, int x, int y,
+                        const GrStrokeTextOption *opt)
+{
+    GrStrokeFont *f = opt->sto_font;
+    unsigned int buf[TEXT_LOCALBUF];
+    int pt[MAXPTS][2];
+    GrFontStroke *st, *end;
+    double scale, cs, sn, px, py, fx, fy;
+    unsigned int idx;
+    int i, n, npt;
+
+    if (f == NULL || opt->sto_height <= 0) return;
+    if (length <= 0) length = GrStrLen(text, opt->sto_chrtype);
+    if (length <= 0) return;
+    scale = (double)opt->sto_height / f->h.height;
+    _GrSinCos10(opt->sto_angle, &sn, &cs);
+    /* the pen in font units, from the reference point */
+    px = py = 0.0;
+    switch (opt->sto_xalign) {
+      case GR_ALIGN_RIGHT:
+        px = -(double)unitswidth(f, text, length, opt->sto_chrtype);
+        break;
+      case GR_ALIGN_CENTER:
+        px = -(double)unitswidth(f, text, length, opt->sto_chrtype) / 2;
+        break;
+    }
+    switch (opt->sto_yalign) {
+      case GR_ALIGN_BASELINE:
+        py = -(double)f->h.baseline;
+        break;
+      case GR_ALIGN_BOTTOM:
+        py = -(double)f->h.height;
+        break;
+      case GR_ALIGN_CENTER:
+        py = -(double)f->h.height / 2;
+        break;
+    }
+    for (; length > 0; length -= n) {
+        n = (length < TEXT_LOCALBUF) ? length : TEXT_LOCALBUF;
+        text = _GrTextRecodeBuf(f->h.encoding, text, n, opt->sto_chrtype, buf);
+        for (i = 0; i < n; i++) {
+            idx = buf[i] - f->h.minchar;
+            if (idx >= f->h.numchars || f->chrinfo[idx].width == 0) continue;
+            st = &f->strokes[f->chrinfo[idx].offset];
+            end = &f->strokes[f->chrinfo[idx + 1].offset];
+            for (npt = 0; st <= end; st++) {
+                if (st == end || !st->draw || npt == MAXPTS) {
+                    if (npt > 1) GrPolyLine(npt, pt, opt->sto_color);
+                    if (st == end) break;
+                    /* a long stroke goes on from its last point */
+                    if (st->draw) {
+                        pt[0][0] = pt[npt - 1][0];
+                        pt[0][1] = pt[npt - 1][1];
+                        npt = 1;
+                    }
+                    else npt = 0;
+                }
+                fx = (px + st->x) * scale;
+                fy = (py + st->y) * scale;
+                pt[npt][0] = x + iround(fx * cs + fy * sn);
+                pt[npt][1] = y + iround(fy * cs - fx * sn);
+                npt++;
+            }
+            px += f->chrinfo[idx].width;
+        }
+    }
+}
@@ -17,10 +17,12 @@
  ** Contributions by:
  ** 080125 M.Alvarez, UTF-8 support
  ** 170706 M.Alvarez, rewrite for font encoding functionality
+ ** 261019 M.Alvarez, recode without allocating memory
  **
  **/
 
 #include "libgrx.h"
+#include "text/text.h"
 
 int GrCharWidth(long chr, const GrTextOption *opt)
 {
@@ -68,7 +70,7 @@ void GrCharSize(long chr, const GrTextOption *opt,int *w,int *h)
   }
 }
 
-int _GrFontWordTextWidth(const GrFont *font,const unsigned short *text,int len)
+int _GrFontWordTextWidth(const GrFont *font,const unsigned int *text,int len)
 {
   int wdt = 0;
   int i;
@@ -83,23 +85,22 @@ int _GrFontWordTextWidth(const GrFont *font,const unsigned short *text,int len)
 
 int GrFontStringWidth(const GrFont *font,const void *text,int len,int chrtype)
 {
-  unsigned short *text2;
+  unsigned int text2[TEXT_LOCALBUF];
   int wdt = 0;
-  int i;
+  int i, n;
 
   if (len <= 0) len = GrStrLen(text, chrtype);
 
   if (!font->h.proportional) return (font->h.width * len);
 
-  text2 = GrFontTextRecode(font, text, len, chrtype);
-  
-  if (text2 != NULL) {
-    for (i=0; i<len; i++)
+  while (len > 0) {
+    n = (len < TEXT_LOCALBUF) ? len : TEXT_LOCALBUF;
+    text = _GrFontTextRecodeBuf(font, text, n, chrtype, text2);
+    for (i=0; i<n; i++)
       wdt += GrFontCharWidth(font,text2[i]);
-
-    free(text2);
+    len -= n;
   }
-      
+
   return wdt;
 }
 
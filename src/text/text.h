@@ -19,10 +19,34 @@ typedef void (*TextDrawBitmapFunc)(int x,int y,int w,int h,int ox, int oy,
               char *bmp,int pitch,int start,
               GrColor fg,GrColor bg,GrPattern *p);
 
-int _GrFontWordTextWidth(const GrFont *font,const unsigned short *text,int len);
+int _GrFontWordTextWidth(const GrFont *font,const unsigned int *text,int len);
+
+/* strings up to this length are recoded in a stack buffer */
+#define TEXT_LOCALBUF 256
+
+const void *_GrFontTextRecodeBuf(const GrFont *font,const void *text,int length,
+                                 int chrtype,unsigned int *buf);
+const void *_GrTextRecodeBuf(int fontenc,const void *text,int length,
+                             int chrtype,unsigned int *buf);
 
 void _GrDrawString(const void *text,int length,int x,int y,
                    const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm);
 
+/* draws text already in the font encoding */
+void _GrDrawWordText(const unsigned int *text,int length,int x,int y,
+                     const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm);
+
 void _GrDrawChar(long chr, int x, int y,
                  const GrTextOption *opt, GrPattern *p, TextDrawBitmapFunc dbm);
+
+/* glyph cache for the frame driver drawbitmap (dbm == NULL) */
+int  _GrGlyphCacheDraw(GrFont *f, unsigned int chr, int dir, int cw, int ch,
+                       GrColor fg, GrColor bg, const unsigned char *cov, int x, int y,
+                       int sx, int sy, int w, int h);
+void _GrGlyphCacheFlush(GrFont *f);
+
+/* sine and cosine of an angle in tenths of degree, without libm */
+void _GrSinCos10(int angle, double *sn, double *cs);
+
+/* cache of glyphs rotated to any angle */
+void _GrRotGlyphCacheFlush(GrFont *f);
@@ -0,0 +1,209 @@
+/**
+ ** textrun.c ---- text laid out once and drawn many times
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** A text run keeps the string recoded to the font encoding, the advance
+ ** of every char (with the kerning pairs applied) and the lines: the
+ ** string is broken at '\n' and, if a max width is given, at the last
+ ** space before the line gets wider (or inside a word wider than the max
+ ** width). Lines are drawn with _GrDrawWordText, so drawing a run does
+ ** no recoding or measuring; kerned lines are drawn in pieces.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "text/text.h"
+
+static int kerncmp(const void *a, const void *b)
+{
+    const GrKernPair *ka = a, *kb = b;
+
+    if (ka->left != kb->left) return (ka->left < kb->left) ? -1 : 1;
+    if (ka->right != kb->right) return (ka->right < kb->right) ? -1 : 1;
+    return 0;
+}
+
+static int kerning(const GrKernPair *kern, int nkern,
+                   unsigned int left, unsigned int right)
+{
+    int lo = 0, hi = nkern - 1, mid;
+
+    while (lo <= hi) {
+        mid = (lo + hi) >> 1;
+        if (kern[mid].left < left ||
+            (kern[mid].left == left && kern[mid].right < right)) lo = mid + 1;
+        else if (kern[mid].left == left && kern[mid].right == right)
+            return kern[mid].adjust;
+        else hi = mid - 1;
+    }
+    return 0;
+}
+
+static int addline(GrTextRun *r, int *size, int first, int length, int width,
+                   int trim)
+{
+    GrTextLine *l;
+
+    if (trim) {
+        while (length > 0 && r->chars[first + length - 1] == ' ')
+            width -= r->advance[first + --length];
+    }
+    if (r->nlines == *size) {
+        *size = (*size > 0) ? *size * 2 : 8;
+        l = realloc(r->lines, *size * sizeof(GrTextLine));
+        if (l == NULL) return -1;
+        r->lines = l;
+    }
+    l = &r->lines[r->nlines++];
+    l->first = first;
+    l->length = length;
+    l->width = width;
+    if (width > r->width) r->width = width;
+    return 0;
+}
+
+static int breaklines(GrTextRun *r, int maxwidth)
+{
+    int size = 0, s = 0, w = 0, brk = -1, bw = 0, i, j;
+    unsigned int c;
+
+    for (i = 0; i <= r->nchars; i++) {
+        c = (i < r->nchars) ? r->chars[i] : '\n';
+        if (c == '\n') {
+            if (addline(r, &size, s, i - s, w, 0) < 0) return -1;
+            s = i + 1;
+            w = 0;
+            brk = -1;
+            continue;
+        }
+        if (c == ' ') {
+            brk = i;
+            bw = w;
+        }
+        else if (maxwidth > 0 && i > s && w + r->advance[i] > maxwidth) {
+            if (brk >= s) {
+                if (addline(r, &size, s, brk - s, bw, 1) < 0) return -1;
+                s = brk + 1;
+                for (w = 0, j = s; j < i; j++) w += r->advance[j];
+                brk = -1;
+                i--;            /* check the char again in the new line */
+                continue;
+            }
+            if (addline(r, &size, s, i - s, w, 0) < 0) return -1;
+            s = i;
+            w = 0;
+        }
+        w += r->advance[i];
+    }
+    return 0;
+}
+
+GrTextRun *GrCreateTextRun(const void *text,int length,const GrTextOption *opt,
+                           int maxwidth,const GrKernPair *kern,int nkern)
+{
+    GrKernPair *sorted = NULL;
+    GrTextRun *r;
+    GrFont *f = opt->txo_font;
+    int i, w;
+
+    if (text == NULL || f == NULL) return NULL;
+    if (length < 0) length = 0;
+    if (length == 0) length = GrStrLen(text, opt->txo_chrtype);
+    r = malloc(sizeof(GrTextRun));
+    if (r == NULL) return NULL;
+    memset(r, 0, sizeof(GrTextRun));
+    r->opt = *opt;
+    r->opt.txo_direct = GR_TEXT_RIGHT;
+    r->nchars = length;
+    r->chars = malloc((length > 0 ? length : 1) * sizeof(unsigned int));
+    r->advance = malloc((length > 0 ? length : 1) * sizeof(int));
+    if (r->chars == NULL || r->advance == NULL) goto error;
+    if (length > 0)
+        _GrFontTextRecodeBuf(f, text, length, opt->txo_chrtype, r->chars);
+    if (kern != NULL && nkern > 0) {
+        sorted = malloc(nkern * sizeof(GrKernPair));
+        if (sorted == NULL) goto error;
+        memcpy(sorted, kern, nkern * sizeof(GrKernPair));
+        qsort(sorted, nkern, sizeof(GrKernPair), kerncmp);
+    }
+    for (i = 0; i < length; i++) {
+        r->advance[i] = GrFontCharWidth(f, r->chars[i]);
+        if (sorted && i + 1 < length) {
+            w = kerning(sorted, nkern, r->chars[i], r->chars[i + 1]);
+            if (w != 0) {
+                r->advance[i] += w;
+                r->kerned = 1;
+            }
+        }
+    }
+    free(sorted);
+    if (breaklines(r, maxwidth) < 0) goto error;
+    r->height = r->nlines * f->h.height;
+    return r;
+error:
+    GrDestroyTextRun(r);
+    return NULL;
+}
+
+void GrDestroyTextRun(GrTextRun *run)
+{
+    if (run == NULL) return;
+    free(run->chars);
+    free(run->advance);
+    free(run->lines);
+    free(run);
+}
+
+void GrDrawTextRun(const GrTextRun *run,int x,int y)
+{
+    GrTextOption opt;
+    GrTextLine *l;
+    GrFont *f;
+    int i, j, s, lx, ly;
+
+    if (run == NULL || (f = run->opt.txo_font) == NULL) return;
+    opt = run->opt;
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+    switch (run->opt.txo_yalign) {
+      case GR_ALIGN_BASELINE: y -= f->h.baseline; break;
+      case GR_ALIGN_BOTTOM:   y -= run->height - 1; break;
+      case GR_ALIGN_CENTER:   y -= run->height >> 1; break;
+    }
+    for (i = 0, l = run->lines; i < run->nlines; i++, l++) {
+        ly = y + i * f->h.height;
+        lx = x;
+        switch (run->opt.txo_xalign) {
+          case GR_ALIGN_RIGHT:  lx -= l->width - 1; break;
+          case GR_ALIGN_CENTER: lx -= l->width >> 1; break;
+        }
+        if (l->length <= 0) continue;
+        if (!run->kerned) {
+            _GrDrawWordText(&run->chars[l->first], l->length, lx, ly,
+                            &opt, NULL, NULL);
+            continue;
+        }
+        /* pieces ending at a kerned char */
+        for (s = j = l->first; j < l->first + l->length; j++) {
+            if (run->advance[j] == GrFontCharWidth(f, run->chars[j]) &&
+                j + 1 < l->first + l->length) continue;
+            _GrDrawWordText(&run->chars[s], j - s + 1, lx, ly, &opt, NULL, NULL);
+            for (; s <= j; s++) lx += run->advance[s];
+        }
+    }
+}
@@ -14,23 +14,44 @@
  ** but WITHOUT ANY WARRANTY; without even the implied warranty of
  ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  **
+ ** 261019 M.Alvarez, cached fonts are freed with the last reference
+ ** 261019 M.Alvarez, mapped fonts release the file
+ ** 261019 M.Alvarez, free the glyph map of sparse fonts
+ ** 261019 M.Alvarez, _GrFontFree, the cache can keep unused fonts
+ ** 261019 M.Alvarez, free the rotated glyphs
+ **
  **/
 
 #include "libgrx.h"
 #include "arith.h"
+#include "grfontdv.h"
+#include "text/text.h"
+
+void _GrFontFree(GrFont *f)
+{
+    unsigned int i;
+
+    _GrGlyphCacheFlush(f);
+    _GrRotGlyphCacheFlush(f);
+    free(f->h.name);
+    free(f->h.family);
+    if(!_GrFontUnmap(f)) {
+        free(f->bitmap);
+        if(f->covmap) free(f->covmap);
+    }
+    if(f->auxmap) free(f->auxmap);
+    _GrFontFreeGlyphMap(f);
+    for(i = 0; i < itemsof(f->auxoffs); i++) {
+        if(f->auxoffs[i]) free(f->auxoffs[i]);
+    }
+    free(f);
+}
 
 void GrUnloadFont(GrFont *f)
 {
     if((f != NULL) && !f->h.preloaded) {
-        unsigned int i;
-        free(f->h.name);
-        free(f->h.family);
-        free(f->bitmap);
-        if(f->auxmap) free(f->auxmap);
-        for(i = 0; i < itemsof(f->auxoffs); i++) {
-            if(f->auxoffs[i]) free(f->auxoffs[i]);
-        }
-        free(f);
+        if(_GrFontCacheRelease(f) > 0) return;
+        _GrFontFree(f);
     }
 }
 
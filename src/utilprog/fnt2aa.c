@@ -0,0 +1,58 @@
+/**
+ ** fnt2aa.c ---- build an anti-aliased ascii font file from a big font
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mgrx.h"
+
+int main(int argc,char **argv)
+{
+	GrFont *f, *aa;
+	int scale;
+	if(argc < 4) {
+	    fprintf(
+	    	stderr,
+	    	"%s: too few arguments\n"
+	    	"usage: fnt2aa fontFile scale outputFile.fna\n"
+	    	"  fontFile must be scale times bigger than the new font\n",
+	    	argv[0]
+	    );
+	    return(1);
+	}
+	f = GrLoadFont(argv[1]);
+	if(!f) {
+	    fprintf(
+	    	stderr,
+	    	"%s: could not load font \"%s\"\n",
+	    	argv[0],
+	    	argv[1]
+	    );
+	    return(1);
+	}
+	scale = atoi(argv[2]);
+	aa = GrBuildCoverageFont(f,scale);
+	if(!aa) {
+	    fprintf(stderr,"%s: invalid scale \"%s\"\n",argv[0],argv[2]);
+	    return(1);
+	}
+	if(!GrDumpFnaFont(aa,argv[3])) {
+	    fprintf(stderr,"%s: could not write \"%s\"\n",argv[0],argv[3]);
+	    return(1);
+	}
+	return(0);
+}
@@ -0,0 +1,50 @@
+/**
+ ** fnt2mfn.c ---- convert a font to the mappable MFN format
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mgrx.h"
+
+int main(int argc,char **argv)
+{
+	GrFont *f;
+	if(argc < 3) {
+	    fprintf(
+	    	stderr,
+	    	"%s: too few arguments\n"
+	    	"usage: fnt2mfn fontFile outputFile.mfn\n",
+	    	argv[0]
+	    );
+	    return(1);
+	}
+	f = GrLoadFont(argv[1]);
+	if(!f) {
+	    fprintf(
+	    	stderr,
+	    	"%s: could not load font \"%s\"\n",
+	    	argv[0],
+	    	argv[1]
+	    );
+	    return(1);
+	}
+	if(!GrDumpMfnFont(f,argv[2])) {
+	    fprintf(stderr,"%s: could not write \"%s\"\n",argv[0],argv[2]);
+	    return(1);
+	}
+	return(0);
+}
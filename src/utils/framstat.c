@@ -0,0 +1,161 @@
+/**
+ ** framstat.c ---- frame timing statistics
+ **
+ ** Copyright (C) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This file is part of the GRX graphics library.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** The program marks every frame with GrFrameBegin, GrFramePresent (the
+ ** drawing is done, the frame is being shown) and GrFrameEnd. The draw
+ ** and present times of the last frames are kept in a ring, the stats
+ ** are calculated only when they are asked for.
+ **
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+
+static long drawt[GR_FRAMESTATS_MAXWINDOW];
+static long prest[GR_FRAMESTATS_MAXWINDOW];
+static int window = GR_FRAMESTATS_WINDOW;
+static int first = 0;
+static int count = 0;
+static long totframes = 0;
+
+static long long tbegin = -1;
+static long long tpresent = -1;
+
+static int longcmp(const void *a, const void *b)
+{
+    long la = *(const long *)a, lb = *(const long *)b;
+
+    return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+}
+
+/* min, avg, p99 and max of the window, v is sorted in place */
+static void calcstats(long *v, int n, long *min, long *avg, long *p99, long *max)
+{
+    long long sum = 0;
+    int i;
+
+    *min = *avg = *p99 = *max = 0;
+    if (n <= 0) return;
+    for (i=0; i<n; i++) sum += v[i];
+    qsort(v, n, sizeof(long), longcmp);
+    *min = v[0];
+    *avg = (long)(sum / n);
+    *p99 = v[(n * 99 + 99) / 100 - 1];
+    *max = v[n-1];
+}
+
+/**
+ ** GrFrameStatsSetWindow - Sets the number of frames the stats cover
+ **
+ ** Arguments:
+ **   nframes: 1 to GR_FRAMESTATS_MAXWINDOW
+ **
+ ** Returns  0 on success (the stats are reset)
+ **         -1 on error
+ **/
+
+int GrFrameStatsSetWindow(int nframes)
+{
+    if (nframes < 1 || nframes > GR_FRAMESTATS_MAXWINDOW) return -1;
+    window = nframes;
+    GrFrameStatsReset();
+    return 0;
+}
+
+/**
+ ** GrFrameStatsReset - Discards the frames measured
+ **
+ **/
+
+void GrFrameStatsReset(void)
+{
+    first = 0;
+    count = 0;
+    totframes = 0;
+    tbegin = tpresent = -1;
+}
+
+/**
+ ** GrFrameBegin - Marks the start of a frame, the drawing begins
+ **
+ **/
+
+void GrFrameBegin(void)
+{
+    tbegin = GrUsecTime();
+    tpresent = -1;
+}
+
+/**
+ ** GrFramePresent - Marks the end of the drawing, the present begins
+ **
+ **/
+
+void GrFramePresent(void)
+{
+    if (tbegin >= 0) tpresent = GrUsecTime();
+}
+
+/**
+ ** GrFrameEnd - Marks the end of a frame and adds it to the stats
+ **
+ ** If GrFramePresent was not called all the frame is draw time
+ **
+ **/
+
+void GrFrameEnd(void)
+{
+    long long tend;
+    int i;
+
+    if (tbegin < 0) return;
+    tend = GrUsecTime();
+    if (tpresent < 0) tpresent = tend;
+    if (count < window) {
+        i = first + count++;
+        if (i >= window) i -= window;
+    }
+    else {
+        i = first;
+        if (++first == window) first = 0;
+    }
+    drawt[i] = (long)(tpresent - tbegin);
+    prest[i] = (long)(tend - tpresent);
+    totframes++;
+    tbegin = tpresent = -1;
+}
+
+/**
+ ** GrFrameGetStats - Gets the stats of the frames in the window
+ **
+ ** Arguments:
+ **   st: stats returned, times in usec (all 0 if no frames)
+ **
+ **/
+
+void GrFrameGetStats(GrFrameStats *st)
+{
+    long v[GR_FRAMESTATS_MAXWINDOW];
+
+    st->nframes = count;
+    st->totframes = totframes;
+    memcpy(v, drawt, count * sizeof(long));
+    calcstats(v, count, &st->drawmin, &st->drawavg, &st->drawp99, &st->drawmax);
+    memcpy(v, prest, count * sizeof(long));
+    calcstats(v, count, &st->presmin, &st->presavg, &st->presp99, &st->presmax);
+}
@@ -349,6 +349,8 @@ GrVideoDriver _GrVideoDriverSTDVGA = {
     0,                                  /* inputdriver, not used by now */
     NULL,                               /* generate GREV_EXPOSE events */
     NULL,                               /* generate GREV_WMEND events */
-    NULL                                /* generate GREV_FRAME events */
+    NULL,                               /* generate GREV_FRAME events */
+    NULL,                               /* set hardware cursor */
+    NULL                                /* move hardware cursor */
 };
 
@@ -68,6 +68,15 @@ struct modeset_dev {
 
 static struct modeset_dev *modeset_list = NULL;
 
+/* hardware cursor, a dumb buffer shown in the crtc cursor plane */
+static uint32_t curhandle = 0;
+static uint32_t cursize = 0;
+static uint32_t *curmap = NULL;
+static int curw, curh, curpitch;
+static int curxo, curyo;
+static int curx, cury;
+static int curshown = 0;
+
 static int modeset_find_crtc(int fd, drmModeRes *res, drmModeConnector *conn,
                              struct modeset_dev *dev)
 {
@@ -321,6 +330,96 @@ static void modeset_cleanup(int fd)
     }
 }
 
+static int cursor_create_bo(int fd)
+{
+    struct drm_mode_create_dumb creq;
+    struct drm_mode_destroy_dumb dreq;
+    struct drm_mode_map_dumb mreq;
+    uint64_t cap;
+    void *map;
+
+    curw = curh = 64;
+    if (drmGetCap(fd, DRM_CAP_CURSOR_WIDTH, &cap) == 0 && cap > 0) curw = cap;
+    if (drmGetCap(fd, DRM_CAP_CURSOR_HEIGHT, &cap) == 0 && cap > 0) curh = cap;
+
+    memset(&creq, 0, sizeof(creq));
+    creq.width = curw;
+    creq.height = curh;
+    creq.bpp = 32;
+    if (drmIoctl(fd, DRM_IOCTL_MODE_CREATE_DUMB, &creq) < 0) return -1;
+    curhandle = creq.handle;
+    cursize = creq.size;
+    curpitch = creq.pitch / 4;
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.handle = curhandle;
+    if (drmIoctl(fd, DRM_IOCTL_MODE_MAP_DUMB, &mreq) == 0) {
+        map = mmap(NULL, cursize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, mreq.offset);
+        if (map != MAP_FAILED) {
+            curmap = map;
+            return 0;
+        }
+    }
+
+    memset(&dreq, 0, sizeof(dreq));
+    dreq.handle = curhandle;
+    drmIoctl(fd, DRM_IOCTL_MODE_DESTROY_DUMB, &dreq);
+    curhandle = 0;
+    return -1;
+}
+
+static void cursor_destroy_bo(int fd)
+{
+    struct drm_mode_destroy_dumb dreq;
+
+    if (curmap == NULL) return;
+    if (curshown && modeset_list)
+        drmModeSetCursor(fd, modeset_list->crtc, 0, 0, 0);
+    curshown = 0;
+    munmap(curmap, cursize);
+    curmap = NULL;
+    memset(&dreq, 0, sizeof(dreq));
+    dreq.handle = curhandle;
+    drmIoctl(fd, DRM_IOCTL_MODE_DESTROY_DUMB, &dreq);
+    curhandle = 0;
+}
+
+static int cursor_show(void)
+{
+    if (drmModeSetCursor2(drmfd, modeset_list->crtc, curhandle, curw, curh,
+                          curxo, curyo) != 0 &&
+        drmModeSetCursor(drmfd, modeset_list->crtc, curhandle, curw, curh) != 0)
+        return FALSE;
+    drmModeMoveCursor(drmfd, modeset_list->crtc, curx - curxo, cury - curyo);
+    return TRUE;
+}
+
+static int setcursor(GrCursor *c)
+{
+    if (modeset_list == NULL || fbuffer == NULL) return FALSE;
+    if (c == NULL) {
+        if (curshown) drmModeSetCursor(drmfd, modeset_list->crtc, 0, 0, 0);
+        curshown = 0;
+        return TRUE;
+    }
+    if (curmap == NULL && cursor_create_bo(drmfd) < 0) return FALSE;
+    if (c->xsize > curw || c->ysize > curh) return FALSE;
+    if (!_GrViDrvCursorARGB(c, curmap, curpitch, curh)) return FALSE;
+    curxo = c->xoffs;
+    curyo = c->yoffs;
+    curshown = cursor_show();
+    return curshown;
+}
+
+static void movecursor(int x, int y)
+{
+    curx = x;
+    cury = y;
+    if (curshown)
+        drmModeMoveCursor(drmfd, modeset_list->crtc, x - curxo, y - curyo);
+}
+
 void _LnxdrmSwitchConsoleAndWait(void)
 {
     struct vt_stat vtst;
@@ -351,6 +450,7 @@ void _LnxdrmSwitchConsoleAndWait(void)
     ioctl(ttyfd, KDSETMODE, KD_GRAPHICS);
     drmModeSetCrtc(drmfd, modeset_list->crtc, modeset_list->fb, 0, 0,
                    &modeset_list->conn, 1, &modeset_list->mode);
+    if (curshown) cursor_show();
 
     if (grc != NULL) {
         GrBitBlt(GrScreenContext(), 0, 0, grc, 0, 0,
@@ -514,6 +614,8 @@ static void reset(void)
         return;
     }
 
+    if (drmfd != -1) cursor_destroy_bo(drmfd);
+
     if (fbuffer) {
         modeset_restore_crtc_conf(drmfd);
         fbuffer = NULL;
@@ -575,6 +677,10 @@ static int settext(GrVideoMode * mp, int noclear)
 {
     struct vt_mode vtm;
 
+    if (fbuffer && curshown) {
+        drmModeSetCursor(drmfd, modeset_list->crtc, 0, 0, 0);
+        curshown = 0;
+    }
     if (fbuffer) {
         modeset_restore_crtc_conf(drmfd);
         modeset_list->saved_crtc = NULL;
@@ -606,5 +712,7 @@ GrVideoDriver _GrVideoDriverLINUXDRM = {
     0,                                  /* inputdriver, not used by now */
     NULL,                               /* generate GREV_EXPOSE events */
     NULL,                               /* generate GREV_WMEND events */
-    NULL                                /* generate GREV_FRAME events */
+    NULL,                               /* generate GREV_FRAME events */
+    setcursor,                          /* set hardware cursor */
+    movecursor                          /* move hardware cursor */
 };
@@ -102,6 +102,7 @@
  **                   DIB and reuse it so transitions in window resizes can
  **                   be smooth
  ** 220318 M.Alvarez, changed ALT09AZ recognition to be more generic
+ ** 261019 M.Alvarez, _W32EventAvailable is signaled when an event is queued
  **/
 
 #include "libwin32.h"
@@ -122,6 +123,7 @@ int _W32EventQueueSize = 0;
 int _W32EventQueueRead = 0;
 int _W32EventQueueWrite = 0;
 int _W32EventQueueLength = 0;
+HANDLE _W32EventAvailable = NULL;
 
 int _W32ClientWidth, _W32ClientHeight;
 
@@ -466,6 +468,7 @@ static int init(char *options)
     mainThread = GetCurrentThread();
 
     InitializeCriticalSection(&_csEventQueue);
+    _W32EventAvailable = CreateEvent(NULL, FALSE, FALSE, NULL);
 
     /* The modes not compatible width the configuration */
     /* of Windows are made 'non-present'                */
@@ -501,6 +504,8 @@ static void reset(void)
 
         isMainWaitingTermination = 0;
         DeleteCriticalSection(&_csEventQueue);
+        CloseHandle(_W32EventAvailable);
+        _W32EventAvailable = NULL;
     }
 
     ishDCMemReady = 0;
@@ -579,7 +584,9 @@ GrVideoDriver _GrVideoDriverWIN32 = {
     0,                                  /* inputdriver, not used by now */
     NULL,                               /* generate GREV_EXPOSE events */
     genwmend,                           /* generate GREV_WMEND events */
-    NULL                                /* generate GREV_FRAME events */
+    NULL,                               /* generate GREV_FRAME events */
+    NULL,                               /* set hardware cursor */
+    NULL                                /* move hardware cursor */
 };
 
 static DWORD WINAPI WndThread(void *param)
@@ -648,6 +655,7 @@ static void EnqueueW32Event(UINT uMsg, WPARAM wParam, LPARAM lParam,
             _W32EventQueueRead = 0;
     }
     LeaveCriticalSection(&_csEventQueue);
+    SetEvent(_W32EventAvailable);
 }
 
 static void adjustdims(int wi, int hi, int *wo, int *ho)
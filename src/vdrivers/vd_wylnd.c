@@ -644,6 +644,12 @@ static void reset(void)
         _WGRLastFrame = 0;
         _WGrMaxWidth = 640;
         _WGrMaxHeight = 480;
+        if (curmap) munmap(curmap, HWCURSOR_MAX * HWCURSOR_MAX * 4);
+        curmap = NULL;
+        cursurface = NULL;
+        curbuffer = NULL;
+        curactive = 0;
+        _WGrLastPtrEnterSerial = 0;
     }
     GRX_LEAVE();
 }
@@ -686,6 +692,72 @@ static int genframe(int gen)
     return _WGrGenFrameEvents;
 }
 
+/* the cursor is a surface of its own, the compositor moves it */
+
+#define HWCURSOR_MAX 64
+
+static struct wl_surface *cursurface = NULL;
+static struct wl_buffer *curbuffer = NULL;
+static uint32_t *curmap = NULL;
+static int curxo, curyo;
+static int curactive = 0;
+
+uint32_t _WGrLastPtrEnterSerial = 0;
+
+void _WGrSetPointerCursor(void)
+{
+    if (_WGrState.wl_pointer == NULL) return;
+    if (curactive)
+        wl_pointer_set_cursor(_WGrState.wl_pointer, _WGrLastPtrEnterSerial,
+                              cursurface, curxo, curyo);
+    else // an invisible cursor
+        wl_pointer_set_cursor(_WGrState.wl_pointer, _WGrLastPtrEnterSerial,
+                              NULL, 0, 0);
+}
+
+static int setcursor(GrCursor *c)
+{
+    int size = HWCURSOR_MAX * HWCURSOR_MAX * 4;
+    struct wl_shm_pool *pool;
+    void *map;
+    int fd;
+
+    if (_WGrState.wl_display == NULL || _WGrState.wl_shm == NULL) return FALSE;
+    if (c == NULL) {
+        curactive = 0;
+        _WGrSetPointerCursor();
+        wl_display_flush(_WGrState.wl_display);
+        return TRUE;
+    }
+    if (curmap == NULL) {
+        fd = allocate_shm_file(size);
+        if (fd < 0) return FALSE;
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return FALSE;
+        }
+        pool = wl_shm_create_pool(_WGrState.wl_shm, fd, size);
+        curbuffer = wl_shm_pool_create_buffer(pool, 0, HWCURSOR_MAX,
+                    HWCURSOR_MAX, HWCURSOR_MAX * 4, WL_SHM_FORMAT_ARGB8888);
+        wl_shm_pool_destroy(pool);
+        close(fd);
+        cursurface = wl_compositor_create_surface(_WGrState.wl_compositor);
+        curmap = map;
+    }
+    if (!_GrViDrvCursorARGB(c, curmap, HWCURSOR_MAX, HWCURSOR_MAX))
+        return FALSE;
+    wl_surface_attach(cursurface, curbuffer, 0, 0);
+    wl_surface_damage(cursurface, 0, 0, HWCURSOR_MAX, HWCURSOR_MAX);
+    wl_surface_commit(cursurface);
+    curxo = c->xoffs;
+    curyo = c->yoffs;
+    curactive = 1;
+    _WGrSetPointerCursor();
+    wl_display_flush(_WGrState.wl_display);
+    return TRUE;
+}
+
 GrVideoDriver _GrVideoDriverWAYLAND = {
     "wayland",                          /* name */
     GR_WAYLAND,                         /* adapter type */
@@ -701,5 +773,7 @@ GrVideoDriver _GrVideoDriverWAYLAND = {
     0,                                  /* inputdriver, not used by now */
     NULL,                               /* generate GREV_EXPOSE events */
     genwmend,                           /* generate GREV_WMEND events */
-    genframe                            /* generate GREV_FRAME events */
+    genframe,                           /* generate GREV_FRAME events */
+    setcursor,                          /* set hardware cursor */
+    NULL                                /* move hardware cursor */
 };
@@ -30,6 +30,7 @@
  ** 211206 M.Alvarez, when window resizing is active create a big backing store and
  **                   not recreate it in every setmode, so resizing is smooth
  ** 220206 M.Alvarez, X11 clipboard support
+ ** 261019 M.Alvarez, native X cursor used as hardware cursor
  **/
 
 #include "libgrx.h"
@@ -625,6 +626,90 @@ int genwmend(int gen)
     return _XGrGenWMEndEvents;
 }
 
+void _XGrSetBlankCursor(void)
+{
+    static char cbits[8] = { 0,0,0,0,0,0,0,0, };
+    Pixmap csource, cmask;
+    XColor cfore, cback;
+    Cursor curs;
+
+    csource = cmask = XCreateBitmapFromData(
+                      _XGrDisplay, _XGrWindow, cbits, 8, 8);
+    cfore.red = cfore.green = cfore.blue = 0;
+    cback.red = cback.green = cback.blue = 0;
+    curs = XCreatePixmapCursor(
+           _XGrDisplay, csource, cmask, &cfore, &cback, 0, 0);
+    XDefineCursor(_XGrDisplay, _XGrWindow, curs);
+    XFreeCursor(_XGrDisplay, curs);
+    XFreePixmap(_XGrDisplay, csource);
+}
+
+/* core X cursors have two colors, if the GrCursor has more the
+   library draws it */
+
+#define HWCURSOR_MAX 64
+
+static int setcursor(GrCursor *c)
+{
+    static unsigned int argb[HWCURSOR_MAX * HWCURSOR_MAX];
+    static unsigned char src[HWCURSOR_MAX * HWCURSOR_MAX / 8];
+    static unsigned char msk[HWCURSOR_MAX * HWCURSOR_MAX / 8];
+    unsigned int p, col[2];
+    int ncol = 0, bpl, x, y, k;
+    Pixmap psrc, pmsk;
+    XColor cfore, cback;
+    Cursor curs;
+
+    if (_XGrDisplay == NULL || _XGrWindow == None || !_XGrWindowedMode)
+        return FALSE;
+    if (c == NULL) {
+        _XGrSetBlankCursor();
+        XFlush(_XGrDisplay);
+        return TRUE;
+    }
+    if (!_GrViDrvCursorARGB(c, argb, HWCURSOR_MAX, HWCURSOR_MAX))
+        return FALSE;
+
+    bpl = (c->xsize + 7) / 8;
+    memset(src, 0, sizeof(src));
+    memset(msk, 0, sizeof(msk));
+    for (y = 0; y < c->ysize; y++) {
+        for (x = 0; x < c->xsize; x++) {
+            p = argb[y * HWCURSOR_MAX + x];
+            if ((p >> 24) == 0) continue;
+            p &= 0xffffff;
+            if (ncol > 0 && p == col[0]) k = 0;
+            else if (ncol > 1 && p == col[1]) k = 1;
+            else if (ncol < 2) { col[ncol] = p; k = ncol++; }
+            else return FALSE;
+            msk[y * bpl + x / 8] |= 1 << (x & 7);
+            if (k == 0) src[y * bpl + x / 8] |= 1 << (x & 7);
+        }
+    }
+    if (ncol == 0) col[0] = 0;
+    if (ncol < 2) col[1] = col[0];
+    cfore.red   = ((col[0] >> 16) & 0xff) * 257;
+    cfore.green = ((col[0] >> 8) & 0xff) * 257;
+    cfore.blue  = (col[0] & 0xff) * 257;
+    cback.red   = ((col[1] >> 16) & 0xff) * 257;
+    cback.green = ((col[1] >> 8) & 0xff) * 257;
+    cback.blue  = (col[1] & 0xff) * 257;
+
+    psrc = XCreateBitmapFromData(_XGrDisplay, _XGrWindow, (char *)src,
+                                 c->xsize, c->ysize);
+    pmsk = XCreateBitmapFromData(_XGrDisplay, _XGrWindow, (char *)msk,
+                                 c->xsize, c->ysize);
+    curs = XCreatePixmapCursor(_XGrDisplay, psrc, pmsk, &cfore, &cback,
+                               c->xoffs, c->yoffs);
+    XFreePixmap(_XGrDisplay, psrc);
+    XFreePixmap(_XGrDisplay, pmsk);
+    if (curs == None) return FALSE;
+    XDefineCursor(_XGrDisplay, _XGrWindow, curs);
+    XFreeCursor(_XGrDisplay, curs);
+    XFlush(_XGrDisplay);
+    return TRUE;
+}
+
 GrVideoDriver _GrVideoDriverXWIN = {
     "xwin",                             /* name */
     GR_XWIN,                            /* adapter type */
@@ -639,5 +724,7 @@ GrVideoDriver _GrVideoDriverXWIN = {
     0,                                  /* inputdriver, not used by now */
     genexpose,                          /* generate GREV_EXPOSE events */
     genwmend,                           /* generate GREV_WMEND events */
-    NULL                                /* generate GREV_FRAME events */
+    NULL,                               /* generate GREV_FRAME events */
+    setcursor,                          /* set hardware cursor */
+    NULL                                /* move hardware cursor */
 };
@@ -0,0 +1,156 @@
+/**
+ ** aafont.c ---- test anti-aliased (coverage) fonts
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NREPS 200
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+static char *fontname = "helv38";
+static int scale = 3;
+
+static char *text = "The quick brown fox jumps over the lazy dog";
+
+static GrFont *loadfont(char *name)
+{
+    char aux[81];
+    GrFont *f;
+
+    f = GrLoadFont(name);
+    if (f == NULL) {
+        sprintf(aux, "../fonts/%s", name);
+        f = GrLoadFont(aux);
+    }
+    return f;
+}
+
+static void background(void)
+{
+    int y;
+
+    for (y=0; y<GrSizeY(); y++)
+        GrHLine(0, GrMaxX(), y, GrAllocColor(y*255/GrSizeY(), 128, 64));
+}
+
+static long speed(GrTextOption *opt)
+{
+    long t1;
+    int i;
+
+    t1 = GrMsecTime();
+    for (i=0; i<NREPS; i++)
+        GrDrawString(text, 0, 10, 300 + (i % 10) * 16, opt);
+    return GrMsecTime() - t1;
+}
+
+int main(int argc, char **argv)
+{
+    GrFont *big, *aa, *bw;
+    GrTextOption opt;
+    GrEvent ev;
+    char s[121];
+    long t1, t2;
+
+    if (argc >= 2) fontname = argv[1];
+    if (argc >= 3) scale = atoi(argv[2]);
+    if (argc >= 6) {
+        gwidth = atoi(argv[3]);
+        gheight = atoi(argv[4]);
+        gbpp = atoi(argv[5]);
+    }
+
+    big = loadfont(fontname);
+    if (big == NULL) {
+        fprintf(stderr, "can't load font %s\n", fontname);
+        return 1;
+    }
+    aa = GrBuildCoverageFont(big, scale);
+    if (aa == NULL) {
+        fprintf(stderr, "can't build the anti-aliased font\n");
+        return 1;
+    }
+    /* the same font, only the bitmap */
+    bw = GrBuildConvertedFont(aa, GR_FONTCVT_NONE, 0, 0, 0, 0);
+    if (bw == NULL) return 1;
+    free(bw->covmap);
+    bw->covmap = NULL;
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    background();
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_bgcolor = GrNOCOLOR;
+    opt.txo_chrtype = GR_BYTE_TEXT;
+    opt.txo_direct = GR_TEXT_RIGHT;
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+
+    opt.txo_font = bw;
+    GrDrawString(text, 0, 10, 10, &opt);
+    opt.txo_font = aa;
+    GrDrawString(text, 0, 10, 40, &opt);
+    opt.txo_fgcolor = GrAllocColor(0, 0, 128);
+    opt.txo_bgcolor = GrAllocColor(255, 255, 192);
+    opt.txo_font = bw;
+    GrDrawString(text, 0, 10, 80, &opt);
+    opt.txo_font = aa;
+    GrDrawString(text, 0, 10, 110, &opt);
+    /* rotated and underlined text use the bitmap */
+    opt.txo_fgcolor = GrWhite() | GR_UNDERLINE_TEXT;
+    opt.txo_bgcolor = GrNOCOLOR;
+    GrDrawString(text, 0, 10, 150, &opt);
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_direct = GR_TEXT_UP;
+    GrDrawString("Rotated", 0, GrMaxX() - 30, 280, &opt);
+    opt.txo_direct = GR_TEXT_RIGHT;
+
+    sprintf(s, "%s / %d, press any key to test speed", fontname, scale);
+    GrTextXY(10, GrMaxY() - 20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    background();
+    opt.txo_font = bw;
+    t1 = speed(&opt);
+    opt.txo_font = aa;
+    t2 = speed(&opt);
+    sprintf(s, "transparent: bitmap %ld ms, anti-aliased %ld ms", t1, t2);
+    GrTextXY(10, 10, s, GrWhite(), GrBlack());
+    opt.txo_bgcolor = GrBlack();
+    opt.txo_font = bw;
+    t1 = speed(&opt);
+    opt.txo_font = aa;
+    t2 = speed(&opt);
+    sprintf(s, "opaque: bitmap %ld ms, anti-aliased %ld ms", t1, t2);
+    GrTextXY(10, 30, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    GrUnloadFont(bw);
+    GrUnloadFont(aa);
+    GrUnloadFont(big);
+    return 0;
+}
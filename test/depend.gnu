@@ -33,6 +33,7 @@ pixmtest.o: pixmtest.c test.h ../include/mgrx.h ../include/mgrxkeys.h \
  drawing.h rand.h
 pnmtest.o: pnmtest.c ../include/mgrx.h ../include/mgrxkeys.h
 pngtest.o: pngtest.c ../include/mgrx.h ../include/mgrxkeys.h
+qoitest.o: qoitest.c ../include/mgrx.h ../include/mgrxkeys.h
 polytest.o: polytest.c test.h ../include/mgrx.h ../include/mgrxkeys.h \
  drawing.h rand.h
 polytedb.o: polytedb.c test.h ../include/mgrx.h ../include/mgrxkeys.h \
@@ -43,6 +44,16 @@ sbctest.o: sbctest.c test.h ../include/mgrx.h ../include/mgrxkeys.h \
  drawing.h rand.h
 scroltst.o: scroltst.c test.h ../include/mgrx.h ../include/mgrxkeys.h \
  drawing.h rand.h
+strchtst.o: strchtst.c ../include/mgrx.h ../include/mgrxkeys.h
+dithtst.o: dithtst.c ../include/mgrx.h ../include/mgrxkeys.h
+txtgrid.o: txtgrid.c ../include/mgrx.h ../include/mgrxkeys.h
+aafont.o: aafont.c ../include/mgrx.h ../include/mgrxkeys.h
+strkfont.o: strkfont.c ../include/mgrx.h ../include/mgrxkeys.h
+rottext.o: rottext.c ../include/mgrx.h ../include/mgrxkeys.h
+textrun.o: textrun.c ../include/mgrx.h ../include/mgrxkeys.h
+evloop.o: evloop.c ../include/mgrx.h ../include/mgrxkeys.h
+evreplay.o: evreplay.c ../include/mgrx.h ../include/mgrxkeys.h
+framstat.o: framstat.c ../include/mgrx.h ../include/mgrxkeys.h
 speedtst.o: speedtst.c rand.h ../include/mgrx.h
 speedts2.o: speedts2.c rand.h ../include/mgrx.h
 textpatt.o: textpatt.c ../include/mgrx.h ../include/mgrxkeys.h
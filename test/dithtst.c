@@ -0,0 +1,104 @@
+/**
+ ** dithtst.c ---- test the image loaders dithering
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#if defined(__MSDOS__) || defined(__WIN32__)
+#define FIMAGEPPM "..\\testimg\\pnmtest.ppm"
+#define FIMAGEPNG "..\\testimg\\pngowl.png"
+#else
+#define FIMAGEPPM "../testimg/pnmtest.ppm"
+#define FIMAGEPNG "../testimg/pngowl.png"
+#endif
+
+/* default mode, dithering is for low color modes */
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 8;
+
+static int modes[5] = {
+    GR_DITHER_NONE,
+    GR_DITHER_ORDERED,
+    GR_DITHER_FLOYD,
+    GR_DITHER_NONE | GR_DITHER_OPTPAL,
+    GR_DITHER_FLOYD | GR_DITHER_OPTPAL
+};
+
+static char *mname[5] = {
+    "no dithering",
+    "ordered dithering",
+    "Floyd-Steinberg dithering",
+    "optimal palette, no dithering",
+    "optimal palette, Floyd-Steinberg dithering"
+};
+
+static void imagen(char *nf, int png, int mode)
+{
+    GrContext *grc;
+    long t1, t2;
+    char s[121];
+    GrEvent ev;
+
+    /* every image starts with a clean palette */
+    GrResetColors();
+    GrSetImageDither(modes[mode]);
+    GrClearScreen(GrBlack());
+    grc = GrCreateSubContext(10, 40, GrMaxX()-10, GrMaxY()-10, NULL, NULL);
+    t1 = GrMsecTime();
+    if (png)
+        GrLoadContextFromPng(grc, nf, 0);
+    else
+        GrLoadContextFromPnm(grc, nf);
+    t2 = GrMsecTime();
+    GrDestroyContext(grc);
+    sprintf(s, "%s: %s, %ld ms", nf, mname[mode], t2-t1);
+    GrTextXY(10, 10, s, GrWhite(), GrBlack());
+    GrTextXY(10, 25, "Press any key to continue", GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    for (i=0; i<5; i++)
+        imagen(FIMAGEPPM, 0, i);
+    if (GrPngSupport()) {
+        for (i=0; i<5; i++)
+            imagen(FIMAGEPNG, 1, i);
+    }
+
+    GrSetImageDither(GR_DITHER_NONE);
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    return 0;
+}
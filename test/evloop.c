@@ -0,0 +1,105 @@
+/**
+ ** evloop.c ---- test timers and fds in the event loop
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+int main(int argc, char **argv)
+{
+    GrEvent ev;
+    char s[121];
+    int tblink, tmsg, blink = 0, nticks = 0, nlines = 0;
+    int havefd, polling = 0;
+    long t0;
+    clock_t c0;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    tblink = GrEventAddTimer(500, 1, 0);
+    tmsg = GrEventAddTimer(3000, 0, 0);
+    havefd = GrEventAddFd(0, GR_FD_READ, 0) == 0;
+
+    GrTextXY(10, 10, "Periodic timer blinks the box, one shot timer at 3 s",
+             GrWhite(), GrBlack());
+    if (havefd)
+        GrTextXY(10, 30, "Type lines in the console (stdin is watched)",
+                 GrWhite(), GrBlack());
+    else
+        GrTextXY(10, 30, "Fds can't be watched in this system",
+                 GrWhite(), GrBlack());
+    GrTextXY(10, 50, "Press P to poll with GrEventCheck, ESC to exit",
+             GrWhite(), GrBlack());
+    GrTextXY(80, 120, "waiting with GrEventWait ", GrWhite(), GrBlack());
+
+    t0 = GrMsecTime();
+    c0 = clock();
+    while (1) {
+        if (polling) {
+            if (!GrEventCheck()) continue;
+            GrEventRead(&ev);
+        }
+        else
+            GrEventWait(&ev);
+        if (ev.type == GREV_KEY && ev.p1 == GrKey_Escape) break;
+        if (ev.type == GREV_KEY && (ev.p1 == 'p' || ev.p1 == 'P')) {
+            polling = !polling;
+            GrTextXY(80, 120, polling ? "polling with GrEventCheck" :
+                     "waiting with GrEventWait ", GrWhite(), GrBlack());
+        }
+        if (ev.type == GREV_TIMER && ev.p1 == tblink) {
+            blink = !blink;
+            GrFilledBox(10, 80, 60, 130, blink ? GrAllocColor(255, 0, 0) : GrBlack());
+            nticks++;
+            sprintf(s, "%d ticks in %ld ms, cpu %ld ms", nticks,
+                    GrMsecTime() - t0,
+                    (long)((clock() - c0) * 1000 / CLOCKS_PER_SEC));
+            GrTextXY(80, 100, s, GrWhite(), GrBlack());
+        }
+        if (ev.type == GREV_TIMER && ev.p1 == tmsg)
+            GrTextXY(10, 150, "one shot timer expired", GrWhite(), GrBlack());
+        if (ev.type == GREV_FDREADY) {
+            if (ev.p2 & GR_FD_READ && fgets(s, 100, stdin) != NULL) {
+                GrTextXY(10, 180 + (nlines % 10) * 20, s, GrWhite(), GrBlack());
+                nlines++;
+            }
+            else
+                GrEventRemoveFd(ev.p1);
+        }
+    }
+
+    GrEventRemoveTimer(tblink);
+    if (havefd) GrEventRemoveFd(0);
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ ** evreplay.c ---- test event record and replay
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** evreplay -r file     draw with the mouse and record the events
+ ** evreplay -p file     replay them with the recorded timing
+ ** evreplay -f file     replay them as fast as possible
+ **
+ ** With the memory videodriver the replay runs without a display, the
+ ** timing report is printed at the end
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+int main(int argc, char **argv)
+{
+    GrReplayStats st;
+    GrEvent ev;
+    char s[121];
+    int replay = 0, lastx = -1, lasty = -1;
+    GrColor color;
+
+    if (argc < 3) {
+        printf("usage: evreplay -r|-p|-f file [width height bpp]\n");
+        return 1;
+    }
+    if (argc >= 6) {
+        gwidth = atoi(argv[3]);
+        gheight = atoi(argv[4]);
+        gbpp = atoi(argv[5]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+    GrEventGenMmove(GR_GEN_MMOVE_IFBUT);
+
+    if (strcmp(argv[1], "-r") == 0) {
+        if (GrEventStartRecord(argv[2]) < 0) goto error;
+        GrTextXY(10, 10, "Recording, draw with the mouse, ESC to end",
+                 GrWhite(), GrBlack());
+    } else {
+        replay = (strcmp(argv[1], "-f") == 0) ? GR_REPLAY_FAST
+                                              : GR_REPLAY_REALTIME;
+        if (GrEventStartReplay(argv[2], replay) < 0) goto error;
+        replay = 1;
+    }
+
+    color = GrAllocColor(255, 255, 0);
+    while (1) {
+        GrEventWait(&ev);
+        if (ev.type == GREV_KEY && ev.p1 == GrKey_Escape) break;
+        if (ev.type == GREV_REPLAYEND) break;
+        if (ev.type == GREV_KEY && ev.p1 == 'c') GrClearScreen(GrBlack());
+        if (ev.type == GREV_MOUSE && ev.p1 == GRMOUSE_LB_PRESSED) {
+            lastx = ev.p2;
+            lasty = ev.p3;
+        }
+        if (ev.type == GREV_MOUSE && ev.p1 == GRMOUSE_LB_RELEASED)
+            lastx = -1;
+        if (ev.type == GREV_MMOVE && lastx >= 0) {
+            GrLine(lastx, lasty, ev.p2, ev.p3, color);
+            lastx = ev.p2;
+            lasty = ev.p3;
+        }
+    }
+
+    if (replay) {
+        GrEventReplayStats(&st);
+        sprintf(s, "%ld events, recorded %ld ms, replayed %ld ms, "
+                "processing %ld ms (max %ld)", st.nevents, st.recmsec,
+                st.msec, st.evmsec, st.maxevmsec);
+    }
+    GrEventStopRecord();
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    if (replay) printf("%s\n", s);
+    return 0;
+
+error:
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    printf("can't open %s\n", argv[2]);
+    return 1;
+}
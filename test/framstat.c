@@ -0,0 +1,92 @@
+/**
+ ** framstat.c ---- test the usec timer and the frame timing statistics
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NBOXES 200
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+int main(int argc, char **argv)
+{
+    GrFrameStats st;
+    GrEvent ev;
+    GrColor c[16];
+    char s[121];
+    long long t;
+    int i, x, y, frame = 0, maxframes = 0;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+    if (argc >= 5) maxframes = atoi(argv[4]);
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    for (i = 0; i < 16; i++)
+        c[i] = GrAllocColor((i & 1) * 255, (i & 2) * 127, (i & 4) * 63 + 3);
+
+    t = GrUsecTime();
+    GrSleep(2);
+    sprintf(s, "GrSleep(2) took %lld usec", GrUsecTime() - t);
+    GrTextXY(10, 10, s, GrWhite(), GrBlack());
+    GrTextXY(10, 30, "Press ESC to exit", GrWhite(), GrBlack());
+
+    GrFrameStatsSetWindow(60);
+    while (1) {
+        GrFrameBegin();
+        for (i = 0; i < NBOXES; i++) {
+            x = (i * 37 + frame * 3) % (GrSizeX() - 40);
+            y = 60 + (i * 53) % (GrSizeY() - 140);
+            GrFilledBox(x, y, x + 30, y + 30, c[(i + frame) & 15]);
+        }
+        GrFramePresent();
+        GrEventRead(&ev);
+        GrFrameEnd();
+
+        if (ev.type == GREV_KEY && ev.p1 == GrKey_Escape) break;
+        if (++frame == maxframes) break;
+        if (frame % 30 == 0) {
+            GrFrameGetStats(&st);
+            sprintf(s, "draw  min %6ld avg %6ld p99 %6ld max %6ld usec",
+                    st.drawmin, st.drawavg, st.drawp99, st.drawmax);
+            GrTextXY(10, GrMaxY() - 60, s, GrWhite(), GrBlack());
+            sprintf(s, "event min %6ld avg %6ld p99 %6ld max %6ld usec",
+                    st.presmin, st.presavg, st.presp99, st.presmax);
+            GrTextXY(10, GrMaxY() - 40, s, GrWhite(), GrBlack());
+            sprintf(s, "%ld frames, %d in the window", st.totframes, st.nframes);
+            GrTextXY(10, GrMaxY() - 20, s, GrWhite(), GrBlack());
+        }
+    }
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    GrFrameGetStats(&st);
+    printf("%ld frames, draw avg %ld usec p99 %ld usec\n",
+           st.totframes, st.drawavg, st.drawp99);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ ** qoitest.c ---- test the ctx2qoi and qoi2ctx routines
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#if defined(__MSDOS__) || defined(__WIN32__)
+#define FIMAGEPPM "..\\testimg\\pnmtest.ppm"
+#define FIMAGEQOI "..\\testimg\\qoitest.qoi"
+#define FSCREEN "..\\testimg\\output.qoi"
+#else
+#define FIMAGEPPM "../testimg/pnmtest.ppm"
+#define FIMAGEQOI "../testimg/qoitest.qoi"
+#define FSCREEN "../testimg/output.qoi"
+#endif
+
+/* default mode */
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 24;
+
+int main(int argc, char **argv)
+{
+    GrContext *grc;
+    int wide, high, maxval;
+    long t1, t2;
+    char s[81];
+    GrEvent ev;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    GrQueryPnm(FIMAGEPPM, &wide, &high, &maxval);
+    sprintf(s, "%s %d x %d pixels, saved as %s", FIMAGEPPM, wide, high, FIMAGEQOI);
+    GrTextXY(10, 20, s, GrBlack(), GrWhite());
+    GrBox(10, 40, 10+wide+1, 40+high+1, GrWhite());
+    grc = GrCreateSubContext(11, 41, 11+wide-1, 41+high-1, NULL, NULL);
+    GrLoadContextFromPnm(grc, FIMAGEPPM);
+    GrSaveContextToQoi(grc, FIMAGEQOI);
+    GrDestroyContext(grc);
+    GrTextXY(10, 50+high, "Press RETURN to continue", GrBlack(), GrWhite());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrClearScreen(GrBlack());
+    GrQueryQoi(FIMAGEQOI, &wide, &high);
+    sprintf(s, "%s %d x %d pixels", FIMAGEQOI, wide, high);
+    GrTextXY(10, 20, s, GrBlack(), GrWhite());
+    GrBox(10, 40, 10+wide+1, 40+high+1, GrWhite());
+    grc = GrCreateSubContext(11, 41, 11+wide-1, 41+high-1, NULL, NULL);
+    GrLoadContextFromQoi(grc, FIMAGEQOI, 0);
+    GrDestroyContext(grc);
+    GrTextXY(10, 50+high, "Press RETURN to save screen", GrBlack(), GrWhite());
+    GrEventWaitKeyOrClick(&ev);
+
+    t1 = GrMsecTime();
+    GrSaveContextToQoi(NULL, FSCREEN);
+    t2 = GrMsecTime();
+    GrClearScreen(GrWhite());
+    sprintf(s, "Screen saved in %ld ms, press RETURN to reload screen", t2-t1);
+    GrTextXY(10, 20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    t1 = GrMsecTime();
+    GrLoadContextFromQoi(NULL, FSCREEN, 0);
+    t2 = GrMsecTime();
+    sprintf(s, "Screen loaded in %ld ms, press RETURN to end", t2-t1);
+    GrTextXY(10, 20, s, GrBlack(), GrWhite());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    return 0;
+}
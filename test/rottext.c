@@ -0,0 +1,116 @@
+/**
+ ** rottext.c ---- test text drawn at any angle
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NREPS 1000
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+static char *fontname = "helv22";
+
+static GrFont *loadfont(char *name)
+{
+    char aux[81];
+    GrFont *f;
+
+    f = GrLoadFont(name);
+    if (f == NULL) {
+        sprintf(aux, "../fonts/%s", name);
+        f = GrLoadFont(aux);
+    }
+    return f;
+}
+
+int main(int argc, char **argv)
+{
+    GrTextOption opt;
+    GrFont *f;
+    GrEvent ev;
+    char s[121];
+    long t1, t2;
+    int i, cx, cy;
+
+    if (argc >= 2) fontname = argv[1];
+    if (argc >= 5) {
+        gwidth = atoi(argv[2]);
+        gheight = atoi(argv[3]);
+        gbpp = atoi(argv[4]);
+    }
+
+    f = loadfont(fontname);
+    if (f == NULL) {
+        fprintf(stderr, "can't load font %s\n", fontname);
+        return 1;
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    opt.txo_font = f;
+    opt.txo_chrtype = GR_BYTE_TEXT;
+    opt.txo_direct = GR_TEXT_RIGHT;
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_CENTER;
+    opt.txo_bgcolor = GrNOCOLOR;
+
+    /* a wheel of labels */
+    cx = GrSizeX() / 2;
+    cy = GrSizeY() / 2 - 20;
+    for (i = 0; i < 24; i++) {
+        opt.txo_fgcolor = GrAllocColor(255 - i * 10, 128 + i * 5, i * 10);
+        if (i == 6) opt.txo_fgcolor |= GR_UNDERLINE_TEXT;
+        sprintf(s, "  %d degrees", i * 15);
+        GrDrawRotatedString(s, 0, cx, cy, i * 150, &opt);
+    }
+
+    /* axis labels with background */
+    opt.txo_fgcolor = GrBlack();
+    opt.txo_bgcolor = GrAllocColor(255, 255, 192);
+    opt.txo_xalign = GR_ALIGN_CENTER;
+    GrDrawRotatedString("Y axis label", 0, 20, cy, 900, &opt);
+    GrDrawRotatedString("Tilted label", 0, GrMaxX() - 80, 60, -300, &opt);
+
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_bgcolor = GrNOCOLOR;
+    t1 = GrMsecTime();
+    for (i = 0; i < NREPS; i++)
+        GrDrawString("Speed test", 0, 10, GrMaxY() - 60, &opt);
+    t1 = GrMsecTime() - t1;
+    t2 = GrMsecTime();
+    for (i = 0; i < NREPS; i++)
+        GrDrawRotatedString("Speed test", 0, 200, GrMaxY() - 60, 150, &opt);
+    t2 = GrMsecTime() - t2;
+
+    sprintf(s, "%d strings: normal %ld ms, rotated %ld ms", NREPS, t1, t2);
+    GrTextXY(10, GrMaxY() - 20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    GrUnloadFont(f);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ ** strchtst.c ---- test the GrStretchBlt and GrStretchBltFilter functions
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#if defined(__MSDOS__) || defined(__WIN32__)
+#define FIMAGEPPM "..\\testimg\\pnmtest.ppm"
+#else
+#define FIMAGEPPM "../testimg/pnmtest.ppm"
+#endif
+
+/* default mode */
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 24;
+
+static char *fname[3] = {"nearest", "bilinear", "area"};
+
+static void stretch(GrContext *img, int wide, int high, int dw, int dh,
+                    int f1, int f2, char *title)
+{
+    long t1, t2, t3;
+    char s[81];
+    GrEvent ev;
+
+    GrClearScreen(GrBlack());
+    GrTextXY(10, 10, title, GrWhite(), GrBlack());
+    t1 = GrMsecTime();
+    GrStretchBltFilter(NULL, 10, 40, 10+dw-1, 40+dh-1,
+                       img, 0, 0, wide-1, high-1, GrWRITE, f1);
+    t2 = GrMsecTime();
+    GrStretchBltFilter(NULL, 20+dw, 40, 20+2*dw-1, 40+dh-1,
+                       img, 0, 0, wide-1, high-1, GrWRITE, f2);
+    t3 = GrMsecTime();
+    sprintf(s, "left %s %ld ms, right %s %ld ms, press RETURN",
+            fname[f1], t2-t1, fname[f2], t3-t2);
+    GrTextXY(10, 25, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+}
+
+int main(int argc, char **argv)
+{
+    GrContext *img;
+    int wide, high, maxval;
+    GrEvent ev;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    if (GrQueryPnm(FIMAGEPPM, &wide, &high, &maxval) < 0 ||
+        (img = GrCreateContext(wide, high, NULL, NULL)) == NULL) {
+        GrTextXY(10, 10, "Can't load " FIMAGEPPM ", press RETURN",
+                 GrWhite(), GrBlack());
+        GrEventWaitKeyOrClick(&ev);
+        GrEventUnInit();
+        GrSetMode(GR_default_text);
+        return 1;
+    }
+    GrLoadContextFromPnm(img, FIMAGEPPM);
+
+    stretch(img, wide, high, (GrSizeX()-30)/2, GrSizeY()-50,
+            GR_STRETCH_NEAREST, GR_STRETCH_BILINEAR, "Upscaling");
+    stretch(img, wide, high, wide/3, high/3,
+            GR_STRETCH_NEAREST, GR_STRETCH_AREA, "Downscaling to 1/3");
+    stretch(img, wide, high, wide/7, high/7,
+            GR_STRETCH_NEAREST, GR_STRETCH_AREA, "Downscaling to 1/7");
+
+    GrDestroyContext(img);
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ ** strkfont.c ---- test scaled, anti-aliased and stroke BGI fonts
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NLOADS 100
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+static char *fontname = "sans.chr";
+
+static char *text = "The quick brown fox";
+
+static GrFont *loadsize(int cvt, int h)
+{
+    return GrLoadConvertedFont(fontname, GR_FONTCVT_RESIZE | cvt, 0, h, 0, 0);
+}
+
+int main(int argc, char **argv)
+{
+    static int sizes[] = { 12, 16, 24, 32, 48 };
+    GrStrokeTextOption sto;
+    GrTextOption opt;
+    GrStrokeFont *sf;
+    GrFont *f;
+    GrEvent ev;
+    char s[121];
+    long t1, t2;
+    int i, y;
+
+    if (argc >= 2) fontname = argv[1];
+    if (argc >= 5) {
+        gwidth = atoi(argv[2]);
+        gheight = atoi(argv[3]);
+        gbpp = atoi(argv[4]);
+    }
+
+    sf = GrLoadStrokeFont(fontname);
+    if (sf == NULL) {
+        fprintf(stderr, "can't load stroke font %s\n", fontname);
+        return 1;
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    /* pre-rasterized sizes, bitmap and anti-aliased */
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_bgcolor = GrNOCOLOR;
+    opt.txo_chrtype = GR_BYTE_TEXT;
+    opt.txo_direct = GR_TEXT_RIGHT;
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+    for (i = 0, y = 10; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        opt.txo_font = loadsize(GR_FONTCVT_NONE, sizes[i]);
+        if (opt.txo_font == NULL) continue;
+        GrDrawString(text, 0, 10, y, &opt);
+        GrUnloadFont(opt.txo_font);
+        opt.txo_font = loadsize(GR_FONTCVT_ANTIALIAS, sizes[i]);
+        if (opt.txo_font != NULL) {
+            GrDrawString(text, 0, GrSizeX() / 2, y, &opt);
+            GrUnloadFont(opt.txo_font);
+        }
+        y += sizes[i] + 4;
+    }
+
+    /* unloaded sizes stay in the font cache */
+    t1 = GrMsecTime();
+    for (i = 0; i < NLOADS; i++) {
+        f = loadsize(GR_FONTCVT_ANTIALIAS, sizes[i % 5]);
+        GrUnloadFont(f);
+    }
+    t1 = GrMsecTime() - t1;
+    GrFlushFontCache();
+    t2 = GrMsecTime();
+    for (i = 0; i < NLOADS / 10; i++) {
+        f = loadsize(GR_FONTCVT_ANTIALIAS, sizes[i % 5]);
+        GrUnloadFont(f);
+        GrFlushFontCache();
+    }
+    t2 = (GrMsecTime() - t2) * 10;
+    sprintf(s, "%d loads: cached %ld ms, uncached %ld ms", NLOADS, t1, t2);
+    GrTextXY(10, GrMaxY() - 40, s, GrWhite(), GrBlack());
+    sprintf(s, "%s, press any key to see stroke text", fontname);
+    GrTextXY(10, GrMaxY() - 20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    /* stroke text, any size and angle */
+    GrClearScreen(GrBlack());
+    sto.sto_font = sf;
+    sto.sto_chrtype = GR_BYTE_TEXT;
+    sto.sto_xalign = GR_ALIGN_LEFT;
+    sto.sto_yalign = GR_ALIGN_BASELINE;
+    for (i = 0; i < 12; i++) {
+        sto.sto_height = 16 + i * 2;
+        sto.sto_angle = i * 300;
+        sto.sto_color = GrAllocColor(255 - i * 20, 128, i * 20);
+        GrDrawStrokeString("  Stroke text", 0, GrSizeX() / 2, GrSizeY() / 2, &sto);
+    }
+    sto.sto_height = 30;
+    sto.sto_angle = 0;
+    sto.sto_color = GrWhite();
+    sto.sto_xalign = GR_ALIGN_CENTER;
+    sto.sto_yalign = GR_ALIGN_TOP;
+    GrDrawStrokeString(text, 0, GrSizeX() / 2, 10, &sto);
+    i = GrStrokeStringWidth(text, 0, &sto);
+    GrHLine(GrSizeX() / 2 - i / 2, GrSizeX() / 2 + i / 2, 45, GrWhite());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    GrUnloadStrokeFont(sf);
+    return 0;
+}
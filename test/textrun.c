@@ -0,0 +1,140 @@
+/**
+ ** textrun.c ---- test text runs (text laid out once, drawn many times)
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NREPS 500
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 32;
+
+static char *fontname = "helv15";
+
+static char *text =
+    "MGRX is a 2D graphics C library derived from the GRX library. "
+    "Text runs are recoded, measured and broken in lines once, then "
+    "they can be drawn many times.\n"
+    "AVATAR, Tokyo, WAVE: kerning pairs are optional.";
+
+static GrKernPair kern[] = {
+    { 'A', 'V', -2 }, { 'V', 'A', -2 }, { 'A', 'T', -1 }, { 'T', 'A', -1 },
+    { 'T', 'o', -2 }, { 'W', 'A', -2 }, { 'A', 'W', -2 }, { 'V', 'E', -1 }
+};
+
+static GrFont *loadfont(char *name)
+{
+    char aux[81];
+    GrFont *f;
+
+    f = GrLoadFont(name);
+    if (f == NULL) {
+        sprintf(aux, "../fonts/%s", name);
+        f = GrLoadFont(aux);
+    }
+    return f;
+}
+
+/* what a program does without text runs */
+static void drawwrapped(char *s, int x, int y, int maxw, const GrTextOption *opt)
+{
+    int n, last, w;
+
+    while (*s) {
+        for (n = 0, last = 0; s[n] && s[n] != '\n'; n++) {
+            if (s[n] == ' ') last = n;
+            w = GrStringWidth(s, n + 1, opt);
+            if (w > maxw && last > 0) { n = last; break; }
+        }
+        GrDrawString(s, n, x, y, opt);
+        y += opt->txo_font->h.height;
+        s += n;
+        if (*s) s++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static char xaligns[3] = { GR_ALIGN_LEFT, GR_ALIGN_CENTER, GR_ALIGN_RIGHT };
+    GrTextOption opt;
+    GrTextRun *run[3];
+    GrFont *f;
+    GrEvent ev;
+    char s[121];
+    long t1, t2;
+    int i, colw, x;
+
+    if (argc >= 2) fontname = argv[1];
+    if (argc >= 5) {
+        gwidth = atoi(argv[2]);
+        gheight = atoi(argv[3]);
+        gbpp = atoi(argv[4]);
+    }
+
+    f = loadfont(fontname);
+    if (f == NULL) {
+        fprintf(stderr, "can't load font %s\n", fontname);
+        return 1;
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    opt.txo_font = f;
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_bgcolor = GrNOCOLOR;
+    opt.txo_chrtype = GR_BYTE_TEXT;
+    opt.txo_direct = GR_TEXT_RIGHT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+
+    colw = GrSizeX() / 3 - 20;
+    for (i = 0; i < 3; i++) {
+        opt.txo_xalign = xaligns[i];
+        run[i] = GrCreateTextRun(text, 0, &opt, colw, kern,
+                                 sizeof(kern) / sizeof(kern[0]));
+        if (run[i] == NULL) return 1;
+        x = 10 + i * (colw + 20);
+        GrBox(x - 2, 8, x + colw + 1, 12 + run[i]->height, GrAllocColor(0, 0, 255));
+        if (i == 1) x += colw / 2;
+        if (i == 2) x += colw - 1;
+        GrDrawTextRun(run[i], x, 10);
+    }
+
+    t1 = GrMsecTime();
+    for (i = 0; i < NREPS; i++)
+        drawwrapped(text, 10, GrSizeY() / 2, colw, &opt);
+    t1 = GrMsecTime() - t1;
+    t2 = GrMsecTime();
+    for (i = 0; i < NREPS; i++)
+        GrDrawTextRun(run[0], colw + 30, GrSizeY() / 2);
+    t2 = GrMsecTime() - t2;
+
+    sprintf(s, "%d paragraphs: measured %ld ms, text run %ld ms", NREPS, t1, t2);
+    GrTextXY(10, GrMaxY() - 20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    for (i = 0; i < 3; i++) GrDestroyTextRun(run[i]);
+    GrUnloadFont(f);
+    return 0;
+}
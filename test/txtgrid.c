@@ -0,0 +1,118 @@
+/**
+ ** txtgrid.c ---- test text drawing speed with a grid of strings
+ **
+ ** Copyright (c) 2026 Mariano Alvarez Fernandez
+ ** [e-mail: malfer@telefonica.net]
+ **
+ ** This is a test/demo file of the GRX graphics library.
+ ** You can use GRX test/demo files as you want.
+ **
+ ** The GRX graphics library is free software; you can redistribute it
+ ** and/or modify it under some conditions; see the "copying.grx" file
+ ** for details.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "mgrx.h"
+#include "mgrxkeys.h"
+
+#define NCOLS 8
+#define NREPS 20
+
+static int gwidth = 640;
+static int gheight = 480;
+static int gbpp = 16;
+
+/* UTF-8 cells, they are recoded to the font encoding */
+static char *cells[NCOLS] = {
+    "Año", "Größe", "Ñandú", "Café",
+    "1234.56", "-78.90", "¿Qué?", "Zürich"
+};
+
+static GrTextItem *items = NULL;
+static int nitems = 0;
+
+static void grid(GrTextOption *opt, int bulk, int bgtransp)
+{
+    GrTextOption o = *opt;
+    long t1, t2;
+    char s[121];
+    GrEvent ev;
+    int i, r;
+
+    o.txo_bgcolor = bgtransp ? GrNOCOLOR : GrAllocColor(0, 0, 96);
+    GrClearScreen(GrBlack());
+    t1 = GrMsecTime();
+    for (r=0; r<NREPS; r++) {
+        if (bulk)
+            GrDrawStrings(items, nitems, &o);
+        else
+            for (i=0; i<nitems; i++)
+                GrDrawString((void *)items[i].text, items[i].length,
+                             items[i].x, items[i].y, &o);
+    }
+    t2 = GrMsecTime();
+    sprintf(s, "%s, %s background: %d strings x %d in %ld ms",
+            bulk ? "GrDrawStrings" : "GrDrawString",
+            bgtransp ? "transparent" : "opaque", nitems, NREPS, t2-t1);
+    GrTextXY(10, GrMaxY()-20, s, GrWhite(), GrBlack());
+    GrEventWaitKeyOrClick(&ev);
+}
+
+int main(int argc, char **argv)
+{
+    GrTextOption opt;
+    int ncols, nrows, cw, ch, x, y;
+
+    if (argc >= 4) {
+        gwidth = atoi(argv[1]);
+        gheight = atoi(argv[2]);
+        gbpp = atoi(argv[3]);
+    }
+
+    GrSetMode(GR_width_height_bpp_graphics, gwidth, gheight, gbpp);
+    GrEventInit();
+    GrMouseDisplayCursor();
+
+    opt.txo_font = &GrFont_PC8x14;
+    opt.txo_fgcolor = GrWhite();
+    opt.txo_bgcolor = GrNOCOLOR;
+    opt.txo_chrtype = GR_UTF8_TEXT;
+    opt.txo_direct = GR_TEXT_RIGHT;
+    opt.txo_xalign = GR_ALIGN_LEFT;
+    opt.txo_yalign = GR_ALIGN_TOP;
+
+    cw = 8 * 9;
+    ch = 16;
+    ncols = GrSizeX() / cw;
+    nrows = (GrSizeY() - 30) / ch;
+    items = malloc(sizeof(GrTextItem) * ncols * nrows);
+    if (items == NULL) goto salida;
+    for (y=0; y<nrows; y++) {
+        for (x=0; x<ncols; x++) {
+            items[nitems].text = cells[(x + y) % NCOLS];
+            items[nitems].length = 0;
+            items[nitems].x = x * cw + 4;
+            items[nitems].y = y * ch;
+            items[nitems].opt = NULL;
+            nitems++;
+        }
+    }
+
+    grid(&opt, 0, 0);
+    grid(&opt, 1, 0);
+    grid(&opt, 0, 1);
+    grid(&opt, 1, 1);
+
+    free(items);
+
+salida:
+    GrEventUnInit();
+    GrSetMode(GR_default_text);
+    return 0;
+}